@@ -0,0 +1,161 @@
+// $Id: U3Selection.h,v 1.1 $
+
+// Core of the V0 selection of UserEvent103, w/o any PHAST dependency: input
+// is plain numbers and per-track arrays.
+// - LH-ratio ID decisions for all tracks at once (bit pattern per track).
+// - Indices of fulfillment of the V0 vertex cuts.
+// - K0 PID pattern (cf. "CSResonanceData::K0Pat").
+// Shared by "userevents/UserEvent103" and "CSEvent/replay": the two copies
+// are to be kept identical (as is the case for "CSEventData.h").
+
+#ifndef U3Selection_h
+#define U3Selection_h 1
+
+//   ***** LH-RATIO ID DECISIONS *****
+// Bit pattern per track, holding all the comparisons of LH ratios to one
+// another and to the LH cuts, so that the selections need only combine bits
+// w/ their momentum windows (thresholds, "PRICHCut"), which remain the
+// caller's business. Only set for tracks w/ PIDs&0x10.
+static const int LHpiID   =   0x1; // piLH >LHCut*(K,p)LH and >LHBckCut
+static const int LHKID    =   0x2; // KLH  >LHCut*(pi,p)LH and >LHBckCut
+static const int LHpID    =   0x4; // pLH  >LHCut*(pi,K)LH and >LHBckCut
+static const int LHpIDe   =   0x8; // LHpID and pLH>LHCut*eLH
+static const int LHpip    =  0x10; // piLH >LHCut*pLH
+static const int LHpiMx   =  0x20; // piLH>=(K,p)LH
+static const int LHpiBck  =  0x40; // piLH>=LHBckCut
+static const int LHe0     =  0x80; // eLH ==0
+static const int LHeLT    = 0x100; // eLH <piLHeVeto*piLH
+static const int LHeGT    = 0x200; // eLH >piLHeVeto*piLH
+static const int LHsubKpi = 0x400; // piLH<subKThrLHpiVeto
+static const int LHsubKK  = 0x800; // KLH <subKThrLHpiVeto
+static const int LHsubKh  =0x1000; // (e,pi,p)LH<subKThrLHpiVeto
+static const int LHsubKe  =0x2000; // eLH <subKThrLHeVeto (if "subKThre")
+static const int LHsubppi =0x4000; // piLH<subpThrLHpiVeto
+static const int LHsubpe  =0x8000; // eLH <subpThrLHVeto
+static const int LHsubpK =0x10000; // KLH <subpThrLHVeto
+static const int LHsubpie=0x20000; // eLH <subpiThrLHeVeto
+
+struct U3LHCuts {
+  double LHCut, LHBckCut;
+  double piLHeVeto;
+  double subKThrLHpiVeto, subKThrLHeVeto;
+  int    subKThre;         // !=0: evaluate LHsubKe (REJECT_SubKThr_e)
+  double subpThrLHpiVeto, subpThrLHVeto;
+  double subpiThrLHeVeto;
+};
+
+// "LHs" = pi,K,p,e LH arrays. Branch-free, so that the loop be vectorised.
+// LHs of tracks w/o PIDs&0x10 may be left over from earlier events (or =0):
+// the result is masked out.
+inline void U3LHIDs(int nTrks, const int *PIDs, const double *const *LHs,
+		    const U3LHCuts &c, int *LHIDs)
+{
+  const double *piLHs = LHs[0], *KLHs = LHs[1], *pLHs = LHs[2], *eLHs = LHs[3];
+  const double LHCut = c.LHCut, LHBckCut = c.LHBckCut, piLHeVeto = c.piLHeVeto;
+  const double subKThrLHpiVeto = c.subKThrLHpiVeto;
+  const double subKThrLHeVeto = c.subKThrLHeVeto;
+  const double subpThrLHpiVeto = c.subpThrLHpiVeto;
+  const double subpThrLHVeto = c.subpThrLHVeto;
+  const double subpiThrLHeVeto = c.subpiThrLHeVeto;
+  const int subKe = -(c.subKThre!=0)&LHsubKe;
+  for (int iET = 0; iET<nTrks; iET++) {
+    double piLH = piLHs[iET], KLH = KLHs[iET], pLH = pLHs[iET], eLH = eLHs[iET];
+    int bckOK = (PIDs[iET]>>4)&0x1;
+    int lh = 0, pOK =
+      (pLH>LHCut*piLH)&(pLH>LHCut*KLH)&(pLH>LHBckCut);
+    lh |= -((piLH>LHCut*KLH)&(piLH>LHCut*pLH)&(piLH>LHBckCut))&LHpiID;
+    lh |= -((KLH>LHCut*piLH)&(KLH>LHCut*pLH)&(KLH>LHBckCut))  &LHKID;
+    lh |= -pOK                                                &LHpID;
+    lh |= -(pOK&(pLH>LHCut*eLH))                              &LHpIDe;
+    lh |= -(piLH>LHCut*pLH)                                   &LHpip;
+    lh |= -((piLH>=KLH)&(piLH>=pLH))                          &LHpiMx;
+    lh |= -(piLH>=LHBckCut)                                   &LHpiBck;
+    lh |= -(eLH==0)                                           &LHe0;
+    lh |= -(eLH<piLHeVeto*piLH)                               &LHeLT;
+    lh |= -(eLH>piLHeVeto*piLH)                               &LHeGT;
+    lh |= -(piLH<subKThrLHpiVeto)                             &LHsubKpi;
+    lh |= -(KLH<subKThrLHpiVeto)                              &LHsubKK;
+    lh |= -((eLH<subKThrLHpiVeto)&(piLH<subKThrLHpiVeto)&(pLH<subKThrLHpiVeto))
+      /* */                                                   &LHsubKh;
+    lh |= -(eLH<subKThrLHeVeto)                               &subKe;
+    lh |= -(piLH<subpThrLHpiVeto)                             &LHsubppi;
+    lh |= -(eLH<subpThrLHVeto)                                &LHsubpe;
+    lh |= -(KLH<subpThrLHVeto)                                &LHsubpK;
+    lh |= -(eLH<subpiThrLHeVeto)                              &LHsubpie;
+    LHIDs[iET] = lh&-bckOK;
+  }
+}
+
+//   ***** V0 SELECTION: INDICES of FULFILLMENT *****
+// "DsdD" = D/dD of the vertex line, "chi2" per NDF. Cuts are arrays of
+// increasing strictness: [3] for D/dD and collinearity, [2] for pT.
+inline void U3V0Indices(const double *V0DsdD, const double *V0cthCut,
+			const double *V0pTCut,
+			double DsdD, double ctheta, double pT, double chi2,
+			int &s_dist, int &s_ctheta, int &s_pT, int &s_chi2)
+{
+  s_dist = s_ctheta = s_pT = s_chi2 = 0;
+  if      (ctheta>V0cthCut[2])   s_ctheta = 3;
+  else if (ctheta>V0cthCut[1])   s_ctheta = 2;
+  else if (ctheta>V0cthCut[0])   s_ctheta = 1;
+  if      (pT>V0pTCut[1])        s_pT = 2;
+  else if (pT>V0pTCut[0])        s_pT = 1;
+  if      (chi2<10) s_chi2 = 2; // Exceedingly loose, since chi2 is per NDF
+  else if (chi2<15) s_chi2 = 1;
+  if      (DsdD>V0DsdD[2]) s_dist = 3;
+  else if (DsdD>V0DsdD[1]) s_dist = 2;
+  else if (DsdD>V0DsdD[0]) s_dist = 1;
+}
+
+//   ***** K0 PID *****
+// Evaluate PID of the two decay pions, [0] = h1 (>0) and [1] = h2 (<0), given
+// RICH acceptance flag "aR" (cf. "RICHPlane"), P @ RICH, PIDs and LHIDs.
+// Returns the PID part of "K0Pat":
+//  0x10<<pm: w/in RICH acceptance and piThr<P<PRICHCut
+//  0x40<<pm: piID, w/in above momentum window
+// 0x200<<pm: eVeto
+// and sets "id" (cf. "hm_K0VsID"), per pm = 0,1 in bits 3*pm:
+//  0x1: piThr<P<Pmax, 0x2: !e+e-, 0x4: actual piID
+inline unsigned short U3K0PID(const int *aR, const double *mom,
+			      const int *PIDs, const int *LHIDs,
+			      double piThr, double PRICHCut, unsigned short &id)
+{
+  unsigned short pat = 0; id = 0;
+  for (int pm = 0; pm<2; pm++) {
+    if (aR[pm]<=0) continue;
+    bool winRange = piThr<mom[pm] && mom[pm]<PRICHCut;
+    if (winRange) {
+      pat |= 0x10<<pm; id |= 0x1<<(pm*3);
+    }
+    if (PIDs[pm]&0x10) {
+      int lh = LHIDs[pm];
+      if ((lh&LHe0) || // eLH=piLH=0: eVeto even above piThr!
+	  !(lh&LHeGT)) {
+	// eVeto: don't require piThr<P<Pmax. It's:
+	// - Unnecessary: "piLHeVeto" is expected to be large => P>Pmax,
+	//  where eLH=piLH, is anyway rejected,
+	// - Harmful: P<piThr can be efficiently vetoed.
+	// (Note that piID (i.e. id&0x4) here does not place any condition
+	// on pi/eLH, which let well ID'd e+/e- pass through. One could
+	// consider a cut on pi/eLH in the region below asymptotic pions,
+	// to correct for this. But we want here to arbitrate the purity
+	// vs. efficiency trade-off in favour of pion, efficiency, since
+	// pion yield is large compared to e+e- and reasonable purity is
+	// kind of automatically granted. Anyway, a consequence is that an
+	// OR of pionID (id&0x4) and eVeto yields more than eVeto alone.)
+	id |= 0x2<<(pm*3); pat |= 0x200<<pm;
+      }
+      if (winRange && (lh&LHpiID)) {
+	id |= 0x4<<(pm*3); pat |= 0x40<<pm;
+      }
+    }
+    else {
+      // Absence of RICH block or LH =0: eVeto, even above piThr, cf. comment
+      // in Lambda PID
+      id |= 0x2<<(pm*3); pat |= 0x200<<pm;
+    }
+  }
+  return pat;
+}
+
+#endif
@@ -88,12 +88,18 @@ const double M_phi  = 1.019456;
 /**********************************************************************/
 void usage() {
   printf(" * fit_table: RICH Table with pi,K,p via fit of Lambda,K0,phi\n");
-  printf("Usage: fit_table [-f <optFile>] [-v] <mode>\n");
+  printf("Usage: fit_table [-f <optFile>] [-i] [-s <first>-<last>] [-j <n>] [-v] <mode> [<shards>]\n");
   printf("  <mode> = plots: Create the histograms for fitting.\n");
+  printf("  <mode> = merge: Sum the outputs of \"plots\" shards <shards> = <first>-<last> ...\n");
   printf("  <mode> = fit  : Do the fit and produce the table.\n");
   printf("  <mode> = test : Read options file and exit\n");
   printf("  -f: <optFile> specified on command line.\n");
   printf("  -h: Print this message and exit.\n");
+  printf("  -i: Incremental \"plots\": only process input files that are not in the\n");
+  printf("      manifest of a previous \"plots\", adding to its outputs.\n");
+  printf("  -j: #threads for \"merge\" (default: #cores).\n");
+  printf("  -s: Shard \"plots\": only process input files <first> to <last>, and\n");
+  printf("      write partial outputs \"<hist_file>.<first>-<last>.root\".\n");
   printf("  -v: Verbose.\n");
   printf("Default options file = \"./options_fit.dat\"\n");
   exit(1);
@@ -101,20 +107,41 @@ void usage() {
 int main(int argc, char *argv[]){
 
   //   ********** PARSE COMMAND LINE
-  verbose = 0; string optFile("options_fit.dat"); bool badCommandLine = false;
+  verbose = 0; incremental = false; nThreads = 0;
+  string optFile("options_fit.dat"); bool badCommandLine = false;
+  int shardFirst = 0, shardLast = 0;
   int iarg = 1; while (iarg<argc && argv[iarg][0]=='-') {
     if      (string(argv[iarg])=="-f") {
       if (++iarg<argc) optFile = string(argv[iarg]);
       else badCommandLine = true;
     }
     else if (string(argv[iarg])=="-h") usage();
+    else if (string(argv[iarg])=="-i") incremental = true;
+    else if (string(argv[iarg])=="-j") {
+      if (++iarg>=argc || sscanf(argv[iarg],"%d",&nThreads)!=1 || nThreads<1)
+	badCommandLine = true;
+    }
+    else if (string(argv[iarg])=="-s") {
+      if (++iarg<argc && parseShard(argv[iarg],shardFirst,shardLast))
+	shard = string(argv[iarg]);
+      else badCommandLine = true;
+    }
     else if (string(argv[iarg])=="-v") verbose = 1;
     iarg++;
   }
-  if (!badCommandLine) badCommandLine = argc!=1+iarg || argv[iarg][0]=='-';
-  string mode; if (!badCommandLine) {
+  if (!badCommandLine) badCommandLine = argc<1+iarg || argv[iarg][0]=='-';
+  string mode; vector<string> shards; if (!badCommandLine) {
     mode = string(argv[iarg]);
-    badCommandLine = mode!="fit" && mode!="plots" && mode!="test";
+    badCommandLine = mode!="fit" && mode!="plots" && mode!="merge" && mode!="test";
+    if (mode=="merge") {   // Remaining args: shards
+      for (int i = iarg+1; i<argc; i++) {
+	int first, last; if (!parseShard(argv[i],first,last)) badCommandLine = true;
+	shards.push_back(string(argv[i]));
+      }
+      if (shards.empty()) badCommandLine = true;
+    }
+    else if (argc!=1+iarg) badCommandLine = true;
+    if (!shard.empty() && mode!="plots") badCommandLine = true;
   }
   if (badCommandLine) {
     cerr << "** fit_table: Ill formed command line: \"" << argv[0];
@@ -124,6 +151,10 @@ int main(int argc, char *argv[]){
   }
 
   if (!read_options(optFile)) return 1;    // ***** READ OPTIONS
+  if (!shard.empty()) {                    // ***** SHARD: OVERRIDE FILE RANGE
+    data_ff_nb = shardFirst; data_lf_nb = shardLast;
+    data_nb = data_lf_nb-data_ff_nb+1;
+  }
 
   if (verbose)
     RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
@@ -136,14 +167,59 @@ int main(int argc, char *argv[]){
     ev = new CSEventData;
     hadrons = new vector<CSHadronData>;
     resonances = new vector<CSResonanceData>;
-    for(int i=0; i<data_nb; i++) {
-      if(get_inputFile(i+data_ff_nb)) {
+    // Input files: all, or, if incremental, those not yet in the manifest
+    vector<ManifestEntry> manifest, todo;
+    bool append = plan_plots(manifest,todo);
+    if (append) {
+      if (todo.empty()) {
+	printf(" * fit_table: No new input file => Outputs left unchanged\n");
+	return 0;
+      }
+      if (!add_hist()) return 1;  // Start from existing outputs
+    }
+    for(int i=0; i<(int)todo.size(); i++) {
+      ManifestEntry &m = todo[i];
+      if(get_inputFile(m.run)) {
+	TTree *tree = (TTree*)input->Get("CSEvtTree");
+	m.entries = tree ? tree->GetEntries() : 0;
 	if(analysis=="K0L") get_input_data_t1(); // t1: K0 Lambda
 	if(analysis=="phi") get_input_data_t2(); // t2: phi, both incl. and excl.
 	input->Close();
+	manifest.push_back(m);
       }
     }
+    // Outputs are RECREATEd in place: void manifest 1st, lest a crash leave it
+    // describing former outputs. (Then next "plots -i" is a full processing.)
+    if (!remove_manifest(manifestName(shard))) return 1;
     write_hist();
+    if (!write_manifest(manifestName(shard),manifest)) return 1;
+    return 0;
+  }
+  else if (mode=="merge") {             // ***** merge
+    // Overlapping shards would be summed twice: reject them upfront
+    if (!check_shards(shards)) return 1;
+    // Merged manifest, if all shards have one, so that "plots -i" can follow.
+    // Files in several shard manifests: reject, before any merging.
+    vector<ManifestEntry> manifest; set<int> runs; bool ok = true;
+    for (int i = 0; i<(int)shards.size(); i++) {
+      vector<ManifestEntry> m;
+      if (!read_manifest(manifestName(shards[i]),m)) { ok = false; continue; }
+      for (int k = 0; k<(int)m.size(); k++) {
+	if (!runs.insert(m[k].run).second) {
+	  printf("** fit_table: File #%d in several shards => No merge\n",
+		 m[k].run);
+	  return 1;
+	}
+	manifest.push_back(m[k]);
+      }
+    }
+    create_hist();
+    if (!merge_hist(shards)) return 1;
+    // Outputs are overwritten: the manifest of the former ones is now void
+    if (!remove_manifest(manifestName(""))) return 1;
+    write_hist();
+    if (ok) { if (!write_manifest(manifestName(""),manifest)) return 1; }
+    else printf(" * fit_table: No merged manifest written\n");
     return 0;
   }
   else if (mode=="fit") {               // ***** fit
@@ -171,9 +247,13 @@ int main(int argc, char *argv[]){
 }
 
 /**********************************************************************/
+string inputFileName(int pi)
+{
+  return string(Form("%s/%s-%d.root",data_file.c_str(),data_template.c_str(),pi));
+}
 bool get_inputFile(int pi)
 {
-  string fileString = Form("%s/%s-%d.root",data_file.c_str(),data_template.c_str(),pi);
+  string fileString = inputFileName(pi);
   const char *fileName = fileString.c_str();
   input = TFile::Open(fileName);
   if(input) {
@@ -271,6 +351,7 @@ bool read_options(string optFile) {
       if (var1 == "hist_file_ephi:")	hist_file_ephi = var2;
       if (var1 == "hist_file_Lam:")	hist_file_Lam = var2;
       if (var1 == "out_file:")		out_file = var2;
+      if (var1 == "manifest_file:")	manifest_file = var2;
       if (var1 == "line_width:")		stringstream ( var2 ) >> lw;
       if (var1 == "remove_richpipe:"){if(var2=="true") rpipe = true; else rpipe = false;}
       if (var1 == "max_retry:")		stringstream ( var2 ) >> retry;
@@ -402,9 +483,12 @@ void write_hist(){
 
   }
 
-  if(analysis=="K0L") {
-    TFile* output = new TFile(hist_file_K0.c_str(),"RECREATE");
-    for(int i = 0; i<2; i++) { // K0 +/-
+  PlotsFile pfs[2]; int nPfs = getPlotsFiles(pfs,shard);
+  TNamed signature("plots_signature",cuts_signature().c_str());
+  for (int f = 0; f<nPfs; f++) {
+    TFile* output = new TFile(pfs[f].name.c_str(),"RECREATE");
+    signature.Write();
+    for(int i = pfs[f].i0; i<pfs[f].i0+2; i++) { // +/-
       for(int j = 0; j<5; j++) { // a pi k p u
 	for(int p = 0; p<Np;p++){
 	  for(int t = 0; t<Nt; t++){
@@ -414,56 +498,323 @@ void write_hist(){
 	}
       }
     }
-    writeKineHistos("K0");
+    writeKineHistos(pfs[f].kine);
     output->Close();
     delete output;
-
-    output = new TFile(hist_file_Lam.c_str(),"RECREATE");
-    for(int i = 4; i<6; i++) { // Lamda +/-
-      for(int j = 0; j<5; j++) { // a pi k p u
-	for(int p = 0; p<Np;p++){
-	  for(int t = 0; t<Nt; t++){
-	    ((TH1D*)h[i][j][p][t])->Write();
-	    ((TH2D*)h2[i][j][p][t])->Write();
-	  }
-	}
+  }
+}
+int getPlotsFiles(PlotsFile *pfs, const string &tag)
+{
+  // Output files of "plots", w/ the pair of channels (cf. "chan[]") and the
+  // kinematics histos they hold. Returns their #. "tag": cf. "shardName".
+  if (analysis=="K0L") {
+    pfs[0].name = shardName(hist_file_K0,tag);   pfs[0].i0 = 0; pfs[0].kine = "K0";
+    pfs[1].name = shardName(hist_file_Lam,tag);  pfs[1].i0 = 4; pfs[1].kine = "Lambda";
+    return 2;
+  }
+  if (analysis=="phi") {
+    pfs[0].name = shardName(hist_file_iphi,tag); pfs[0].i0 = 2; pfs[0].kine = "Iphi";
+    pfs[1].name = shardName(hist_file_ephi,tag); pfs[1].i0 = 6; pfs[1].kine = "Ephi";
+    return 2;
+  }
+  return 0;
+}
+string shardName(const string &name, const string &tag)
+{
+  // Name of shard "tag" of file "name": "<name>.root" -> "<name>.<tag>.root",
+  // else "<name>.<tag>". Empty tag, i.e. unsharded: "name".
+  if (tag.empty()) return name;
+  size_t n = name.size();
+  if (n>5 && name.compare(n-5,5,".root")==0)
+    return name.substr(0,n-5)+"."+tag+".root";
+  return name+"."+tag;
+}
+bool parseShard(const char *tag, int &first, int &last)
+{
+  // "<first>-<last>"
+  char c; return sscanf(tag,"%d-%d%c",&first,&last,&c)==2 && first<=last;
+}
+bool check_shards(const vector<string> &tags)
+{
+  // Shards "<first>-<last>" must be disjoint.
+  vector<int> firsts, lasts;
+  for (int s = 0; s<(int)tags.size(); s++) {
+    int first, last; parseShard(tags[s].c_str(),first,last);
+    for (int r = 0; r<s; r++) {
+      if (first<=lasts[r] && firsts[r]<=last) {
+	printf("** fit_table: Shards \"%s\" and \"%s\" overlap => No merge\n",
+	       tags[r].c_str(),tags[s].c_str());
+	return false;
       }
     }
-    writeKineHistos("Lambda");
-    output->Close();
+    firsts.push_back(first); lasts.push_back(last);
   }
-  if(analysis=="phi") {
-    TFile* output = new TFile(hist_file_iphi.c_str(),"RECREATE");
-    for(int i = 2; i<4; i++) { // Incl. phi +/-
-      for(int j = 0; j<5; j++) { // a pi k p u
-	for(int p = 0; p<Np;p++){
-	  for(int t = 0; t<Nt; t++){
-	    ((TH1D*)h[i][j][p][t])->Write();
-	    ((TH2D*)h2[i][j][p][t])->Write();
-	  }
-	}
+  return true;
+}
+bool sameBinning(const TH1 *a, const TH1 *b)
+{
+  // Same # of bins and limits in X and, for TH2, in Y. (Checked explicitly:
+  // "TH1::Add" does not fail on different axes, it may merge or extend them.)
+  if (a->GetDimension()!=b->GetDimension()) return false;
+  for (int d = 0; d<a->GetDimension() && d<2; d++) {
+    const TAxis *aa = d ? a->GetYaxis() : a->GetXaxis();
+    const TAxis *ab = d ? b->GetYaxis() : b->GetXaxis();
+    if (aa->GetNbins()!=ab->GetNbins() ||
+	aa->GetXmin()!=ab->GetXmin() || aa->GetXmax()!=ab->GetXmax())
+      return false;
+  }
+  return true;
+}
+string manifestName(const string &tag)
+{
+  // Option "manifest_file:", else alongside the 1st output of "plots"
+  if (!manifest_file.empty()) return shardName(manifest_file,tag);
+  PlotsFile pfs[2];
+  return getPlotsFiles(pfs,tag) ? pfs[0].name+".manifest" : string();
+}
+bool add_hist()
+{
+  // Add the contents of the existing outputs of "plots" to the booked histos.
+  PlotsFile pfs[2]; int nPfs = getPlotsFiles(pfs,shard);
+  for (int f = 0; f<nPfs; f++) {
+    const char *fileName = pfs[f].name.c_str();
+    TFile *in = TFile::Open(fileName);
+    if (!in || in->IsZombie()) {
+      printf("** add_hist: Cannot open \"%s\"\n",fileName);
+      return false;
+    }
+    // Shared histos: only added from the 1st output, lest they be doubled
+    vector<TH1*> hs; getPlotsHistos(pfs[f],hs,f==0);
+    for (int k = 0; k<(int)hs.size(); k++) {
+      TH1 *hf = (TH1*)in->Get(hs[k]->GetName());
+      if (!hf || !sameBinning(hs[k],hf) || !hs[k]->Add(hf)) {
+	printf("** add_hist: \"%s\": %s histo \"%s\"\n",fileName,
+	       hf ? "Incompatible" : "No",hs[k]->GetName());
+	in->Close(); return false;
       }
     }
-    writeKineHistos("Iphi");
-    output->Close();
-    delete output;
-
-    output = new TFile(hist_file_ephi.c_str(),"RECREATE");
-    for(int i = 6; i<8; i++) { // Excl. phi +/-
-      for(int j = 0; j<5; j++) { // a pi k p u
-	for(int p = 0; p<Np;p++){
-	  for(int t = 0; t<Nt; t++){
-	    ((TH1D*)h[i][j][p][t])->Write();
-	    ((TH2D*)h2[i][j][p][t])->Write();
-	  }
+    in->Close(); delete in;
+    if (verbose) printf("<= \"%s\": %d histos added\n",fileName,(int)hs.size());
+  }
+  return true;
+}
+void getPlotsHistos(const PlotsFile &pf, vector<TH1*> &hs, bool shared)
+{
+  // All the (booked) histos that go into output file "pf" ("shared": cf.
+  // "getKineHistos")
+  for(int i = pf.i0; i<pf.i0+2; i++)
+    for(int j = 0; j<5; j++) for(int p = 0; p<Np;p++) for(int t = 0; t<Nt; t++) {
+	  hs.push_back(h[i][j][p][t]); hs.push_back(h2[i][j][p][t]);
 	}
+  getKineHistos(pf.kine,hs,shared);
+}
+/**********************************************************************/
+static void merge_worker(const vector<string> *files, const vector<TH1*> *hs,
+			 int iT, int nT, int *ok)
+{
+  // Histos iT, iT+nT, ... of all "files", read one file at a time, one histo
+  // at a time, each w/ its own TFile. Histos being split among threads, no
+  // two threads ever touch the same booked histo.
+  int nHs = hs->size();
+  for (int s = 0; s<(int)files->size() && *ok; s++) {
+    const char *fileName = (*files)[s].c_str();
+    TFile *in = TFile::Open(fileName);
+    if (!in || in->IsZombie()) {
+      printf("** merge_hist: Cannot open \"%s\"\n",fileName);
+      *ok = 0; break;
+    }
+    for (int k = iT; k<nHs; k += nT) {
+      TH1 *hb = (*hs)[k], *hf = (TH1*)in->Get(hb->GetName());
+      if (!hf || !sameBinning(hb,hf) || !hb->Add(hf)) {
+	printf("** merge_hist: \"%s\": %s histo \"%s\"\n",fileName,
+	       hf ? "Incompatible" : "No",hb->GetName());
+	*ok = 0; break;
+      }
+      delete hf;
+    }
+    in->Close(); delete in;
+  }
+}
+bool merge_hist(const vector<string> &tags)
+{
+  // Sum the outputs of "plots" shards "tags" into the booked histos.
+  // - All shards must have the signature of current options and cuts.
+  // - Binning is checked histo per histo, cf. "sameBinning".
+  // - Histos are split among "nThreads" threads.
+  string sig = cuts_signature();
+  if (nThreads<=0) nThreads = thread::hardware_concurrency();
+  if (nThreads<=0) nThreads = 1;
+  ROOT::EnableThreadSafety();
+  PlotsFile pfs[2]; int nPfs = getPlotsFiles(pfs,"");
+  for (int f = 0; f<nPfs; f++) {
+    vector<string> files; int s;
+    for (s = 0; s<(int)tags.size(); s++) {
+      files.push_back(shardName(pfs[f].name,tags[s]));
+      const char *fileName = files.back().c_str();
+      TFile *in = TFile::Open(fileName);
+      if (!in || in->IsZombie()) {
+	printf("** merge_hist: Cannot open \"%s\"\n",fileName);
+	return false;
+      }
+      TNamed *n = (TNamed*)in->Get("plots_signature");
+      bool sigOK = n && sig==n->GetTitle();
+      in->Close(); delete in;
+      if (!sigOK) {
+	printf("** merge_hist: \"%s\": %s signature of options and cuts\n",
+	       fileName,n ? "Different" : "No");
+	return false;
       }
     }
-    writeKineHistos("Ephi");
-    output->Close();
+    // Shared histos: only merged from the 1st output, lest they be doubled
+    vector<TH1*> hs; getPlotsHistos(pfs[f],hs,f==0);
+    int nT = nThreads<(int)hs.size() ? nThreads : (int)hs.size();
+    vector<int> oks(nT,1); vector<thread> workers;
+    for (int iT = 0; iT<nT; iT++)
+      workers.push_back(thread(merge_worker,&files,&hs,iT,nT,&oks[iT]));
+    for (int iT = 0; iT<nT; iT++) workers[iT].join();
+    for (int iT = 0; iT<nT; iT++) if (!oks[iT]) return false;
+    printf(" * merge_hist: \"%s\" <= %d shards, %d histos, %d threads\n",
+	   pfs[f].name.c_str(),(int)files.size(),(int)hs.size(),nT);
   }
-
+  return true;
 }
+/**********************************************************************/
+string cuts_signature()
+{
+  // All that the contents of the outputs of "plots" depend upon, but for the
+  // list of input files. Outputs can only be added if signatures are equal.
+  stringstream sig; sig << setprecision(10);
+  sig << analysis << " " << data_file << "/" << data_template
+      << " CSEventData" << CSEVENTDATA
+      << " thr_diff " << thr_diff << " remove_richpipe " << rpipe;
+  sig << " lh_cut";
+  for (int i = 0; i<5; i++) for (int j = 0; j<6; j++) sig << " " << lh_cut[i][j];
+  sig << " DdD " << DdD_cuts[0] << " " << DdD_cuts[1];
+  sig << " cth " << cth_cuts[0] << " " << cth_cuts[1];
+  sig << " pT";  for (int i = 0; i<4; i++) sig << " " << pT_cuts[i];
+  sig << " dE "  << dE_cuts[0] << " " << dE_cuts[1];
+  sig << " P";   for (int p = 0; p<=Np; p++) sig << " " << p_bins[p];
+  sig << " T";   for (int t = 0; t<=Nt; t++) sig << " " << t_bins[t];
+  return sig.str();
+}
+bool read_manifest(const string &fileName, vector<ManifestEntry> &manifest)
+{
+  // Returns false if there is no usable manifest: none, ill-formed or w/ a
+  // signature different from current one.
+  manifest.clear();
+  ifstream in(fileName.c_str());
+  if (!in) {
+    printf(" * fit_table: No manifest \"%s\"\n",fileName.c_str());
+    return false;
+  }
+  string line, sig; while (getline(in,line)) {
+    if (line.empty() || line[0]=='#') continue;
+    if (line.compare(0,10,"signature ")==0) { sig = line.substr(10); continue; }
+    ManifestEntry m;
+    if (sscanf(line.c_str(),"%d %lld %ld %lld",
+	       &m.run,&m.size,&m.mtime,&m.entries)!=4) {
+      printf("** fit_table: Manifest \"%s\": Ill-formed line \"%s\"\n",
+	     fileName.c_str(),line.c_str());
+      manifest.clear(); return false;
+    }
+    manifest.push_back(m);
+  }
+  if (sig!=cuts_signature()) {
+    printf(" * fit_table: Manifest \"%s\": Different options or cuts\n",
+	   fileName.c_str());
+    manifest.clear(); return false;
+  }
+  return true;
+}
+bool write_manifest(const string &fileName,
+		    const vector<ManifestEntry> &manifest)
+{
+  if (fileName.empty()) return true;
+  // Write to a temporary, then rename: never leave a truncated manifest.
+  string tmp = fileName+".tmp";
+  FILE *out = fopen(tmp.c_str(),"w");
+  if (!out) {
+    printf("** fit_table: Cannot write manifest \"%s\"\n",tmp.c_str());
+    return false;
+  }
+  fprintf(out,"# fit_table plots manifest: <run> <size> <mtime> <entries>\n");
+  fprintf(out,"signature %s\n",cuts_signature().c_str());
+  for (int i = 0; i<(int)manifest.size(); i++) {
+    const ManifestEntry &m = manifest[i];
+    fprintf(out,"%d %lld %ld %lld\n",m.run,m.size,m.mtime,m.entries);
+  }
+  if (fclose(out) || rename(tmp.c_str(),fileName.c_str())) {
+    printf("** fit_table: Cannot write manifest \"%s\"\n",fileName.c_str());
+    return false;
+  }
+  return true;
+}
+bool remove_manifest(const string &fileName)
+{
+  // Invalidate manifest, before its outputs get overwritten, so that no
+  // failure in between can leave it describing outputs it does not match.
+  if (fileName.empty() || gSystem->AccessPathName(fileName.c_str()))
+    return true;                 // No manifest (AccessPathName: true if none)
+  if (remove(fileName.c_str())) {
+    printf("** fit_table: Cannot remove manifest \"%s\"\n",fileName.c_str());
+    return false;
+  }
+  return true;
+}
+bool plan_plots(vector<ManifestEntry> &manifest, vector<ManifestEntry> &todo)
+{
+  // Select the input files "plots" has to process, in [data_firstfile_nb,
+  // data_lastfile_nb]. Returns true if outputs are to be added to, i.e.
+  // incremental mode w/ a valid manifest, none of whose files has changed or
+  // been removed (the contribution of which could not be subtracted). Then
+  // "manifest" retains the files already processed and "todo" the new ones.
+  // Else all files are to be processed.
+  todo.clear();
+  vector<ManifestEntry> present; // Candidate input files
+  for (int pi = data_ff_nb; pi<=data_lf_nb; pi++) {
+    ManifestEntry m; FileStat_t st; m.run = pi; m.entries = 0;
+    string fileName = inputFileName(pi);
+    if (!gSystem->GetPathInfo(fileName.c_str(),st)) {
+      m.size = st.fSize; m.mtime = st.fMtime;
+    }
+    else if (fileName.find("://")!=string::npos) {
+      m.size = -1; m.mtime = 0;  // Remote file: only tracked by its number
+    }
+    else continue;               // No such local file
+    present.push_back(m);
+  }
+  bool append = incremental && read_manifest(manifestName(shard),manifest);
+  if (append) {
+    map<int,int> iPresent;
+    for (int i = 0; i<(int)present.size(); i++) iPresent[present[i].run] = i;
+    vector<bool> done(present.size(),false);
+    for (int k = 0; k<(int)manifest.size() && append; k++) {
+      const ManifestEntry &d = manifest[k];
+      map<int,int>::const_iterator it = iPresent.find(d.run);
+      if (it==iPresent.end()) {
+	printf(" * fit_table: Processed file #%d no longer in input\n",d.run);
+	append = false;
+      }
+      else if (present[it->second].size!=d.size ||
+	       present[it->second].mtime!=d.mtime) {
+	printf(" * fit_table: Processed file #%d has changed\n",d.run);
+	append = false;
+      }
+      else done[it->second] = true;
+    }
+    for (int i = 0; i<(int)present.size() && append; i++)
+      if (!done[i]) todo.push_back(present[i]);
+    if (append)
+      printf(" * fit_table: Incremental: %d file(s) already processed, %d new\n",
+	     (int)manifest.size(),(int)todo.size());
+  }
+  if (!append) {
+    if (incremental) printf(" * fit_table: => Full processing\n");
+    manifest.clear(); todo = present;
+  }
+  return append;
+}
+
 /**********************************************************************/
 int getPID(double PR,     // Momentum @ RICH
 	   double *p_lh,  // Array of LikeliHoods
@@ -682,24 +1033,17 @@ void get_input_data_t1(){
       else if (LambdaPat)       Lambda =  1;
       else                      Lambda =  0;
       // ***** MASSES: CONVERT M_RESONANCE -> M_REFLEXION
-      double Pp = sqrt(hp.Px*hp.Px+hp.Py*hp.Py+hp.Pz*hp.Pz);
-      double Pm = sqrt(hm.Px*hm.Px+hm.Py*hm.Py+hm.Pz*hm.Pz);
-      double P2m = Pm*Pm, P2p = Pp*Pp, m2 = res.m*res.m;
-      static double mpipi, mppi, mpip;
-      double Epipi =  sqrt(P2p+M2_pi )+sqrt(P2m+M2_pi );
-      if      (Lambda==1) {
-	double Eppi = sqrt(P2p+M2_p )+sqrt(P2m+M2_pi);
-	mpipi = sqrt(m2+Epipi*Epipi-Eppi*Eppi);
-      }
-      else if (Lambda==-1) {
-	double Epip = sqrt(P2p+M2_pi)+sqrt(P2m+M2_p );
-	mpipi = sqrt(m2+Epipi*Epipi-Epip*Epip);
-      }
+      // (Converting the stored "res.m", rather than recomputing it from the
+      // hadrons' momenta, which may have been stored for another vertex.)
+      const V0Kine v0k(hp.Px,hp.Py,hp.Pz,hm.Px,hm.Py,hm.Pz);
+      double mpipi = 0, mppi = 0, mpip = 0;
+      if      (Lambda==1)
+	mpipi = v0k.reflect(res.m,V0Kine::ppi,V0Kine::pipi);
+      else if (Lambda==-1)
+	mpipi = v0k.reflect(res.m,V0Kine::pip,V0Kine::pipi);
       else {
-	double Eppi = sqrt(P2p+M2_p )+sqrt(P2m+M2_pi);
-	double Epip = sqrt(P2p+M2_pi)+sqrt(P2m+M2_p );
-	mpip =  sqrt(m2-Epipi*Epipi+Epip*Epip);
-	mppi =  sqrt(m2-Epipi*Epipi+Eppi*Eppi);
+	mpip =  v0k.reflect(res.m,V0Kine::pipi,V0Kine::pip);
+	mppi =  v0k.reflect(res.m,V0Kine::pipi,V0Kine::ppi);
       }
       bool fillHisto;
       if (Lambda) {
@@ -1334,8 +1678,8 @@ void fit_table_K0(int cc){
       RooRealVar frac_s("frac_s","frac_s",0.65,0.5,0.7) ; //
       RooAddPdf sig("sig","sig",RooArgList(gauss1,gauss2),frac_s) ;
 
-      RooFormulaVar N_a_s("N_a_s","N_pi_s + N_k_s + N_p_s + N_u_s",RooArgSet(N_pi_s,N_k_s,N_p_s,N_u_s));
-      RooFormulaVar N_a_b("N_a_b","N_pi_b + N_k_b + N_p_b + N_u_b",RooArgSet(N_pi_b,N_k_b,N_p_b,N_u_b));
+      RooAddition N_a_s("N_a_s","N_pi_s + N_k_s + N_p_s + N_u_s",RooArgList(N_pi_s,N_k_s,N_p_s,N_u_s));
+      RooAddition N_a_b("N_a_b","N_pi_b + N_k_b + N_p_b + N_u_b",RooArgList(N_pi_b,N_k_b,N_p_b,N_u_b));
 
       RooAddPdf model_all("model_all","model_all",RooArgList(sig,bgna),RooArgList(N_a_s,N_a_b)) ;
       RooAddPdf model_pi("model_pi","model_pi",RooArgList(sig,bgna),RooArgList(N_pi_s,N_pi_b)) ; // checked with bgnpi
@@ -1615,8 +1959,8 @@ void fit_table_phi(int cc){
       ent = h[2+cc][4][p][t]->GetEntries(); //[p][t]
       RooRealVar N_u_s("N_u_s","N_u_s",0.77*ent,0.,1.05*ent) ;
       RooRealVar N_u_b("N_u_b","N_u_b",0.23*ent,0.,1.05*ent) ;
-      RooFormulaVar N_a_s("N_a_s","N_pi_s + N_k_s + N_p_s + N_u_s",RooArgSet(N_pi_s,N_k_s,N_p_s,N_u_s));
-      RooFormulaVar N_a_b("N_a_b","N_pi_b + N_k_b + N_p_b + N_u_b",RooArgSet(N_pi_b,N_k_b,N_p_b,N_u_b));
+      RooAddition N_a_s("N_a_s","N_pi_s + N_k_s + N_p_s + N_u_s",RooArgList(N_pi_s,N_k_s,N_p_s,N_u_s));
+      RooAddition N_a_b("N_a_b","N_pi_b + N_k_b + N_p_b + N_u_b",RooArgList(N_pi_b,N_k_b,N_p_b,N_u_b));
 
 
       //bedingung nur für t = 2
@@ -2016,8 +2360,8 @@ void fit_table_Lambda(int cc){
       RooRealVar N_u_s("N_u_s","N_u_s",0.77*ent,0.,1.05*ent) ;
       RooRealVar N_u_b("N_u_b","N_u_b",0.11*ent,0.,1.05*ent) ;
 
-      RooFormulaVar N_a_s("N_a_s","N_pi_s + N_k_s + N_p_s + N_u_s",RooArgSet(N_pi_s,N_k_s,N_p_s,N_u_s));
-      RooFormulaVar N_a_b("N_a_b","N_pi_b + N_k_b + N_p_b + N_u_b",RooArgSet(N_pi_b,N_k_b,N_p_b,N_u_b));
+      RooAddition N_a_s("N_a_s","N_pi_s + N_k_s + N_p_s + N_u_s",RooArgList(N_pi_s,N_k_s,N_p_s,N_u_s));
+      RooAddition N_a_b("N_a_b","N_pi_b + N_k_b + N_p_b + N_u_b",RooArgList(N_pi_b,N_k_b,N_p_b,N_u_b));
 
       if(t == 1 && p == Np-2) {
 	N_k_s.setVal(0);
@@ -2988,34 +3332,40 @@ void bookKineHistos()
     Rt_Ephi = new TH1D("Rt_Ephi",title.c_str(),32,-.5,31.5);
   }
 }
-void writeKineHistos(const char *particleName)
+void getKineHistos(const char *particleName, vector<TH1*> &hs, bool shared)
 {
+  // Append to "hs" the kinematics histos that go w/ "particleName".
+  // "shared": include the "*_all" histos, which are common to K0 and Lambda,
+  // i.e. written to both outputs. (When reading back, they must be taken
+  // from only one of the two.)
+  if (shared &&
+      (!strncmp(particleName,"K0",2) || !strncmp(particleName,"Lambda",6))) {
+    TH1 *l[] = { am_all, Z_all, XY_all };
+    hs.insert(hs.end(),l,l+sizeof(l)/sizeof(TH1*));
+  }
   if      (!strncmp(particleName,"K0",2)) {
-    am_all->Write(); Z_all->Write();  XY_all->Write();
-    am_K0->Write();  Z_K0->Write();   XY_K0->Write();
-    am_K0p->Write(); am_K0m->Write();
-    DdD_K0->Write(); cth_K0->Write(); pT_K0->Write();
-    Tr_K0->Write();  Rb_K0->Write();  Rt_K0->Write();
+    TH1 *l[] = { am_K0, Z_K0, XY_K0, am_K0p, am_K0m,
+		 DdD_K0, cth_K0, pT_K0, Tr_K0, Rb_K0, Rt_K0 };
+    hs.insert(hs.end(),l,l+sizeof(l)/sizeof(TH1*));
   }
   else if (!strncmp(particleName,"Lambda",6)) {
-    am_all->Write(); Z_all->Write();  XY_all->Write();
-    am_L->Write();   Z_L->Write();    XY_L->Write();
-    DdD_L->Write();  cth_L->Write();  pT_L->Write();
-    Tr_L->Write();   Rb_L->Write();   Rt_L->Write();
+    TH1 *l[] = { am_L, Z_L, XY_L,
+		 DdD_L, cth_L, pT_L, Tr_L, Rb_L, Rt_L };
+    hs.insert(hs.end(),l,l+sizeof(l)/sizeof(TH1*));
   }
   else if (!strncmp(particleName,"Iphi",6)) {
-    pT_Incl->Write(); dE_Incl->Write();
-    am_Incl->Write();
-    pT_Iphi->Write(); dE_Iphi->Write();
-    am_Iphi->Write(); Z_Iphi->Write(); XY_Iphi->Write();
-    Tr_Iphi->Write(); Rb_Iphi->Write(); Rt_Iphi->Write();
+    TH1 *l[] = { pT_Incl, dE_Incl, am_Incl, pT_Iphi, dE_Iphi,
+		 am_Iphi, Z_Iphi, XY_Iphi, Tr_Iphi, Rb_Iphi, Rt_Iphi };
+    hs.insert(hs.end(),l,l+sizeof(l)/sizeof(TH1*));
   }
   else if (!strncmp(particleName,"Ephi",6)) {
-    pT_Excl->Write(); dE_Excl->Write();
-    am_Excl->Write();
-    pT_Ephi->Write(); dE_Ephi->Write();
-    am_Ephi->Write(); Z_Ephi->Write(); XY_Ephi->Write();
-    Tr_Ephi->Write(); Rb_Ephi->Write(); Rt_Ephi->Write();
+    TH1 *l[] = { pT_Excl, dE_Excl, am_Excl, pT_Ephi, dE_Ephi,
+		 am_Ephi, Z_Ephi, XY_Ephi, Tr_Ephi, Rb_Ephi, Rt_Ephi };
+    hs.insert(hs.end(),l,l+sizeof(l)/sizeof(TH1*));
   }
-
+}
+void writeKineHistos(const char *particleName)
+{
+  vector<TH1*> hs; getKineHistos(particleName,hs);
+  for (int k = 0; k<(int)hs.size(); k++) hs[k]->Write();
 }
@@ -2,8 +2,10 @@
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #include <cmath>
@@ -23,6 +25,7 @@
 #include <TMatrixD.h>
 #include <TPaveText.h>
 #include <TStyle.h>
+#include <TSystem.h>
 #include <TTree.h>
 #include <TPDF.h>
 
@@ -132,6 +135,10 @@ string hist_file_Lam =  "hist_Lambda.root";
 string hist_file_iphi = "hist.iphi.root";
 string hist_file_ephi = "hist.ephi.root";
 string out_file = "rich.root";
+string manifest_file;   // Manifest of files processed by "plots". D = <1st hist file>.manifest
+bool incremental;       // "plots -i": only process new files, add to existing outputs
+string shard;           // "plots -s <first>-<last>": tag of partial outputs
+int nThreads;           // "merge -j <n>"
 int id_lst[5]; double lh_cut[5][6]; // LikeliHood cuts
 TH1D* h[8][5][Np][Nt];
 TH2D* h2[8][5][Np][Nt];
@@ -171,13 +178,23 @@ int  verbose;
 
 // CSEvenData TTree
 #include "CSEventData.h"
+#include "V0Kine.h"
 CSEventData *ev;
 vector<CSHadronData> *hadrons;
 vector<CSResonanceData> *resonances;
 
+// ***** "plots" OUTPUT FILES: file name, 1st of its 2 channels, kine histos
+struct PlotsFile { string name; int i0; const char *kine; };
+// ***** MANIFEST of "plots" INPUT FILES
+struct ManifestEntry {
+  int run;          // File number, as in "<data_template>-<run>.root"
+  Long64_t size; Long_t mtime; Long64_t entries;
+};
+
 // ******************************************************************************************
 
 int main(int, char**);
+string inputFileName(int pi);
 bool get_inputFile(int pi);
 bool read_options(string optFile);
 void get_input_data_t1();
@@ -185,6 +202,24 @@ void get_input_data_t2();
 void get_input_data2();
 void bookKineHistos();
 void writeKineHistos(const char *particleName);
+void getKineHistos(const char *particleName, vector<TH1*> &hs,
+		   bool shared = true);
+int  getPlotsFiles(PlotsFile *pfs, const string &tag);
+void getPlotsHistos(const PlotsFile &pf, vector<TH1*> &hs,
+		    bool shared = true);
+string shardName(const string &name, const string &tag);
+bool parseShard(const char *tag, int &first, int &last);
+bool check_shards(const vector<string> &tags);
+bool sameBinning(const TH1 *a, const TH1 *b);
+string manifestName(const string &tag);
+bool add_hist();
+bool merge_hist(const vector<string> &tags);
+string cuts_signature();
+bool read_manifest(const string &fileName, vector<ManifestEntry> &manifest);
+bool write_manifest(const string &fileName,
+		    const vector<ManifestEntry> &manifest);
+bool remove_manifest(const string &fileName);
+bool plan_plots(vector<ManifestEntry> &manifest, vector<ManifestEntry> &todo);
 
 RooDataHist* gen_K0(int, int , int, int);
 void write_hist();
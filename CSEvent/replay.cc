@@ -0,0 +1,374 @@
+// $Id: replay.cc,v 1.1 $
+
+// ******************************************************************************************
+//
+// Replay, w/o PHAST, of the V0 selection core of UserEvent103, for profiling
+// and regression testing hot-path changes.
+//
+// ******************************************************************************************
+
+// OUTLINE
+// - Events are read from an "EventSource", the narrow interface between the
+//  selection and its input. Two implementations:
+//   - "TreeSource": "CSEvtTree" content, as output by UserEvent103.
+//   - "SynthSource": synthetic generator (pi/K/p/e hadrons, random pairings).
+// - The selection is that of "U3Selection.h", shared w/ UserEvent103, and
+//  "V0Kine.h". It's split into stages, each of which is timed:
+//   - "source":   reading/generating the event,
+//   - "LHIDs":    LH-ratio ID decisions for all hadrons ("getLHIDs"),
+//   - "V0Kine":   V0 kinematics, all mass hypotheses,
+//   - "select":   V0 cut indices and K0 selection + PID ("K0Pat"),
+//   - "output*":  copy of selected V0s and their hadrons into an output TTree,
+//   - "RICHperf*": filling of pi ID vs. P histos from clean K0s.
+//  (*) Synthetic stand-ins: they are NOT UserEvent103's "copyCSHadronData",
+//  "copyCSResonanceData" and "fillK0_RICHPerf", which need PaEvent (vertices,
+//  helices, RICH transport). They only mimic their memory and fill pattern:
+//  a plain copy into a TTree of the same layout, and one TH2 fill per
+//  examined pion. Their timings are therefore only indicative.
+//   W/o "-o", the output TTree is reset every "nKeep" entries, so as to keep
+//  memory bounded.
+// - Events/s are reported per stage.
+// - What cannot be replayed, since not recorded in "CSEvtTree":
+//   - Vertex line, vertex chi2: taken from recorded "D,dD,cth,chi2".
+//   - RICH acceptance: approximated by "hasR", P @ RICH by "qP".
+//   - The "Zs>ZTarget" part of 0x100 of "K0Pat".
+//   - The correction of LHs for the error on the RICH index (cf. "GetPIDs"):
+//    LH/bckLH ratios are computed from the recorded, uncorrected, LHs.
+//  => When replaying "CSEvtTree", bits 0xf of "K0Pat", which only depend on
+//   recorded info, are compared to the recorded ones. Mismatches are expected,
+//   beyond float rounding @ the edges of the cuts: the hadron momenta stored
+//   in "CSHadronData" are those @ pV, whereas UserEvent103 selects on the
+//   momenta @ the V0 vertex. Hence the V0 mass and pT differ. The mismatch
+//   count is a regression check (it must not change w/ a hot-path change),
+//   not a validation of the replay.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <TFile.h>
+#include <TChain.h>
+#include <TTree.h>
+#include <TH2.h>
+#include <TRandom3.h>
+
+#include "CSEventData.h"
+#include "V0Kine.h"
+#include "U3Selection.h"
+
+using namespace std;
+
+// Same values as in "Masses.h"
+static const double M_K0 = 0.497672;
+
+// Cuts: default ones of UserEvent103
+static const double V0DsdD[3] = {1,2,5}, V0cthCut[3] = {.9998, .9999, .99995 };
+static const double V0pTCut[2] = {.010,.020 };
+static const double dM_K0 = 0.075, K0MassCut = 2*.0076;
+static const double PRICHCut = 60;
+
+// ********** EVENT SOURCE **********
+struct ReplayEvent {
+  CSEventData *ev;
+  vector<CSHadronData> *hadrons;
+  vector<CSResonanceData> *resonances;
+};
+class EventSource {
+public:
+  virtual ~EventSource() {}
+  //! Fill next event, return false when exhausted
+  virtual bool Next(ReplayEvent &e) = 0;
+  virtual bool Recorded() const = 0;   // Whether resonance patterns are genuine
+};
+
+class TreeSource: public EventSource {
+public:
+  TreeSource(const vector<string> &files, Long64_t nMax): chain("CSEvtTree"),
+    ev(new CSEventData), hadrons(new vector<CSHadronData>),
+    resonances(new vector<CSResonanceData>), entry(0) {
+    for (int i = 0; i<(int)files.size(); i++) chain.Add(files[i].c_str());
+    chain.SetBranchAddress("CSEvt",&ev);
+    chain.SetBranchAddress("Hs",&hadrons);
+    chain.SetBranchAddress("Rs",&resonances);
+    nEntries = chain.GetEntries(); if (nMax>0 && nMax<nEntries) nEntries = nMax;
+  }
+  bool Next(ReplayEvent &e) {
+    if (entry>=nEntries) return false;
+    chain.GetEntry(entry++);
+    e.ev = ev; e.hadrons = hadrons; e.resonances = resonances;
+    return true;
+  }
+  bool Recorded() const { return true; }
+private:
+  TChain chain;
+  CSEventData *ev;
+  vector<CSHadronData> *hadrons;
+  vector<CSResonanceData> *resonances;
+  Long64_t entry, nEntries;
+};
+
+class SynthSource: public EventSource {
+  // Hadrons: pi (70%), K, p, e, w/ LH of the true species enhanced. V0s: all
+  // (+,-) pairs, half of them given the D/dD, collinearity and chi2 of a
+  // genuine V0, the rest those of combinatorics.
+public:
+  SynthSource(Long64_t nMax, unsigned int seed): rndm(seed), nEvents(nMax),
+    iEvent(0) {}
+  bool Next(ReplayEvent &e) {
+    if (iEvent>=nEvents) return false;
+    ev.Reset(); ev.runNo = 1; ev.evtNo = iEvent++; ev.piThr = 2.6;
+    hadrons.clear(); resonances.clear();
+    int nH = 2+rndm.Poisson(6), h, k;
+    for (h = 0; h<nH; h++) {
+      CSHadronData hd;
+      double P = 1+rndm.Exp(10), thx = rndm.Gaus(0,.05), thy = rndm.Gaus(0,.05);
+      double norm = P/sqrt(1+thx*thx+thy*thy);
+      hd.Px = norm*thx; hd.Py = norm*thy; hd.Pz = norm;
+      int q = rndm.Rndm()<.5 ? 1 : -1; hd.qP = q*P;
+      hd.XX0 = 10*rndm.Rndm(); hd.chi2 = rndm.Exp(1.5);
+      hd.hasR = rndm.Rndm()<.8;
+      if (hd.hasR) {
+	double r = rndm.Rndm();
+	int species = r<.70 ? 0 : r<.85 ? 1 : r<.95 ? 2 : 3;
+	for (k = 0; k<6; k++) {
+	  double LH = 1+rndm.Gaus(0,.1); if (k==species) LH += .3+rndm.Exp(.3);
+	  hd.LH[k] = LH<1e-6 ? 0 : LH;
+	}
+	hd.XR = rndm.Gaus(0,50); hd.YR = rndm.Gaus(0,50);
+	hd.tgXR = thx; hd.tgYR = thy;
+      }
+      hadrons.push_back(hd);
+    }
+    for (h = 0; h<nH; h++) for (k = 0; k<nH; k++) {
+	if (hadrons[h].qP<0 || hadrons[k].qP>0) continue;
+	CSResonanceData r; r.h1 = h; r.h2 = k;
+	bool V0 = rndm.Rndm()<.5;
+	r.D = 5+rndm.Exp(50); r.dD = r.D/(V0 ? rndm.Exp(10) : rndm.Exp(1));
+	r.cth = V0 ? 1-rndm.Exp(.00005) : 1-rndm.Exp(.001);
+	r.chi2 = V0 ? rndm.Exp(2) : rndm.Exp(8);
+	r.Zs = rndm.Uniform(-100,300);
+	resonances.push_back(r);
+      }
+    e.ev = &ev; e.hadrons = &hadrons; e.resonances = &resonances;
+    return true;
+  }
+  bool Recorded() const { return false; }
+private:
+  TRandom3 rndm;
+  Long64_t nEvents, iEvent;
+  CSEventData ev;
+  vector<CSHadronData> hadrons;
+  vector<CSResonanceData> resonances;
+};
+
+// ********** STAGES **********
+enum { sSource, sLHIDs, sV0Kine, sSelect, sOutput, sRICHperf, nStages };
+static const char *stageNames[nStages] =
+  { "source", "LHIDs", "V0Kine", "select", "output*", "RICHperf*" };
+static double stageTimes[nStages];
+typedef chrono::steady_clock Clock;
+
+void usage()
+{
+  printf("replay [-h] [-n <nEvents>] [-s <seed>] [-o <outFile>] [<CSEvtTree files>]\n");
+  printf("  Replay the V0 selection of UserEvent103, w/o PHAST, and report events/s per stage.\n");
+  printf("  W/o input files, events are generated.\n");
+  printf("  -n: Max. #events (default: all input, or 100000 generated).\n");
+  printf("  -s: Seed of the generator (default: 4357).\n");
+  printf("  -o: Write output TTree and histos to <outFile> (else TTree is reset\n");
+  printf("      every 10000 entries).\n");
+  printf("  -h: Print this message and exit.\n");
+  exit(1);
+}
+int main(int argc, char *argv[]){
+
+  //   ********** PARSE COMMAND LINE
+  Long64_t nMax = 0; unsigned int seed = 4357; string outFile;
+  vector<string> inFiles;
+  for (int iarg = 1; iarg<argc; iarg++) {
+    string arg(argv[iarg]);
+    if      (arg=="-h") usage();
+    else if (arg=="-n" && iarg+1<argc) nMax = atoll(argv[++iarg]);
+    else if (arg=="-s" && iarg+1<argc) seed = atoi(argv[++iarg]);
+    else if (arg=="-o" && iarg+1<argc) outFile = argv[++iarg];
+    else if (arg[0]=='-') {
+      fprintf(stderr,"** replay: Ill formed command line at \"%s\"\n\n",argv[iarg]);
+      usage();
+    }
+    else inFiles.push_back(arg);
+  }
+  EventSource *source;
+  if (inFiles.empty()) source = new SynthSource(nMax>0 ? nMax : 100000,seed);
+  else                 source = new TreeSource(inFiles,nMax);
+
+  // ********** SELECTION SETTINGS: defaults of UserEvent103
+  U3LHCuts lhCuts;
+  lhCuts.LHCut = 1.01; lhCuts.LHBckCut = 1.20; lhCuts.piLHeVeto = 1.5;
+  lhCuts.subKThrLHpiVeto = 0.92; lhCuts.subKThrLHeVeto = 0.92;
+  lhCuts.subKThre = 1;
+  lhCuts.subpThrLHpiVeto = 1.40; lhCuts.subpThrLHVeto = 1.50;
+  lhCuts.subpiThrLHeVeto = 1.5;
+
+  // ********** OUTPUT
+  TFile *out = 0; if (!outFile.empty()) {
+    out = TFile::Open(outFile.c_str(),"RECREATE");
+    if (!out || out->IsZombie()) {
+      fprintf(stderr,"** replay: Cannot open output \"%s\"\n",outFile.c_str());
+      return 1;
+    }
+  }
+  CSEventData *fCSEvt = new CSEventData;
+  vector<CSHadronData> *fHadrons = new vector<CSHadronData>;
+  vector<CSResonanceData> *fResonances = new vector<CSResonanceData>;
+  TTree *fCSEvtTree = new TTree("CSEvtTree","Replayed V0s");
+  fCSEvtTree->Branch("CSEvt",&fCSEvt);
+  fCSEvtTree->Branch("Hs",&fHadrons);
+  fCSEvtTree->Branch("Rs",&fResonances);
+  if (!out) fCSEvtTree->SetDirectory(0);
+  const Long64_t nKeep = 10000; // W/o output file: reset TTree every nKeep fills
+  TH2D *hR_piK0[2];  // pi ID vs. P, per charge: 0: piID, 1: KID, 2: pID, 3: none
+  hR_piK0[0] = new TH2D("hR_piK0p","#pi+ from K0: ID vs. P",60,0,60,4,-.5,3.5);
+  hR_piK0[1] = new TH2D("hR_piK0m","#pi- from K0: ID vs. P",60,0,60,4,-.5,3.5);
+
+  // ********** PER EVENT SCRATCH: grown, never shrunk
+  vector<int> PIDs, LHIDs, fHInds;
+  vector<double> LHs[4];
+  vector<V0Kine> v0ks; vector<unsigned short> K0Pats;
+
+  Long64_t nEvents = 0, nHadrons = 0, nV0s = 0, nK0s = 0, nMismatches = 0;
+  for (int s = 0; s<nStages; s++) stageTimes[s] = 0;
+  ReplayEvent e; Clock::time_point t0 = Clock::now(), t1;
+#define U3_STAGE(s) t1 = Clock::now(); \
+  stageTimes[s] += chrono::duration<double>(t1-t0).count(); t0 = t1
+  while (source->Next(e)) {
+    U3_STAGE(sSource);
+    nEvents++;
+    const vector<CSHadronData> &hs = *e.hadrons;
+    const vector<CSResonanceData> &rs = *e.resonances;
+    int nHs = hs.size(), nRs = rs.size(), h, iR, pm;
+    nHadrons += nHs; nV0s += nRs;
+
+    //                                                     ***** LH-RATIO IDs
+    if ((int)PIDs.size()<nHs) {
+      PIDs.resize(nHs); LHIDs.resize(nHs); fHInds.resize(nHs);
+      for (int i = 0; i<4; i++) LHs[i].resize(nHs);
+    }
+    for (h = 0; h<nHs; h++) {
+      // As in "GetPIDs": LHs relative to background LH, 0x10 if the latter
+      // is available.
+      const CSHadronData &hd = hs[h]; double bckLH = hd.LH[5];
+      PIDs[h] = hd.hasR ? 0x8 : 0;
+      if (bckLH>0) {
+	PIDs[h] |= 0x10;
+	for (int i = 0; i<4; i++) LHs[i][h] = hd.LH[i]/bckLH;
+      }
+      else for (int i = 0; i<4; i++) LHs[i][h] = 0;
+    }
+    const double *lhs[4] = { LHs[0].data(), LHs[1].data(),
+			     LHs[2].data(), LHs[3].data() };
+    U3LHIDs(nHs,PIDs.data(),lhs,lhCuts,LHIDs.data());
+    U3_STAGE(sLHIDs);
+
+    //                                                     ***** V0 KINEMATICS
+    if ((int)v0ks.size()<nRs) { v0ks.resize(nRs); K0Pats.resize(nRs); }
+    for (iR = 0; iR<nRs; iR++) {
+      const CSHadronData &h1 = hs[rs[iR].h1], &h2 = hs[rs[iR].h2];
+      v0ks[iR].set(h1.Px,h1.Py,h1.Pz,h2.Px,h2.Py,h2.Pz);
+    }
+    U3_STAGE(sV0Kine);
+
+    //                                                     ***** K0 SELECTION
+    double piThr = e.ev->piThr;
+    for (iR = 0; iR<nRs; iR++) {
+      const CSResonanceData &r = rs[iR]; const V0Kine &v0k = v0ks[iR];
+      double m_pipi = v0k.m[V0Kine::pipi];
+      int s_dist, s_ctheta, s_pT, s_chi2;
+      U3V0Indices(V0DsdD,V0cthCut,V0pTCut,r.D/r.dD,r.cth,v0k.pT,r.chi2,
+		  s_dist,s_ctheta,s_pT,s_chi2);
+      unsigned short K0Pat = 0;
+      if (s_pT>=1 && s_chi2>=2 && fabs(m_pipi-M_K0)<dM_K0 &&
+	  s_dist>=1 && s_ctheta>=1) {
+	K0Pat = 0x4|0x8;
+	const int h12[2] = { r.h1, r.h2 };
+	int aRs[2], pids[2], lhIDs[2]; double moms[2];
+	for (pm = 0; pm<2; pm++) {
+	  const CSHadronData &hd = hs[h12[pm]];
+	  aRs[pm] = hd.hasR ? 1 : -1; moms[pm] = fabs(hd.qP);
+	  pids[pm] = PIDs[h12[pm]]; lhIDs[pm] = LHIDs[h12[pm]];
+	}
+	unsigned short id;
+	K0Pat |= U3K0PID(aRs,moms,pids,lhIDs,piThr,PRICHCut,id);
+	if (s_dist>=2 && s_ctheta>=2) K0Pat |= 0x1|0x2;
+	nK0s++;
+      }
+      K0Pats[iR] = K0Pat;
+      if (source->Recorded() && (K0Pat&0xf)!=(r.K0Pat&0xf)) nMismatches++;
+    }
+    U3_STAGE(sSelect);
+
+    //                                                     ***** OUTPUT TTree
+    *fCSEvt = *e.ev; fHadrons->clear(); fResonances->clear();
+    for (h = 0; h<nHs; h++) fHInds[h] = -1;
+    for (iR = 0; iR<nRs; iR++) {
+      if (!K0Pats[iR]) continue;
+      fResonances->push_back(rs[iR]);
+      CSResonanceData &r = fResonances->back(); const V0Kine &v0k = v0ks[iR];
+      r.K0Pat = K0Pats[iR]; r.m = v0k.m[V0Kine::pipi];
+      r.pT = v0k.pT; r.alpha = v0k.alpha;
+      const int h12[2] = { rs[iR].h1, rs[iR].h2 };
+      for (pm = 0; pm<2; pm++) {
+	int fHInd = fHInds[h12[pm]];
+	if (fHInd<0) {
+	  fHInd = fHInds[h12[pm]] = fHadrons->size();
+	  fHadrons->push_back(hs[h12[pm]]);
+	}
+	if (pm==0) r.h1 = fHInd;
+	else       r.h2 = fHInd;
+      }
+    }
+    if (!fResonances->empty()) {
+      fCSEvtTree->Fill();
+      if (!out && fCSEvtTree->GetEntries()>=nKeep) fCSEvtTree->Reset();
+    }
+    U3_STAGE(sOutput);
+
+    //                                             ***** RICH PERFS from K0s
+    // Strict V0 selection, K0 mass cut, ID of the counterpart: pi or eVeto.
+    for (iR = 0; iR<nRs; iR++) {
+      unsigned short K0Pat = K0Pats[iR];
+      if ((K0Pat&0xf)!=0xf ||
+	  fabs(v0ks[iR].m[V0Kine::pipi]-M_K0)>=K0MassCut) continue;
+      const int h12[2] = { rs[iR].h1, rs[iR].h2 };
+      for (pm = 0; pm<2; pm++) {
+	if (!(K0Pat&0x10<<pm)) continue;                // Examined: w/in window
+	if (!(K0Pat&(0x40|0x200)<<(1-pm))) continue;    // Counterpart ID'd
+	int lh = LHIDs[h12[pm]];
+	int id = lh&LHpiID ? 0 : lh&LHKID ? 1 : lh&LHpID ? 2 : 3;
+	hR_piK0[pm]->Fill(fabs(hs[h12[pm]].qP),id);
+      }
+    }
+    U3_STAGE(sRICHperf);
+  }
+
+  // ********** REPORT
+  double total = 0; for (int s = 0; s<nStages; s++) total += stageTimes[s];
+  printf(" * replay: %lld events (%s), %lld hadrons, %lld V0s, %lld K0 candidates\n",
+	 nEvents,source->Recorded()?"CSEvtTree":"generated",
+	 nHadrons,nV0s,nK0s);
+  if (source->Recorded())
+    printf(" * replay: %lld K0Pat&0xf mismatches w.r.t. recorded\n",nMismatches);
+  printf("   %-9s %10s %14s\n","stage","time[s]","events/s");
+  for (int s = 0; s<nStages; s++)
+    printf("   %-9s %10.3f %14.0f\n",stageNames[s],stageTimes[s],
+	   stageTimes[s]>0 ? nEvents/stageTimes[s] : 0.);
+  printf("   %-9s %10.3f %14.0f\n","total",total,total>0 ? nEvents/total : 0.);
+  printf("   (*) Synthetic stand-ins for the copyCS* and RICH perf fills\n");
+
+  if (out) { out->Write(); out->Close(); }
+  delete source;
+  return 0;
+}
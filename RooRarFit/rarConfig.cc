@@ -29,9 +29,12 @@
 #include "TTree.h"
 #include "TSystem.h"
 #include "TMatrixDSym.h"
+#include "TRandom.h"
 
 #include "Roo1DTable.h"
 #include "RooAbsCategory.h"
+#include "RooAbsCategoryLValue.h"
+#include "RooAbsRealLValue.h"
 #include "RooArgList.h"
 #include "RooCategory.h"
 #include "RooConstVar.h"
@@ -84,6 +87,8 @@
 #include "rarThreshold.hh"
 
 #include "rarConfig.hh"
+#include "rarConfigStore.hh"
+#include "rarFormulaCompiler.hh"
 
 ClassImp(rarConfig)
   ;
@@ -240,7 +245,9 @@ TString rarConfig::getFileName(const TString in_name) const
 /// \return The string it reads in
 ///
 /// A utility function to read in a config item as a string.
-/// It actually uses RooFit's
+/// It looks the item up in the parse-once index of the config file,
+/// #rarConfigStore, and only for files the index can not handle
+/// it uses RooFit's
 /// <a href="http://roofit.sourceforge.net/docs/classref/RooArgSet.html#RooArgSet:readFromFile" target=_blank>RooArgSet::readFromFile</a>
 /// function.
 TString rarConfig::readConfStr(const char *name, const char *val,
@@ -253,7 +260,13 @@ TString rarConfig::readConfStr(const char *name, const char *val,
   // first check if it has been read in
   RooStringVar *theStr=(RooStringVar*)(_configStrSet.find(secVarName));
   if (theStr) return theStr->getVal();
-  // not read in yet, try to get it from config file
+  // not read in yet, try to get it from the config index
+  if (rarConfigStore::isIndexed(_configFile)) {
+    TString retVal=val;
+    rarConfigStore::find(_configFile, configSec, name, retVal);
+    return retVal;
+  }
+  // or from config file directly
   RooArgSet strList("Read Config String List");
   RooStringVar strVar(name, "config string", val, 40960);
   strList.add(strVar);
@@ -1046,7 +1059,8 @@ RooAbsArg *rarConfig::createAbsVar(const char *varStr, const char *option)
     if (varStrParser.nArgs()) val=varStrParser[0];
     theVar=new RooStringVar(myName, fullTitle, val);
   } else if ("RooFormulaVar"==varType) { // dealing with RooFormulaVar
-    theVar=new RooFormulaVar(myName, myTitle, *getFormulaArgs(varStrParser));
+    theVar=rarFormulaCompiler::createFormulaVar(myName, myTitle, myTitle,
+                                                *getFormulaArgs(varStrParser));
     if (_createFundamental) {
       theFVar=(RooRealVar*) theVar->createFundamental();
       // check if we specify range
@@ -1386,24 +1400,11 @@ RooDataSet *rarConfig::createDataSet(const char *dsStr, Bool_t &isUB, TString wg
       if ((nEvt<=0) || (nEvt>srcNevt)) nEvt=srcNevt;
       if ((nEvt>0)&&(nEvt<srcNevt)) isUB=kTRUE;
       cout<<" Adding "<<nEvt<<" events from "<<theData->GetName()<<endl;
-      // create index vector
+      // random (w/o replacement) indices, so the sample added
+      // is not sequence dependent to the src data
       vector<Int_t> indexVector;
-      for (Int_t j=0; j<srcNevt; j++) {
-	indexVector.push_back(j);
-      }
-      for (Int_t j=0; j<nEvt; j++) {
-	// random access to index to make sure the sample added
-	// is not sequence dependent to the src data
-	Int_t randomIdx=
-	  RooRandom::randomGenerator()->Integer(indexVector.size());
-	RooArgSet *theRow=(RooArgSet *)theData->get(indexVector[randomIdx]);
-	data->add(*theRow);
-	// remove the index so it won't be selected again
-	vector<Int_t>::iterator the_iterator;
-	the_iterator=indexVector.begin();
-	the_iterator+=randomIdx;
-	indexVector.erase(the_iterator);
-      }
+      sampleIndices(srcNevt, nEvt, kFALSE, indexVector);
+      copyRows(theData, indexVector, data);
     }
     addColumns(data);
     cout<<"RooDataSet::add: added "<<data->numEntries()<<" events"<<endl;
@@ -1550,6 +1551,86 @@ void rarConfig::computeCorrelations(RooArgList varList,
   */
 }
 
+/// \brief Draw random event indices from a source sample
+/// \param nSrc Number of events in the source sample
+/// \param nEvt Number of indices to draw
+/// \param withReplacement Draw with (kTRUE) or without replacement
+/// \param idx Returned indices, in random order
+///
+/// Without replacement it runs a partial Fisher-Yates shuffle,
+/// so it is linear in \p nSrc and does not depend on
+/// the order of events in the source sample.
+void rarConfig::sampleIndices(Int_t nSrc, Int_t nEvt, Bool_t withReplacement,
+                              vector<Int_t> &idx)
+{
+  idx.clear();
+  if ((nSrc<=0)||(nEvt<=0)) return;
+  TRandom *rand=RooRandom::randomGenerator();
+  if (withReplacement) {
+    idx.resize(nEvt);
+    for (Int_t j=0; j<nEvt; j++) idx[j]=rand->Integer(nSrc);
+    return;
+  }
+  if (nEvt>nSrc) nEvt=nSrc;
+  idx.resize(nSrc);
+  for (Int_t j=0; j<nSrc; j++) idx[j]=j;
+  for (Int_t j=0; j<nEvt; j++) {
+    Int_t k=j+rand->Integer(nSrc-j);
+    Int_t tmp=idx[j];
+    idx[j]=idx[k];
+    idx[k]=tmp;
+  }
+  idx.resize(nEvt);
+}
+
+/// \brief Copy selected rows of a dataset into another one
+/// \param src The source dataset
+/// \param idx Indices of the rows to copy
+/// \param dest The dataset to add the rows to
+///
+/// The columns of \p dest are matched to those of \p src once,
+/// and each row is then copied value by value into a row buffer
+/// with the same layout as \p dest,
+/// instead of looking the columns up by name for every event.
+/// Columns of \p dest not in \p src keep their current values.
+void rarConfig::copyRows(const RooDataSet *src, const vector<Int_t> &idx,
+                         RooDataSet *dest)
+{
+  if (!src||!dest||(idx.size()<=0)) return;
+  RooArgSet *destRow=(RooArgSet*)dest->get()->snapshot(kFALSE);
+  const RooArgSet *srcRow=src->get();
+  RooArgList destVars(*destRow);
+  Int_t nVars=destVars.getSize();
+  vector<RooAbsRealLValue*> destReals;
+  vector<RooAbsReal*> srcReals;
+  vector<RooAbsCategoryLValue*> destCats;
+  vector<RooAbsCategory*> srcCats;
+  for (Int_t i=0; i<nVars; i++) {
+    RooAbsArg *srcVar=srcRow->find(destVars[i].GetName());
+    if (!srcVar) continue;
+    RooAbsRealLValue *destReal=dynamic_cast<RooAbsRealLValue*>(&destVars[i]);
+    RooAbsCategoryLValue *destCat=
+      dynamic_cast<RooAbsCategoryLValue*>(&destVars[i]);
+    if (destReal&&dynamic_cast<RooAbsReal*>(srcVar)) {
+      destReals.push_back(destReal);
+      srcReals.push_back((RooAbsReal*)srcVar);
+    } else if (destCat&&dynamic_cast<RooAbsCategory*>(srcVar)) {
+      destCats.push_back(destCat);
+      srcCats.push_back((RooAbsCategory*)srcVar);
+    }
+  }
+  Int_t nReals=destReals.size();
+  Int_t nCats=destCats.size();
+  Int_t nRows=idx.size();
+  for (Int_t j=0; j<nRows; j++) {
+    src->get(idx[j]);
+    for (Int_t i=0; i<nReals; i++) destReals[i]->setVal(srcReals[i]->getVal());
+    for (Int_t i=0; i<nCats; i++) destCats[i]->setIndex(srcCats[i]->getIndex());
+    dest->add(*destRow);
+  }
+  delete destRow;
+}
+
 /// \brief To create a RooRarFit Pdf object
 ///
 /// \param configStr The config string
@@ -0,0 +1,245 @@
+/*****************************************************************************
+* Project: BaBar detector at the SLAC PEP-II B-factory
+* Package: RooRarFit
+ *    File: $Id: rarConfigStore.cc,v 1.1 $
+ * Authors:
+ * History:
+ *
+ * Copyright (C) 2005-2012, University of California, Riverside
+ *****************************************************************************/
+
+// -- CLASS DESCRIPTION [RooRarFit] --
+// This class provides config store class for RooRarFit
+//////////////////////////////////////////////////////
+//
+// BEGIN_HTML
+// This class provides config store class for RooRarFit
+// END_HTML
+//
+
+#include "rarVersion.hh"
+
+#include "Riostream.h"
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+#include "TSystem.h"
+
+#include "RooArgSet.h"
+#include "RooStringVar.h"
+
+#include "rarConfigStore.hh"
+
+using std::cout;
+using std::endl;
+using std::ifstream;
+using std::string;
+
+ClassImp(rarConfigStore)
+  ;
+
+typedef std::unordered_map<string, string> rarConfigSection;
+
+/// \brief Index of one config file
+struct rarConfigIndex {
+  Bool_t indexed; ///< Can the file be served from the index
+  std::unordered_map<string, rarConfigSection> sections; ///< The sections
+};
+
+static std::unordered_map<string, rarConfigIndex> rarConfigIndices;
+
+/// \brief Strip leading and trailing spaces
+static string rarConfigTrim(const string &str)
+{
+  size_t first=str.find_first_not_of(" \t\r");
+  if (string::npos==first) return "";
+  size_t last=str.find_last_not_of(" \t\r");
+  return str.substr(first, last-first+1);
+}
+
+/// \brief Read one logical line
+///
+/// Exactly as RooStreamParser::readLine, used for files not indexed:
+/// two backslashes anywhere in a physical line continue it,
+/// the rest of that line being dropped, on the next line;
+/// comments are only chopped once the lines are joined.
+static Bool_t rarConfigReadLine(ifstream &ifs, string &line)
+{
+  if (!getline(ifs, line)) return kFALSE;
+  size_t pc, from(0);
+  while (string::npos!=(pc=line.find("\\\\", from))) {
+    string next;
+    line.erase(pc);
+    from=pc;
+    if (!getline(ifs, next)) break;
+    line+=next;
+  }
+  if (string::npos!=(pc=line.find("//"))) line.erase(pc);
+  return kTRUE;
+}
+
+/// \brief Check if a config file can be served from the index
+/// \param configFile The config file
+/// \return kTRUE if indexed
+///
+/// It parses the file on first call.
+Bool_t rarConfigStore::isIndexed(const char *configFile)
+{
+  std::unordered_map<string, rarConfigIndex>::iterator it=
+    rarConfigIndices.find(configFile);
+  if (it!=rarConfigIndices.end()) return it->second.indexed;
+  return parse(configFile);
+}
+
+/// \brief Look up a config item
+/// \param configFile The config file
+/// \param secName The config section
+/// \param name The config item name
+/// \param val The returned value (untouched if not found)
+/// \return kTRUE if the item is defined in the section
+Bool_t rarConfigStore::find(const char *configFile, const char *secName,
+                            const char *name, TString &val)
+{
+  if (!isIndexed(configFile)) return kFALSE;
+  rarConfigIndex &index=rarConfigIndices[configFile];
+  std::unordered_map<string, rarConfigSection>::iterator sec=
+    index.sections.find(secName?secName:"");
+  if (sec==index.sections.end()) return kFALSE;
+  rarConfigSection::iterator item=sec->second.find(name);
+  if (item==sec->second.end()) return kFALSE;
+  val=item->second.c_str();
+  return kTRUE;
+}
+
+/// \brief Check the index of a config file against RooFit's parser
+/// \param configFile The config file
+/// \return kTRUE if all indexed items agree
+///
+/// Each item of the index is read again with
+/// \p RooArgSet::readFromFile, i.e. the path used for files
+/// not indexed, and both values are compared.
+Bool_t rarConfigStore::check(const char *configFile)
+{
+  if (!isIndexed(configFile)) {
+    cout<<" rarConfigStore: "<<configFile<<" not indexed, nothing to check"
+        <<endl;
+    return kTRUE;
+  }
+  rarConfigIndex &index=rarConfigIndices[configFile];
+  Int_t nItems(0), nBad(0);
+  const char *notSet="rarConfigStore_notSet";
+  std::unordered_map<string, rarConfigSection>::iterator sec;
+  for (sec=index.sections.begin(); sec!=index.sections.end(); sec++) {
+    rarConfigSection::iterator item;
+    for (item=sec->second.begin(); item!=sec->second.end(); item++) {
+      RooArgSet strList("Check Config String List");
+      RooStringVar strVar(item->first.c_str(), "config string", notSet, 40960);
+      strList.add(strVar);
+      strList.readFromFile(configFile, 0, sec->first.c_str());
+      nItems++;
+      if (item->second==strVar.getVal()) continue;
+      nBad++;
+      cout<<" rarConfigStore: ["<<sec->first<<"] "<<item->first
+          <<": index \""<<item->second<<"\" RooFit \""<<strVar.getVal()
+          <<"\""<<endl;
+    }
+  }
+  cout<<" rarConfigStore: "<<configFile<<": "<<nItems<<" items, "
+      <<nBad<<" different from RooFit's parser"<<endl;
+  return 0==nBad;
+}
+
+/// \brief Check the index against RooFit's parser on a sample config
+/// \return kTRUE if all items agree
+///
+/// The sample exercises the parsing rules:
+/// continuation marker in the middle and at the end of a line,
+/// with a comment before it, value on the next line,
+/// repeated sections and overridden items.
+Bool_t rarConfigStore::selfTest()
+{
+  const char *sample=
+    "[sec A]\n"
+    "plain = value\n"
+    "padded =   padded value   \n"
+    "comment = value // a comment\n"
+    "midMarker = first \\\\ rest of line dropped\n"
+    "second line joined\n"
+    "trailing = first \\\\\n"
+    "  second\n"
+    "commentMarker = value // comment \\\\\n"
+    "still comment\n"
+    "nextLine =\n"
+    "value on next line\n"
+    "override = old\n"
+    "[sec B]\n"
+    "plain = other\n"
+    "[sec A]\n"
+    "override = new\n";
+  TString fileName="rarConfigStore_selfTest";
+  FILE *f=gSystem->TempFileName(fileName);
+  if (!f) {
+    cout<<" rarConfigStore: can not write self test config"<<endl;
+    return kFALSE;
+  }
+  fputs(sample, f);
+  fclose(f);
+  Bool_t ok=check(fileName);
+  rarConfigIndices.erase(fileName.Data());
+  gSystem->Unlink(fileName);
+  return ok;
+}
+
+/// \brief Drop all indices (e.g. after a config file changed)
+void rarConfigStore::reset()
+{
+  rarConfigIndices.clear();
+}
+
+/// \brief Parse a config file into the index
+/// \param configFile The config file
+/// \return kTRUE if indexed
+Bool_t rarConfigStore::parse(const char *configFile)
+{
+  rarConfigIndex &index=rarConfigIndices[configFile];
+  index.indexed=kFALSE;
+  ifstream ifs(configFile);
+  if (ifs.fail()) return kFALSE;
+
+  rarConfigSection *curSec(0);
+  string raw, line;
+  while (rarConfigReadLine(ifs, raw)) {
+    line=rarConfigTrim(raw);
+    if (line.empty()) continue;
+    // section header
+    if ('['==line[0]) {
+      size_t pe=line.rfind(']');
+      if (string::npos==pe) pe=line.length();
+      curSec=&index.sections[rarConfigTrim(line.substr(1, pe-1))];
+      continue;
+    }
+    // directives we do not handle, let RooFit read this file
+    string token=line.substr(0, line.find_first_of(" \t="));
+    if (("include"==token)||("if"==token)||("else"==token)||
+        ("endif"==token)) {
+      cout<<" rarConfigStore: "<<configFile<<" uses \""<<token<<"\""
+          <<", not indexed"<<endl;
+      index.sections.clear();
+      return kFALSE;
+    }
+    size_t eq=line.find('=');
+    if (string::npos==eq) continue;
+    string key=rarConfigTrim(line.substr(0, eq));
+    if (key.empty()||(string::npos!=key.find_first_of(" \t"))) continue;
+    string val=line.substr(eq+1);
+    // like RooStreamParser, "name =" right at end of line takes the next line
+    if (raw.find('=')+1==raw.length()) {
+      if (!rarConfigReadLine(ifs, val)) val="";
+    }
+    if (curSec) (*curSec)[key]=rarConfigTrim(val);
+  }
+
+  index.indexed=kTRUE;
+  return kTRUE;
+}
@@ -25,7 +25,9 @@
 #include "Riostream.h"
 #include <sstream>
 
+#include "TFile.h"
 #include "TMD5.h"
+#include "TSystem.h"
 
 #include "Roo1DTable.h"
 #include "RooArgList.h"
@@ -45,7 +47,7 @@ ClassImp(rarDatasets)
 /// Usually the objects should be created using other ctors.
 rarDatasets::rarDatasets()
   : rarConfig(),
-    _dsd(0), _fullFObs(0)
+    _dsd(0), _fullFObs(0), _dataCacheDir("")
 {
   init();
 }
@@ -63,7 +65,7 @@ rarDatasets::rarDatasets()
 rarDatasets::rarDatasets(const char *configFile, const char *configSec,
 			 const char *actionSec)
   : rarConfig(configFile, configSec, "null", "Datasets", "Datasets"),
-    _actionSec(actionSec), _dsd(0), _fullFObs(0)
+    _actionSec(actionSec), _dsd(0), _fullFObs(0), _dataCacheDir("")
 {
   init();
 }
@@ -80,6 +82,7 @@ rarDatasets::~rarDatasets()
 /// It then reads in the info of datasets,
 /// and prints out the datasets configured int the config section.
 /// It creates those datasets by calling #createDataSet
+/// (or reads them back from the dataset cache, see #getDataCacheFile)
 /// and adds them to the dataset list, #_dataSets.
 /// It also checks if the datasets need to be tabulated for output.
 void rarDatasets::init()
@@ -116,10 +119,10 @@ void rarDatasets::init()
   RooArgSet datasetList("Dataset List");
   for (Int_t i=0; i<nDataset; i++) {
     RooStringVar *dataset=new RooStringVar
-      (datasetsStrParser[i], datasetsStrParser[i], "notSet", 8192);
+      (datasetsStrParser[i], datasetsStrParser[i],
+       readConfStr(datasetsStrParser[i], "notSet"), 8192);
     datasetList.addOwned(*dataset);
   }
-  datasetList.readFromFile(_configFile, 0, _configSec);
   //datasetList.Print("v");
   // list configed datasets
   cout<<endl
@@ -129,6 +132,9 @@ void rarDatasets::init()
     cout<<Form(" dataset%02d ",i)<<datasetsStrParser[i]<<" "<<datasetStr<<endl;
   }
   cout<<endl;
+  // do we cache datasets read from files?
+  _dataCacheDir=readConfStr("dataCacheDir", "no");
+  if ("no"==_dataCacheDir) _dataCacheDir="";
   // now read in the datasets
   for (Int_t i=0; i<nDataset; i++) {
     Bool_t isUB=kFALSE;
@@ -136,7 +142,13 @@ void rarDatasets::init()
     // get name of weight variable
     TString wgtVarName = getWeightVarName(getDSName(datasetsStrParser[i]));
 
-    RooDataSet *data=createDataSet(datasetsStrParser[i]+" "+datasetStr, isUB, wgtVarName);
+    TString dsStr=datasetsStrParser[i]+" "+datasetStr;
+    TString cacheFile=getDataCacheFile(dsStr, wgtVarName);
+    RooDataSet *data=readDataCache(cacheFile);
+    if (!data) {
+      data=createDataSet(dsStr, isUB, wgtVarName);
+      writeDataCache(data, cacheFile);
+    }
     data->SetName(getDSName(datasetsStrParser[i]));
     _dataSets.Add(data);
     if (isUB) ubStr(getDSName(datasetsStrParser[i]), "Unblinded");
@@ -173,6 +185,111 @@ TString rarDatasets::getWeightVarName(TString datasetName)
   return(swvName);
 }
 
+/// \brief Get the dataset cache file for a dataset config string
+/// \param dsStr The dataset config string (name, type, title, args)
+/// \param wgtVarName The name of the weight var
+/// \return The cache file name, "" if the dataset can not be cached
+///
+/// Only datasets read from ascii/root files are cached.
+/// The file name contains an MD5 key computed from the config string
+/// (file names, tree name, cut string, options),
+/// the size and mtime of the source files,
+/// the weight var and the definition of the full observables
+/// (ranges of real ones, states of categories),
+/// so any change of the inputs gives a new cache file.
+TString rarDatasets::getDataCacheFile(TString dsStr, TString wgtVarName)
+{
+  if (""==_dataCacheDir) return "";
+  rarStrParser dsStrParser=dsStr;
+  if (dsStrParser.nArgs()<4) return "";
+  TString myName=dsStrParser[0];
+  TString dsType=dsStrParser[1];
+  if (("ascii"!=dsType)&&("root"!=dsType)) return "";
+  
+  stringstream key;
+  key<<RARFIT_VERSION<<"|"<<dsStr<<"|"<<wgtVarName<<"|";
+  // source files
+  TString fileStr=dsStrParser[3];
+  TString commonPath="";
+  if (("ascii"==dsType)&&(dsStrParser.nArgs()>5)) commonPath=dsStrParser[5];
+  rarStrParser fileParser=fileStr.ReplaceAll(",", " ");
+  for (Int_t i=0; i<fileParser.nArgs(); i++) {
+    TString fileName=fileParser[i];
+    if (""!=commonPath) fileName=commonPath+"/"+fileName;
+    FileStat_t fileStat;
+    if (gSystem->GetPathInfo(fileName, fileStat)) return "";
+    key<<fileName<<" "<<fileStat.fSize<<" "<<fileStat.fMtime<<"|";
+  }
+  // observable definitions
+  RooArgList fullObs(*_fullObs);
+  for (Int_t i=0; i<fullObs.getSize(); i++) {
+    RooAbsArg *theVar=fullObs.at(i);
+    key<<theVar->GetName()<<" "<<theVar->ClassName()<<" "
+       <<theVar->GetTitle();
+    RooRealVar *theRealVar=dynamic_cast<RooRealVar*>(theVar);
+    if (theRealVar) key<<" "<<theRealVar->getMin()<<" "<<theRealVar->getMax();
+    // category states: the labels and indices events are mapped to
+    RooAbsCategory *theCat=dynamic_cast<RooAbsCategory*>(theVar);
+    if (theCat) {
+      TIterator* catTypeIter = theCat->typeIterator();
+      RooCatType *theType(0);
+      while(theType=(RooCatType*)catTypeIter->Next())
+        key<<" "<<theType->GetName()<<"="<<theType->getVal();
+      delete catTypeIter;
+    }
+    key<<"|";
+  }
+  string keyStr=key.str();
+  TMD5 md5;
+  md5.Update((UChar_t*)keyStr.c_str(), keyStr.length());
+  md5.Final();
+  
+  return Form("%s/%s_%s.root", _dataCacheDir.Data(),
+              getDSName(myName).Data(), md5.AsString());
+}
+
+/// \brief Read a dataset back from the dataset cache
+/// \param cacheFile The cache file from #getDataCacheFile
+/// \return The dataset read in, or null if not cached
+RooDataSet *rarDatasets::readDataCache(TString cacheFile)
+{
+  if ((""==cacheFile)||gSystem->AccessPathName(cacheFile)) return 0;
+  TFile f(cacheFile);
+  RooDataSet *data=(RooDataSet*)f.Get("rarCachedData");
+  f.Close();
+  if (!data) {
+    cout<<" W A R N I N G !"<<endl
+        <<" Can not read cached dataset from "<<cacheFile<<endl;
+    return 0;
+  }
+  cout<<" Read "<<data->numEntries()<<" events from dataset cache "
+      <<cacheFile<<endl;
+  return data;
+}
+
+/// \brief Write a dataset into the dataset cache
+/// \param data The dataset to cache
+/// \param cacheFile The cache file from #getDataCacheFile
+///
+/// The dataset is written into a temporary file first
+/// and then renamed, so concurrent (toy) jobs never see partial files.
+void rarDatasets::writeDataCache(RooDataSet *data, TString cacheFile)
+{
+  if ((""==cacheFile)||!data) return;
+  gSystem->mkdir(_dataCacheDir, kTRUE);
+  TString tmpFile=Form("%s.%d.tmp", cacheFile.Data(), gSystem->GetPid());
+  TFile f(tmpFile, "RECREATE");
+  if (f.IsZombie()) {
+    cout<<" W A R N I N G !"<<endl
+        <<" Can not write dataset cache "<<cacheFile<<endl;
+    return;
+  }
+  data->Write("rarCachedData");
+  f.Close();
+  gSystem->Rename(tmpFile, cacheFile);
+  cout<<" Dataset cached in "<<cacheFile<<endl;
+}
+
 /// \brief Tabulate datasets wrt cats
 /// \param dsName The dataset name if provided
 ///
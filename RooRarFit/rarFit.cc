@@ -37,6 +37,8 @@
 #include "RooStringVar.h"
 
 #include "rarDatasets.hh"
+#include "rarConfigStore.hh"
+#include "rarFormulaCompiler.hh"
 #include "rarMLFitter.hh"
 
 extern Int_t doBanner();  // reference to RooFit's banner
@@ -58,6 +60,10 @@ void rarFitUsage(TString myCommand)
        <<"\t-t <toy job id> (default 0)"<<endl
        <<"\t-n <toyNexp> (default 0, use config)"<<endl
        <<"\t-d <toy dir> (default .toyData)"<<endl
+       <<"\t-c <formula cache dir> compile config formulas"
+       <<" (default no)"<<endl
+       <<"\t-k check the config index against RooFit's parser, and exit"
+       <<endl
        <<"e.g."<<endl
        <<"\tTo run "<<myCommand<<" from config file demo.config"<<endl
        <<myCommand<<" demo.config"<<endl
@@ -91,7 +97,10 @@ int main(int argc, char **argv)
   Int_t toyID(0);
   Int_t toyNexp(0);
   TString toyDir(".toyData");
-  while (EOF!=(optFlag=getopt(argc, argv, "hD:C:A:t:n:d:"))) {
+  TString formulaCacheDir("");
+  Bool_t checkConfig(kFALSE);
+  if (getenv("FORMULACACHEDIR")) formulaCacheDir=getenv("FORMULACACHEDIR");
+  while (EOF!=(optFlag=getopt(argc, argv, "hD:C:A:t:n:d:c:k"))) {
     switch (optFlag) {
     case 'h' :
       rarFitUsage(argv[0]);
@@ -115,6 +124,12 @@ int main(int argc, char **argv)
     case 'd' :
       toyDir=optarg;
       break;
+    case 'c' :
+      formulaCacheDir=optarg;
+      break;
+    case 'k' :
+      checkConfig=kTRUE;
+      break;
     }
   }
 
@@ -132,6 +147,13 @@ int main(int argc, char **argv)
   }
   ifs.close();
   
+  // only check the config index (same text through both parsers)
+  if (checkConfig) {
+    Bool_t ok=rarConfigStore::selfTest();
+    ok=rarConfigStore::check(ConfigFile)&&ok;
+    return ok?0:1;
+  }
+  
   // started
   TStopwatch timer;
   timer.Start();
@@ -161,6 +183,12 @@ int main(int argc, char **argv)
     RooRandom::randomGenerator()->SetSeed(randomSeed);
   }
   
+  // compile config formulas into native code?
+  if (""!=formulaCacheDir) {
+    cout<<" Compile config formulas, cache dir "<<formulaCacheDir<<endl;
+    rarFormulaCompiler::setCacheDir(formulaCacheDir);
+  }
+  
   // read in the datasets (for sig, bkg, MC, Onpeak data, etc.)
   rarDatasets theDatasets(ConfigFile, dataInputSec, fitterActionSec);
   // first set the mlFitter/action section name
@@ -0,0 +1,309 @@
+/*****************************************************************************
+* Project: BaBar detector at the SLAC PEP-II B-factory
+* Package: RooRarFit
+ *    File: $Id: rarFormulaCompiler.cc,v 1.1 $
+ * Authors:
+ * History:
+ *
+ * Copyright (C) 2005-2012, University of California, Riverside
+ *****************************************************************************/
+
+// -- CLASS DESCRIPTION [RooRarFit] --
+// This class provides formula compiler class for RooRarFit
+//////////////////////////////////////////////////////
+//
+// BEGIN_HTML
+// This class provides formula compiler class for RooRarFit
+// END_HTML
+//
+
+#include "rarVersion.hh"
+
+#include "Riostream.h"
+#include <ctype.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#include <set>
+#include <string>
+
+#include "TClass.h"
+#include "TInterpreter.h"
+#include "TMD5.h"
+#include "TSystem.h"
+
+#include "RooAbsPdf.h"
+#include "RooAbsReal.h"
+#include "RooArgList.h"
+#include "RooFormulaVar.h"
+#include "RooGenericPdf.h"
+
+#include "rarFormulaCompiler.hh"
+
+using std::cout;
+using std::endl;
+using std::ofstream;
+
+ClassImp(rarFormulaCompiler)
+  ;
+
+TString rarFormulaCompiler::_cacheDir="";
+
+// classes which failed to compile in this job
+static std::set<std::string> rarFormulaCompilerFailed;
+
+/// \brief Create a formula var, compiled if possible
+/// \param name The name
+/// \param title The title
+/// \param formula The formula string (as for \p RooFormulaVar)
+/// \param deps The formula dependents
+/// \return The formula var created
+///
+/// It returns an instance of the compiled formula class
+/// if compilation is enabled and succeeds,
+/// otherwise a \p RooFormulaVar.
+RooAbsReal *rarFormulaCompiler::createFormulaVar(const char *name,
+                                                 const char *title,
+                                                 const char *formula,
+                                                 const RooArgList &deps)
+{
+  if (""!=_cacheDir) {
+    TString expr=translate(formula, deps);
+    if (""!=expr) {
+      TString className=getClassName(expr, deps.getSize(), kFALSE);
+      if (compile(className, expr, deps.getSize(), kFALSE)) {
+        RooAbsReal *theVar=(RooAbsReal*)
+          instantiate(className, name, title, deps);
+        if (theVar) return theVar;
+      }
+    }
+  }
+  return new RooFormulaVar(name, title, formula, deps);
+}
+
+/// \brief Create a generic pdf, compiled if possible
+/// \param name The name
+/// \param title The title
+/// \param formula The formula string (as for \p RooGenericPdf)
+/// \param deps The formula dependents
+/// \return The pdf created
+///
+/// It returns an instance of the compiled pdf class
+/// if compilation is enabled and succeeds,
+/// otherwise a \p RooGenericPdf.
+RooAbsPdf *rarFormulaCompiler::createGenericPdf(const char *name,
+                                                const char *title,
+                                                const char *formula,
+                                                const RooArgList &deps)
+{
+  if (""!=_cacheDir) {
+    TString expr=translate(formula, deps);
+    if (""!=expr) {
+      TString className=getClassName(expr, deps.getSize(), kTRUE);
+      if (compile(className, expr, deps.getSize(), kTRUE)) {
+        RooAbsPdf *thePdf=(RooAbsPdf*)
+          instantiate(className, name, title, deps);
+        if (thePdf) return thePdf;
+      }
+    }
+  }
+  return new RooGenericPdf(name, title, formula, deps);
+}
+
+/// \brief Check if an arg is an instance of a compiled formula class
+/// \param arg The arg to check
+/// \return kTRUE if compiled
+Bool_t rarFormulaCompiler::isCompiled(const TObject *arg)
+{
+  if (!arg) return kFALSE;
+  return TString(arg->ClassName()).BeginsWith("rarCExpr_");
+}
+
+/// \brief Translate a RooFormula string into a C++ expression
+/// \param formula The formula string
+/// \param deps The formula dependents
+/// \return The C++ expression, or "" if it can not be translated
+///
+/// \p \@n and dependent names are replaced by \p _x[n],
+/// integer literals get a \p . so that they are doubles
+/// (as in TFormula, \p 1/2 is 0.5),
+/// everything else (operators, functions like
+/// \p exp or \p TMath::Power) is passed through to the compiler.
+/// Categories as dependents and TFormula-only syntax
+/// (\p ^ as power, \p ** ) are not supported.
+TString rarFormulaCompiler::translate(TString formula, const RooArgList &deps)
+{
+  Int_t nDeps=deps.getSize();
+  for (Int_t i=0; i<nDeps; i++)
+    if (!dynamic_cast<RooAbsReal*>(deps.at(i))) return "";
+  if (formula.Contains("^")||formula.Contains("**")) return "";
+
+  TString expr;
+  Int_t len=formula.Length();
+  Int_t i=0;
+  while (i<len) {
+    char c=formula[i];
+    if ('@'==c) { // @n
+      Int_t j=i+1;
+      while ((j<len)&&isdigit(formula[j])) j++;
+      if (j==i+1) return "";
+      Int_t idx=atoi(TString(formula(i+1, j-i-1)));
+      if (idx>=nDeps) return "";
+      expr+=Form("_x[%d]", idx);
+      i=j;
+    } else if (isdigit(c)||(('.'==c)&&(i+1<len)&&isdigit(formula[i+1]))) {
+      // number, keep exponents like 1e-3 intact
+      Int_t j=i;
+      while ((j<len)&&(isalnum(formula[j])||('.'==formula[j])||
+                       ((('+'==formula[j])||('-'==formula[j]))&&
+                        (('e'==formula[j-1])||('E'==formula[j-1])))))
+        j++;
+      // every literal as a double, as TFormula evaluates it:
+      // 1/2 has to be 0.5, not the integer division 0
+      TString number=formula(i, j-i);
+      Bool_t isDouble(kFALSE);
+      for (Int_t k=0; k<number.Length(); k++) {
+        char d=number[k];
+        if (('.'==d)||('e'==d)||('E'==d)) isDouble=kTRUE;
+        else if (!isdigit(d)&&('+'!=d)&&('-'!=d)) return ""; // 0x1, 1f...
+      }
+      expr+=number;
+      if (!isDouble) expr+=".";
+      i=j;
+    } else if (isalpha(c)||('_'==c)) { // identifier
+      Int_t j=i;
+      while ((j<len)&&(isalnum(formula[j])||('_'==formula[j])||
+                       ((':'==formula[j])&&(j+1<len)&&(':'==formula[j+1]))||
+                       ((':'==formula[j])&&(':'==formula[j-1]))))
+        j++;
+      TString ident=formula(i, j-i);
+      RooAbsArg *theDep=deps.find(ident);
+      if (theDep) expr+=Form("_x[%d]", deps.index(theDep));
+      else expr+=ident;
+      i=j;
+    } else {
+      expr+=c;
+      i++;
+    }
+  }
+  return expr;
+}
+
+/// \brief Get the generated class name for an expression
+/// \param expr The C++ expression
+/// \param nDeps Number of dependents
+/// \param isPdf Pdf or function
+/// \return The class name
+TString rarFormulaCompiler::getClassName(TString expr, Int_t nDeps,
+                                         Bool_t isPdf)
+{
+  TString key=Form("%s|%d|%s", isPdf?"Pdf":"Func", nDeps, expr.Data());
+  TMD5 md5;
+  md5.Update((const UChar_t*)key.Data(), key.Length());
+  md5.Final();
+  return Form("rarCExpr_%s_%.16s", isPdf?"Pdf":"Func", md5.AsString());
+}
+
+/// \brief Generate and compile the class for an expression
+/// \param className The class name
+/// \param expr The C++ expression
+/// \param nDeps Number of dependents
+/// \param isPdf Pdf or function
+/// \return kTRUE if the class is available
+///
+/// The source is only written if it is not in the cache dir yet,
+/// and ACLiC only rebuilds the library if it is older than the source,
+/// so each formula is compiled once across jobs.
+/// Concurrent jobs are serialized by a lock file per class around
+/// writing and compiling, and the source is written to a temporary
+/// file and then renamed, so no job ever compiles a partial source.
+Bool_t rarFormulaCompiler::compile(TString className, TString expr,
+                                   Int_t nDeps, Bool_t isPdf)
+{
+  if (rarFormulaCompilerFailed.count(className.Data())) return kFALSE;
+  if (TClass::GetClass(className)) return kTRUE;
+
+  gSystem->mkdir(_cacheDir, kTRUE);
+  TString srcFile=_cacheDir+"/"+className+".cxx";
+  TString lockFile=_cacheDir+"/"+className+".lock";
+  int lockFd=open(lockFile, O_CREAT|O_RDWR, 0644);
+  if (lockFd<0||flock(lockFd, LOCK_EX)) {
+    cout<<" rarFormulaCompiler: can not lock "<<lockFile<<endl
+        <<" use interpreted formula instead"<<endl;
+    if (lockFd>=0) close(lockFd);
+    rarFormulaCompilerFailed.insert(className.Data());
+    return kFALSE;
+  }
+  if (gSystem->AccessPathName(srcFile)) { // write it
+    TString baseClass=isPdf?"RooAbsPdf":"RooAbsReal";
+    Int_t nX=nDeps>0?nDeps:1;
+    TString tmpFile=Form("%s.%d.tmp", srcFile.Data(), gSystem->GetPid());
+    ofstream ofs(tmpFile);
+    ofs<<"// Generated by RooRarFit rarFormulaCompiler, do not edit"<<endl
+       <<"// "<<expr<<endl
+       <<"#include <cmath>"<<endl
+       <<"#include \"TMath.h\""<<endl
+       <<"#include \"RooArgList.h\""<<endl
+       <<"#include \"RooListProxy.h\""<<endl
+       <<"#include \""<<baseClass<<".h\""<<endl<<endl
+       <<"class "<<className<<" : public "<<baseClass<<" {"<<endl
+       <<"public:"<<endl
+       <<"  "<<className<<"() {}"<<endl
+       <<"  "<<className<<"(const char *name, const char *title,"
+       <<" const RooArgList &deps)"<<endl
+       <<"    : "<<baseClass<<"(name, title),"
+       <<" _deps(\"deps\", \"deps\", this) {_deps.add(deps);}"<<endl
+       <<"  "<<className<<"(const "<<className<<" &other,"
+       <<" const char *name=0)"<<endl
+       <<"    : "<<baseClass<<"(other, name),"
+       <<" _deps(\"deps\", this, other._deps) {}"<<endl
+       <<"  virtual TObject *clone(const char *newname) const"<<endl
+       <<"  {return new "<<className<<"(*this, newname);}"<<endl
+       <<"  virtual ~"<<className<<"() {}"<<endl
+       <<"protected:"<<endl
+       <<"  RooListProxy _deps;"<<endl
+       <<"  Double_t evaluate() const {"<<endl
+       <<"    Double_t _x["<<nX<<"];"<<endl
+       <<"    for (Int_t i=0; i<"<<nDeps<<"; i++)"<<endl
+       <<"      _x[i]=((RooAbsReal&)_deps[i]).getVal(_deps.nset());"<<endl
+       <<"    return ("<<expr<<");"<<endl
+       <<"  }"<<endl
+       <<"  ClassDef("<<className<<", 1)"<<endl
+       <<"};"<<endl;
+    ofs.close();
+    gSystem->Rename(tmpFile, srcFile);
+  }
+
+  cout<<" rarFormulaCompiler: compiling "<<srcFile<<endl;
+  Bool_t compiled=gSystem->CompileMacro(srcFile, "kO");
+  flock(lockFd, LOCK_UN);
+  close(lockFd);
+  if (!compiled||!TClass::GetClass(className)) {
+    cout<<" rarFormulaCompiler: can not compile \""<<expr<<"\""<<endl
+        <<" use interpreted formula instead"<<endl;
+    rarFormulaCompilerFailed.insert(className.Data());
+    return kFALSE;
+  }
+  return kTRUE;
+}
+
+/// \brief Create an instance of a compiled formula class
+/// \param className The class name
+/// \param name The name
+/// \param title The title
+/// \param deps The formula dependents
+/// \return The object created
+TObject *rarFormulaCompiler::instantiate(TString className, const char *name,
+                                         const char *title,
+                                         const RooArgList &deps)
+{
+  RooAbsArg *theArg=(RooAbsArg*)gInterpreter->
+    ProcessLineFast(Form("new %s(\"%s\",\"%s\",*(RooArgList*)%p);",
+                         className.Data(), className.Data(),
+                         className.Data(), (void*)&deps));
+  if (!theArg) return 0;
+  // name and title may carry quotes, so set them directly
+  theArg->SetName(name);
+  theArg->SetTitle(title);
+  return theArg;
+}
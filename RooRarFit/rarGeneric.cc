@@ -27,6 +27,7 @@
 #include "RooRealVar.h"
 #include "RooStringVar.h"
 
+#include "rarFormulaCompiler.hh"
 #include "rarGeneric.hh"
 
 ClassImp(rarGeneric)
@@ -73,7 +74,8 @@ rarGeneric::~rarGeneric()
 /// It first reads in the formula info from config item \p formula,
 /// gets the first token as formula string,
 /// and use #getFormulaArgs to get ArgList of the PDF,
-/// and finally it builds RooGenericPdf.
+/// and finally it builds RooGenericPdf
+/// (compiled by #rarFormulaCompiler if enabled).
 void rarGeneric::init()
 {
   cout<<"init of rarGeneric for "<<GetName()<<":"<<endl;
@@ -90,6 +92,7 @@ void rarGeneric::init()
   cout<<"formula string:\t"<<formulaStr<<endl;
   
   // create the generic pdf
-  _thePdf=new RooGenericPdf(Form("the_%s", GetName()), _pdfType+" "+GetTitle(),
-			    formula, *depVarList);
+  _thePdf=rarFormulaCompiler::createGenericPdf(Form("the_%s", GetName()),
+                                               _pdfType+" "+GetTitle(),
+                                               formula, *depVarList);
 }
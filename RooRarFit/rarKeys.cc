@@ -20,9 +20,19 @@
 #include "rarVersion.hh"
 
 #include "Riostream.h"
+#include <algorithm>
+#include <vector>
+
+#include "TFile.h"
+#include "TH1D.h"
+#include "TMD5.h"
+#include "TMath.h"
+#include "TSystem.h"
 
 #include "RooArgList.h"
+#include "RooDataHist.h"
 #include "RooDataSet.h"
+#include "RooHistPdf.h"
 #include "RooProdPdf.h"
 #include "RooRealVar.h"
 #include "RooStringVar.h"
@@ -32,15 +42,91 @@
 
 #include "rarKeys.hh"
 
+using std::vector;
+
+/// Version of the binned keys algorithm, part of the cache key:
+/// to be bumped whenever #getBinnedKeys changes its output
+static const Int_t rarKeysBinnedVersion=1;
+
 ClassImp(rarKeys)
   ;
 
+/// \brief In-place radix-2 FFT (size must be a power of 2)
+static void rarKeysFFT(vector<Double_t> &re, vector<Double_t> &im,
+                       Bool_t inverse)
+{
+  Int_t n=re.size();
+  for (Int_t i=1, j=0; i<n; i++) { // bit reversal
+    Int_t bit=n>>1;
+    for (; j&bit; bit>>=1) j^=bit;
+    j^=bit;
+    if (i<j) {
+      std::swap(re[i], re[j]);
+      std::swap(im[i], im[j]);
+    }
+  }
+  for (Int_t len=2; len<=n; len<<=1) {
+    Double_t ang=(inverse?2:-2)*TMath::Pi()/len;
+    Double_t wRe=cos(ang), wIm=sin(ang);
+    for (Int_t i=0; i<n; i+=len) {
+      Double_t uRe(1), uIm(0);
+      for (Int_t j=0; j<len/2; j++) {
+        Int_t a=i+j, b=i+j+len/2;
+        Double_t vRe=re[b]*uRe-im[b]*uIm;
+        Double_t vIm=re[b]*uIm+im[b]*uRe;
+        re[b]=re[a]-vRe;
+        im[b]=im[a]-vIm;
+        re[a]+=vRe;
+        im[a]+=vIm;
+        Double_t tRe=uRe*wRe-uIm*wIm;
+        uIm=uRe*wIm+uIm*wRe;
+        uRe=tRe;
+      }
+    }
+  }
+  if (inverse) {
+    for (Int_t i=0; i<n; i++) {
+      re[i]/=n;
+      im[i]/=n;
+    }
+  }
+}
+
+/// \brief Smallest power of 2 not less than n
+static Int_t rarKeysFFTSize(Int_t n)
+{
+  Int_t size=1;
+  while (size<n) size<<=1;
+  return size;
+}
+
+/// \brief Add the Gaussian smeared FFT of a grid to an accumulator
+/// \param grid The grid (padded to the FFT size)
+/// \param sigma Gaussian width in bins
+/// \param accRe Real part of the accumulated FFT
+/// \param accIm Imaginary part of the accumulated FFT
+static void rarKeysSmear(vector<Double_t> &grid, Double_t sigma,
+                         vector<Double_t> &accRe, vector<Double_t> &accIm)
+{
+  Int_t n=grid.size();
+  vector<Double_t> im(n, 0);
+  rarKeysFFT(grid, im, kFALSE);
+  Double_t c=-2*TMath::Pi()*TMath::Pi()*sigma*sigma;
+  for (Int_t j=0; j<n; j++) {
+    Double_t f=Double_t(j<=n/2?j:j-n)/n;
+    Double_t g=exp(c*f*f);
+    accRe[j]+=grid[j]*g;
+    accIm[j]+=im[j]*g;
+  }
+}
+
 /// \brief Trivial ctor
 ///
 /// Usually the objects should be created using other ctors.
 rarKeys::rarKeys()
   : rarBasePdf(),
-    _x(0), _y(0), _rho(1.), _keysOption("")
+    _x(0), _y(0), _rho(1.), _keysOption(""),
+    _binned(kFALSE), _nBins(1000), _cacheDir(""), _keysHist(0)
 {
   init();
 }
@@ -63,13 +149,15 @@ rarKeys::rarKeys(const char *configFile, const char *configSec,
 		 const char *name, const char *title)
   : rarBasePdf(configFile, configSec, configStr,
 	       theDatasets, theData, name, title),
-    _x(0), _y(0), _rho(1.), _keysOption("")
+    _x(0), _y(0), _rho(1.), _keysOption(""),
+    _binned(kFALSE), _nBins(1000), _cacheDir(""), _keysHist(0)
 {
   init();
 }
 
 rarKeys::~rarKeys()
 {
+  delete _keysHist;
 }
 
 /// \brief Initial function called by ctor
@@ -102,8 +190,31 @@ void rarKeys::init()
   _rho=atof(readConfStr("rho", "1.", getVarSec()));
   _keysOption=readConfStr("keysOption", "", getVarSec());
   
+  _binned=("yes"==readConfStr("keysBinned", "no", getVarSec()));
+  _nBins=atoi(readConfStr("keysBins", "1000", getVarSec()));
+  if (_nBins<10) _nBins=10;
+  _cacheDir=readConfStr("keysCacheDir", "", getVarSec());
+  if (_binned&&("2DKeys"==_pdfType)) {
+    cout<<" W A R N I N G !"<<endl
+        <<" keysBinned is only available for Keys, not for 2DKeys"<<endl
+        <<" unbinned 2DKeys Pdf is used for "<<GetName()<<endl;
+    _binned=kFALSE;
+  }
+  
   // create pdf
-  if ("2DKeys"==_pdfType) {
+  if (_binned&&("Keys"==_pdfType)) {
+    if (!dynamic_cast<RooRealVar*>(_x)) {
+      cout<<" Binned Keys Pdf needs a RooRealVar as observable"<<endl;
+      exit(-1);
+    }
+    TH1D *keysTable=getBinnedKeys();
+    _keysHist=new RooDataHist(Form("keysHist_%s", GetName()),
+                              Form("keys table of %s", GetName()),
+                              RooArgList(*_x), keysTable);
+    delete keysTable;
+    _thePdf=new RooHistPdf(Form("the_%s", GetName()), _pdfType+" "+GetTitle(),
+                           RooArgSet(*_x), *_keysHist, 1);
+  } else if ("2DKeys"==_pdfType) {
     _thePdf=new Roo2DKeysPdf(Form("the_%s", GetName()),_pdfType+" "+GetTitle(),
 			     *_x, *_y, *_theData, _keysOption, _rho);
   } else { // default
@@ -141,7 +252,214 @@ void rarKeys::setFitData(RooDataSet *theData)
   rarBasePdf::setFitData(theData);
   if (_theData==oldData) return;
   // recalculate keys pdf
+  if (_keysHist) {
+    // filled by bin centre, not index: the table is on the current
+    // binning of _x, which has to be that of the hist
+    TH1D *keysTable=getBinnedKeys();
+    if (keysTable->GetNbinsX()!=_keysHist->numEntries()) {
+      cout<<" Binned keys table of "<<GetName()<<" has "
+          <<keysTable->GetNbinsX()<<" bins, not "<<_keysHist->numEntries()
+          <<" as the pdf"<<endl;
+      exit(-1);
+    }
+    for (Int_t i=0; i<_keysHist->numEntries(); i++) {
+      const RooArgSet *theBin=_keysHist->get(i);
+      Double_t xc=((RooAbsReal*)theBin->find(_x->GetName()))->getVal();
+      Int_t k=keysTable->FindFixBin(xc);
+      if ((k<1)||(k>keysTable->GetNbinsX())) {
+        cout<<" Binned keys table of "<<GetName()<<" does not cover "
+            <<_x->GetName()<<"="<<xc<<endl;
+        exit(-1);
+      }
+      _keysHist->set(keysTable->GetBinContent(k));
+    }
+    delete keysTable;
+    _thePdf->setValueDirty();
+    return;
+  }
   if ("Keys"==_pdfType) ((RooKeysPdf*)_thePdf)->LoadDataSet(*_theData);
   if ("2DKeys"==_pdfType)
     ((Roo2DKeysPdf*)_thePdf)->loadDataSet(*_theData, _keysOption);
 }
+
+/// \brief Cache key of the binned keys table
+/// \return MD5 of the algorithm version, the settings
+///         and the dataset content
+TString rarKeys::getBinnedKeysKey()
+{
+  RooRealVar *x=(RooRealVar*)_x;
+  TString head=Form("v%d|%s|%.17g|%.17g|%d|%.17g|%s|%d",
+                    rarKeysBinnedVersion, x->GetName(),
+                    x->getMin(), x->getMax(), _nBins, _rho,
+                    _keysOption.Data(), _theData->numEntries());
+  TMD5 md5;
+  md5.Update((const UChar_t*)head.Data(), head.Length());
+  RooAbsReal *xData=(RooAbsReal*)_theData->get()->find(x->GetName());
+  for (Int_t i=0; i<_theData->numEntries(); i++) {
+    _theData->get(i);
+    Double_t vw[2]={xData->getVal(), _theData->weight()};
+    md5.Update((const UChar_t*)vw, sizeof(vw));
+  }
+  md5.Final();
+  return md5.AsString();
+}
+
+/// \brief Binned adaptive keys table
+/// \return Histogram of the keys pdf over the obs range
+///
+/// The bandwidths are those of RooKeysPdf:
+/// a fixed-width pilot estimate gives the adaptive width of each event.
+/// Events are binned on #_nBins bins, mirrored as in RooKeysPdf
+/// into the neighbouring ranges, and grouped into classes
+/// of similar width (5% apart);
+/// each class is smeared by one FFT convolution,
+/// so the cost is O(N + nClasses * nBins log nBins).
+TH1D *rarKeys::getBinnedKeys()
+{
+  RooRealVar *x=(RooRealVar*)_x;
+  Double_t lo=x->getMin();
+  Double_t hi=x->getMax();
+  Int_t M=_nBins;
+  Double_t dx=(hi-lo)/M;
+  // try the cache first
+  TString cacheFile="";
+  if (""!=_cacheDir) {
+    cacheFile=_cacheDir+"/keys_"+GetName()+"_"+getBinnedKeysKey()+".root";
+    if (!gSystem->AccessPathName(cacheFile)) {
+      TFile f(cacheFile);
+      TH1D *cached=(TH1D*)f.Get("keysTable");
+      // the binning has to be the current one, else rebuild
+      if (cached&&(cached->GetNbinsX()==M)&&
+          (TMath::Abs(cached->GetXaxis()->GetXmin()-lo)<=1e-9*dx)&&
+          (TMath::Abs(cached->GetXaxis()->GetXmax()-hi)<=1e-9*dx)) {
+        cached=(TH1D*)cached->Clone(Form("keys_%s", GetName()));
+        cached->SetDirectory(0);
+        cout<<" Binned keys table read from "<<cacheFile<<endl;
+        return cached;
+      }
+      cout<<" Binned keys table in "<<cacheFile
+          <<" does not match the binning of "<<x->GetName()<<", rebuilt"<<endl;
+    }
+  }
+  // bin the data
+  vector<Double_t> counts(M, 0);
+  Double_t sumW(0), sumWX(0), sumWX2(0);
+  RooAbsReal *xData=(RooAbsReal*)_theData->get()->find(x->GetName());
+  for (Int_t i=0; i<_theData->numEntries(); i++) {
+    _theData->get(i);
+    Double_t v=xData->getVal();
+    if ((v<lo)||(v>hi)) continue;
+    Double_t w=_theData->weight();
+    Int_t k=(Int_t)((v-lo)/dx);
+    if (k>=M) k=M-1;
+    counts[k]+=w;
+    sumW+=w;
+    sumWX+=w*v;
+    sumWX2+=w*v*v;
+  }
+  if (sumW<=0) {
+    cout<<" No events in range for binned Keys Pdf "<<GetName()<<endl;
+    exit(-1);
+  }
+  Double_t mean=sumWX/sumW;
+  Double_t sigma=sqrt(TMath::Max(sumWX2/sumW-mean*mean, 0.));
+  if (sigma<=0) sigma=dx;
+  // mirror options as in RooKeysPdf, +1 mirror, -1 asymmetric mirror
+  Int_t mirrorL(0), mirrorR(0);
+  if (("MirrorLeft"==_keysOption)||("MirrorBoth"==_keysOption)||
+      ("MirrorLeftAsymRight"==_keysOption)) mirrorL=1;
+  if (("MirrorAsymLeft"==_keysOption)||("MirrorAsymLeftRight"==_keysOption)||
+      ("MirrorAsymBoth"==_keysOption)) mirrorL=-1;
+  if (("MirrorRight"==_keysOption)||("MirrorBoth"==_keysOption)||
+      ("MirrorAsymLeftRight"==_keysOption)) mirrorR=1;
+  if (("MirrorAsymRight"==_keysOption)||("MirrorLeftAsymRight"==_keysOption)||
+      ("MirrorAsymBoth"==_keysOption)) mirrorR=-1;
+  // grid of 3 ranges, with the source bin of each grid bin
+  Int_t nGrid=3*M;
+  vector<Double_t> grid(nGrid, 0);
+  vector<Int_t> src(nGrid, -1);
+  for (Int_t k=0; k<M; k++) {
+    grid[M+k]=counts[k];
+    src[M+k]=k;
+    if (mirrorL) {
+      grid[M-1-k]=mirrorL*counts[k];
+      src[M-1-k]=k;
+    }
+    if (mirrorR) {
+      grid[3*M-1-k]=mirrorR*counts[k];
+      src[3*M-1-k]=k;
+    }
+  }
+  // pilot estimate with fixed width
+  Double_t h=TMath::Power(4./3., .2)*TMath::Power(sumW, -.2)*_rho;
+  Double_t hMin=h*sigma*sqrt(2.)/10;
+  Double_t norm=h*sqrt(sigma)/(2.*sqrt(3.));
+  Double_t hPilot=h*sigma/dx; // in bins
+  Int_t nFFT=rarKeysFFTSize(nGrid+2*(Int_t)ceil(5*hPilot)+1);
+  vector<Double_t> pilot(grid);
+  pilot.resize(nFFT, 0);
+  vector<Double_t> accRe(nFFT, 0), accIm(nFFT, 0);
+  rarKeysSmear(pilot, hPilot, accRe, accIm);
+  rarKeysFFT(accRe, accIm, kTRUE);
+  // adaptive width of each bin
+  vector<Double_t> width(M, 0);
+  Double_t wMin(-1), wMax(-1);
+  for (Int_t k=0; k<M; k++) {
+    if (0==counts[k]) continue;
+    Double_t f0=accRe[M+k]/(sumW*dx);
+    width[k]=(f0>0)?norm/sqrt(f0):hi-lo;
+    if (width[k]<hMin) width[k]=hMin;
+    if (width[k]>hi-lo) width[k]=hi-lo;
+    if ((wMin<0)||(width[k]<wMin)) wMin=width[k];
+    if (width[k]>wMax) wMax=width[k];
+  }
+  // width classes
+  Double_t step=1.05;
+  Int_t nClasses=(Int_t)ceil(log(wMax/wMin)/log(step))+1;
+  if (nClasses>64) {
+    nClasses=64;
+    step=exp(log(wMax/wMin)/(nClasses-1));
+  }
+  vector<Int_t> cls(M, -1);
+  for (Int_t k=0; k<M; k++) {
+    if (0==counts[k]) continue;
+    cls[k]=(nClasses>1)?TMath::Nint(log(width[k]/wMin)/log(step)):0;
+  }
+  // smear each class
+  Double_t wMaxBins=wMin*TMath::Power(step, nClasses-1)/dx;
+  nFFT=rarKeysFFTSize(nGrid+2*(Int_t)ceil(5*wMaxBins)+1);
+  accRe.assign(nFFT, 0);
+  accIm.assign(nFFT, 0);
+  vector<Double_t> classGrid(nFFT);
+  for (Int_t c=0; c<nClasses; c++) {
+    Bool_t used(kFALSE);
+    classGrid.assign(nFFT, 0);
+    for (Int_t g=0; g<nGrid; g++) {
+      if ((src[g]<0)||(cls[src[g]]!=c)) continue;
+      classGrid[g]=grid[g];
+      used=kTRUE;
+    }
+    if (!used) continue;
+    rarKeysSmear(classGrid, wMin*TMath::Power(step, c)/dx, accRe, accIm);
+  }
+  rarKeysFFT(accRe, accIm, kTRUE);
+  // the table over the obs range
+  TH1D *keysTable=new TH1D(Form("keys_%s", GetName()), "binned keys",
+                           M, lo, hi);
+  keysTable->SetDirectory(0);
+  for (Int_t k=0; k<M; k++)
+    keysTable->SetBinContent(k+1, TMath::Max(accRe[M+k], 0.));
+  if (keysTable->Integral()>0) keysTable->Scale(1./keysTable->Integral());
+  // save to the cache, via a temporary file renamed when complete,
+  // so concurrent jobs never read a partial file
+  if (""!=cacheFile) {
+    gSystem->mkdir(_cacheDir, kTRUE);
+    TString tmpFile=Form("%s.%d.tmp", cacheFile.Data(), gSystem->GetPid());
+    TFile f(tmpFile, "RECREATE");
+    keysTable->Write("keysTable");
+    f.Close();
+    gSystem->Rename(tmpFile, cacheFile);
+    cout<<" Binned keys table saved to "<<cacheFile<<endl;
+  }
+  return keysTable;
+}
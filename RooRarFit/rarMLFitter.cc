@@ -27,6 +27,8 @@
 using namespace std;
 
 #include <libgen.h>
+#include <sys/wait.h>
+#include <unistd.h>
 #include "TFile.h"
 #include "TTree.h"
 #include "TObjString.h"
@@ -38,9 +40,11 @@ using namespace std;
 #include "RooChi2Var.h"
 #include "RooHistError.h"
 #include "RooArgList.h"
+#include "RooDataHist.h"
 #include "RooDataSet.h"
 #include "RooFitResult.h"
 #include "RooMCStudy.h"
+#include "RooNumber.h"
 #include "RooNLLVar.h"
 #include "RooPlot.h"
 #include "RooProdPdf.h"
@@ -57,7 +61,10 @@ using namespace RooFit;
 #include "rarMinuit.hh"
 #include "rarMLPdf.hh"
 #include "rarNLL.hh"
+#include "rarParallel.hh"
 #include "rarSPlot.hh"
+#include "rarToyGen.hh"
+#include "rarToyStore.hh"
 
 #include "rarMLFitter.hh"
 #include "rarToyList.hh"
@@ -804,6 +811,10 @@ void rarMLFitter::doSignf(RooDataSet *mlFitData, TString signfStr,
 /// \param o The output stream
 ///
 /// It performs systematic error study.
+/// With \p postMLSysNumProcs (default 1, <=0 for all cores) larger than 1,
+/// the plus/minus variation fits are run in forked worker processes,
+/// each starting from the nominal fit result,
+/// and the deltas are sent back to build the same error table.
 void rarMLFitter::doSysStudy(RooDataSet *mlFitData, TString paramsStr,
 			     TString varsStr, RooArgSet fullParams,
 			     ostream &o)
@@ -873,8 +884,9 @@ void rarMLFitter::doSysStudy(RooDataSet *mlFitData, TString paramsStr,
   // string for all params varied
   TString vParams="";
   TArrayD pV(1), mV(1);
-  TArrayD pArray(studyVars.getSize()), mArray(studyVars.getSize());
-  TArrayD aArray(studyVars.getSize()); // avg error
+  // param sets and variation units (error or value) of all variations
+  vector<RooArgSet> sysParamSets;
+  vector<Bool_t> pUseErr, mUseErr;
   // loop over all params
   while (paramsStrParser.nArgs()>0) {
     TString theParamName=paramsStrParser[0];
@@ -899,12 +911,6 @@ void rarMLFitter::doSysStudy(RooDataSet *mlFitData, TString paramsStr,
     // reset arrays
     pV.Set(nSysParams);
     mV.Set(nSysParams);
-    pArray.Set(nSysParams*studyVars.getSize());
-    mArray.Set(nSysParams*studyVars.getSize());
-    aArray.Set(nSysParams*studyVars.getSize());
-    // for this param
-    cout<<" SysStudy for "<<theParamName<<endl;
-    theParamSet.Print("v");
     // for plus variation
     Bool_t useErr=kTRUE;
     pV[nSysParams-1]=defVU;
@@ -917,20 +923,7 @@ void rarMLFitter::doSysStudy(RooDataSet *mlFitData, TString paramsStr,
 	if (myVStr.EndsWith("V")||(myVStr.EndsWith("v"))) useErr=kFALSE;
       }
     }
-    // restore params
-    readFromStr(fullParams, fParamSStr);
-    // set variation
-    setVariation(theParamSet, pV[nSysParams-1], useErr, kTRUE);
-    // fit
-
-    _thePdf->fitTo(*mlFitData, ConditionalObservables(_conditionalObs), 
-   		   Save(sysFitSave), Extended(sysFitExtended), 
-		   Verbose(sysFitVerbose), Hesse(sysFitHesse),
-		   Minos(sysFitMinos));
-   // doTheFit(_thePdf, mlFitData, sysFitOpt, ncpus);
-
-    // calculation errors
-    calSysErrors(nSysParams-1, *cStudyVars, studyVars, pArray);
+    pUseErr.push_back(useErr);
     // for minus variation
     // do we have minusV specified?
     mV[nSysParams-1]=pV[nSysParams-1];
@@ -942,18 +935,114 @@ void rarMLFitter::doSysStudy(RooDataSet *mlFitData, TString paramsStr,
 	if (myVStr.EndsWith("V")||(myVStr.EndsWith("v"))) useErr=kFALSE;
       }
     }
+    mUseErr.push_back(useErr);
+    sysParamSets.push_back(theParamSet);
+  }
+  Int_t nStudyVars=studyVars.getSize();
+  TArrayD pArray(nSysParams*nStudyVars), mArray(nSysParams*nStudyVars);
+  TArrayD aArray(nSysParams*nStudyVars); // avg error
+  // fit with the iVar-th variation (2*iParam for plus, 2*iParam+1 for minus)
+  // starting from the nominal fit result
+  auto sysFit=[&](Int_t iVar, Int_t iParam, TArrayD &eArray) {
+    Int_t j=iVar/2;
+    Bool_t isPlus=(0==iVar%2);
+    RooArgSet &theParamSet=sysParamSets[j];
+    if (isPlus) {
+      cout<<" SysStudy for "<<rarStrParser(vParams)[j]<<endl;
+      theParamSet.Print("v");
+    }
     // restore params
     readFromStr(fullParams, fParamSStr);
     // set variation
-    setVariation(theParamSet, mV[nSysParams-1], useErr, kFALSE);
+    if (isPlus) setVariation(theParamSet, pV[j], pUseErr[j], kTRUE);
+    else setVariation(theParamSet, mV[j], mUseErr[j], kFALSE);
     // fit
     _thePdf->fitTo(*mlFitData, ConditionalObservables(_conditionalObs), 
-    		   Save(sysFitSave), Extended(sysFitExtended), 
+		   Save(sysFitSave), Extended(sysFitExtended), 
 		   Verbose(sysFitVerbose), Hesse(sysFitHesse),
 		   Minos(sysFitMinos));
-    //doTheFit(_thePdf, mlFitData, sysFitOpt, ncpus);
+    // doTheFit(_thePdf, mlFitData, sysFitOpt, ncpus);
     // calculation errors
-    calSysErrors(nSysParams-1, *cStudyVars, studyVars, mArray);
+    calSysErrors(iParam, *cStudyVars, studyVars, eArray);
+  };
+  // number of worker processes for the variation fits
+  Int_t sysNumProcs=atoi(readConfStrCnA("postMLSysNumProcs", "1"));
+  sysNumProcs=rarNThreads(sysNumProcs);
+  if (sysNumProcs<=1) {
+    for (Int_t iVar=0; iVar<2*nSysParams; iVar++)
+      sysFit(iVar, iVar/2, (0==iVar%2)?pArray:mArray);
+  } else {
+    cout<<" Running "<<2*nSysParams<<" variation fits with up to "
+        <<sysNumProcs<<" worker processes"<<endl;
+    // running workers: pid -> (variation index, read end of its pipe)
+    map<pid_t, pair<Int_t, Int_t> > workers;
+    Int_t nextVar(0);
+    while ((nextVar<2*nSysParams)||(workers.size()>0)) {
+      // start workers as long as there are free slots
+      while ((nextVar<2*nSysParams)&&((Int_t)workers.size()<sysNumProcs)) {
+        Int_t fds[2];
+        if (pipe(fds)) {
+          cout<<" Can not create pipe for sys study worker"<<endl;
+          exit(-1);
+        }
+        cout.flush();
+        fflush(stdout);
+        pid_t pid=fork();
+        if (pid<0) {
+          cout<<" Can not fork sys study worker"<<endl;
+          exit(-1);
+        }
+        if (0==pid) { // worker: fit and send the deltas back
+          close(fds[0]);
+          TArrayD eArray(nStudyVars);
+          sysFit(nextVar, 0, eArray);
+          size_t nBytes=nStudyVars*sizeof(Double_t);
+          const char *buf=(const char*)eArray.GetArray();
+          while (nBytes>0) {
+            ssize_t n=write(fds[1], buf, nBytes);
+            if (n<=0) break;
+            buf+=n;
+            nBytes-=n;
+          }
+          close(fds[1]);
+          cout.flush();
+          fflush(stdout);
+          _exit(nBytes>0?1:0);
+        }
+        close(fds[1]);
+        workers[pid]=make_pair(nextVar++, fds[0]);
+      }
+      // collect one finished worker
+      Int_t status(0);
+      pid_t pid=wait(&status);
+      if (pid<0) {
+        cout<<" Lost sys study workers"<<endl;
+        exit(-1);
+      }
+      map<pid_t, pair<Int_t, Int_t> >::iterator w=workers.find(pid);
+      if (w==workers.end()) continue;
+      Int_t iVar=w->second.first;
+      Int_t fd=w->second.second;
+      workers.erase(w);
+      TArrayD eArray(nStudyVars);
+      size_t nBytes=nStudyVars*sizeof(Double_t);
+      char *buf=(char*)eArray.GetArray();
+      while (nBytes>0) {
+        ssize_t n=read(fd, buf, nBytes);
+        if (n<=0) break;
+        buf+=n;
+        nBytes-=n;
+      }
+      close(fd);
+      if ((nBytes>0)||!WIFEXITED(status)||WEXITSTATUS(status)) {
+        cout<<" Sys study worker for "<<rarStrParser(vParams)[iVar/2]
+            <<((0==iVar%2)?" (+)":" (-)")<<" failed"<<endl;
+        exit(-1);
+      }
+      TArrayD &theArray=(0==iVar%2)?pArray:mArray;
+      for (Int_t i=0; i<nStudyVars; i++)
+        theArray[(iVar/2)*nStudyVars+i]=eArray[i];
+    }
   }
   // get correlation matrix
   TMatrixD corrM1=getCorrMatrix(nSysParams, vParams, kTRUE);
@@ -1174,6 +1263,8 @@ TMatrixD rarMLFitter::getCorrMatrix(Int_t nSysParams, TString vParams,
 /// \return GOF chisq
 ///
 /// It does chisq GOF study for mlFit.
+/// The pdf is integrated over each bin in contiguous chunks of bins
+/// on \p GOFNumProcs (default \p useNumCPU) worker processes.
 Double_t rarMLFitter::doGOFChisq(RooDataSet *mlFitData, ostream &o,
                              TList *plotList)
 {
@@ -1223,53 +1314,70 @@ Double_t rarMLFitter::doGOFChisq(RooDataSet *mlFitData, ostream &o,
   RooDataHist pHist("pHist", "pHist", GOFObsSet);
   Int_t nBins=pHist.numEntries();
   Double_t sum(0);
-  for (Int_t i=0; i<nBins; i++) {
-    const RooArgSet *theBinSet=pHist.get(i);
-    // set bin for each obs
-    RooArgList theBinList(*theBinSet);
-    for (Int_t j=0; j<theBinList.getSize(); j++) {
-      RooRealVar *theBin=dynamic_cast<RooRealVar*>(theBinList.at(j));
-      if (!theBin) {
-        RooAbsCategory *theCat=dynamic_cast<RooAbsCategory*>
-          (theBinList.at(j));
-        if (!theCat) continue;
-        RooAbsCategoryLValue *theInCat=(RooAbsCategoryLValue*)
-          inputCats.find(theCat->GetName());
-        if (!theInCat) continue;
-        theInCat->setLabel(theCat->getLabel());
-        continue;
-      }
-      RooRealVar *theVar=dynamic_cast<RooRealVar*>(GOFObsList.at(j));
-      assert(theVar);
-      Double_t hbSize=(theBin->getMax()-theBin->getMin())/theBin->getBins()/2.;
-      theVar->setRange("subrange",
-		       theBin->getVal()-hbSize, theBin->getVal()+hbSize);
-      theVar->setVal(theBin->getVal());
-      //theBin->Print();
-      //theVar->Print();
-    }
-    // the pdf to integrate
-    RooAbsPdf *theIntPdf(_thePdf);
-    if (theSuperCat) {
-      theIntPdf=((RooSimultaneous*)_thePdf)->getPdf(theSuperCat->getLabel());
-      //theIntPdf->Print();
-      //theIntPdf->Print("v");
-    }
-    // get integral
-    RooAbsReal *pdfIntegral(0);
-    if (theIntPdf) pdfIntegral=
-      theIntPdf->createIntegral(GOFObsSet, GOFObsSet, "subrange");
-    //pdfIntegral->Print("v");
-    Double_t thisIntegral(0);
+  // Each worker computes the expected events of each (category) pdf once.
+  // (The bin integral is created for each bin: RooFit caches
+  // range-dependent normalization objects, which are not reliably
+  // invalidated when the subrange is moved.)
+  Int_t nProcs=atoi(readConfStr("GOFNumProcs",
+                                readConfStr("useNumCPU", "1", getMasterSec()),
+                                _runSec));
+  TArrayD binVals(nBins);
+  Bool_t ok=rarForkFor(nBins, nProcs, 1, binVals.GetArray(),
+                       [&](Int_t first, Int_t last, Double_t *out) {
+    map<RooAbsPdf*, Double_t> pdfExpEvents;
     RooArgSet nullDS;
-    if (pdfIntegral) thisIntegral=
-      theIntPdf->expectedEvents(&nullDS)*pdfIntegral->getVal();
-    if (theSuperCat) thisIntegral/=theSuperCat->numTypes();
-    sum+=thisIntegral;
-    //cout<<"pdfIntegral="<<thisIntegral<<endl;
-    // fill the bin
-    pHist.set(*theBinSet, thisIntegral);
-    //theBin->Print("v");
+    for (Int_t i=first; i<last; i++) {
+      const RooArgSet *theBinSet=pHist.get(i);
+      // set bin for each obs
+      RooArgList theBinList(*theBinSet);
+      for (Int_t j=0; j<theBinList.getSize(); j++) {
+        RooRealVar *theBin=dynamic_cast<RooRealVar*>(theBinList.at(j));
+        if (!theBin) {
+          RooAbsCategory *theCat=dynamic_cast<RooAbsCategory*>
+            (theBinList.at(j));
+          if (!theCat) continue;
+          RooAbsCategoryLValue *theInCat=(RooAbsCategoryLValue*)
+            inputCats.find(theCat->GetName());
+          if (!theInCat) continue;
+          theInCat->setLabel(theCat->getLabel());
+          continue;
+        }
+        RooRealVar *theVar=dynamic_cast<RooRealVar*>(GOFObsList.at(j));
+        assert(theVar);
+        Double_t hbSize=
+          (theBin->getMax()-theBin->getMin())/theBin->getBins()/2.;
+        theVar->setRange("subrange",
+                         theBin->getVal()-hbSize, theBin->getVal()+hbSize);
+        theVar->setVal(theBin->getVal());
+      }
+      // the pdf to integrate
+      RooAbsPdf *theIntPdf(_thePdf);
+      if (theSuperCat)
+        theIntPdf=((RooSimultaneous*)_thePdf)->getPdf(theSuperCat->getLabel());
+      // get integral
+      Double_t thisIntegral(0);
+      if (theIntPdf) {
+        map<RooAbsPdf*, Double_t>::iterator pIt=pdfExpEvents.find(theIntPdf);
+        if (pIt==pdfExpEvents.end())
+          pIt=pdfExpEvents.insert
+            (make_pair(theIntPdf, theIntPdf->expectedEvents(&nullDS))).first;
+        RooAbsReal *pdfIntegral=
+          theIntPdf->createIntegral(GOFObsSet, GOFObsSet, "subrange");
+        thisIntegral=pIt->second*pdfIntegral->getVal();
+        delete pdfIntegral;
+      }
+      if (theSuperCat) thisIntegral/=theSuperCat->numTypes();
+      out[i]=thisIntegral;
+    }
+  });
+  if (!ok) {
+    cout<<" GOF worker processes failed"<<endl;
+    exit(-1);
+  }
+  // fill the bins
+  for (Int_t i=0; i<nBins; i++) {
+    sum+=binVals[i];
+    pHist.set(*pHist.get(i), binVals[i]);
   }
   if (plotList) {
     cout<<"sum="<<sum<<endl;
@@ -1278,11 +1386,14 @@ Double_t rarMLFitter::doGOFChisq(RooDataSet *mlFitData, ostream &o,
   // create histograms
   TH1F *dataHist(0);
   TH1F *pdfHist(0);
+  TH1F *pullHist(0);
   if (plotList) {
     dataHist=new TH1F("dataHist_GOF", "dataHist_GOF", nBins, 0, 1);
     pdfHist=new TH1F("pdfHist_GOF", "pdfHist_GOF", nBins, 0, 1);
+    pullHist=new TH1F("pullHist_GOF", "pullHist_GOF", nBins, 0, 1);
     plotList->Add(dataHist);
     plotList->Add(pdfHist);
+    plotList->Add(pullHist);
   }
   // calculate chisq by myself
   Double_t chisq(0);
@@ -1297,13 +1408,14 @@ Double_t rarMLFitter::doGOFChisq(RooDataSet *mlFitData, ostream &o,
     Double_t deh=yp-dw;
     Double_t pw=pHist.weight(*theBinSet,0);
     if (plotList) {
-      dataHist->SetBinContent(i, dw);
-      pdfHist->SetBinContent(i, pw);
+      dataHist->SetBinContent(i+1, dw);
+      pdfHist->SetBinContent(i+1, pw);
     }
     Double_t pwmdw=pw-dw;
     Double_t err=(pwmdw>0)?deh:del;
     if (0==err) continue;
     chisq+=pwmdw*pwmdw/(err*err);
+    if (plotList) pullHist->SetBinContent(i+1, -pwmdw/err);
     
     if (plotList)
       cout<<"err="<<err<<" dw="<<dw<<" pw="<<pw<<endl;
@@ -1691,6 +1803,33 @@ RooDataSet *rarMLFitter::doToyStudy(RooArgSet fullParams)
   // get number of cpus option
   Int_t toyFitNumCPU=atoi(readConfStr("useNumCPU", "1", getMasterSec()));
 
+  // toy generator: RooFit's (roofit) or cached CDF tables (cdf)
+  rarToyGen *toyGen(0);
+  TString toyGenMethod=readConfStr("toyGenMethod", "roofit", _runSec);
+  toyGenMethod.ToLower();
+  if ("cdf"==toyGenMethod) {
+    Int_t toyGenCDFBins=atoi(readConfStr("toyGenCDFBins", "10000", _runSec));
+    Int_t toyGenNumThreads=
+      atoi(readConfStr("toyGenNumThreads",
+                       readConfStr("useNumCPU", "1", getMasterSec()),
+                       _runSec));
+    toyGen=new rarToyGen(toyGenCDFBins, toyGenNumThreads);
+  }
+
+  // stream each toy fit to a root file as it completes
+  rarToyStore *toyStore(0);
+  Int_t toyStreamPrint(0);
+  Bool_t toyStreamOnly(kFALSE);
+  TString toyStreamFile=readConfStr("toyStreamFile", "no", _runSec);
+  if ("no"!=toyStreamFile) {
+    toyStore=new rarToyStore
+      (getRootFileName("toyStream", toyStreamFile),
+       atoi(readConfStr("toyStreamFlush", "1", _runSec)));
+    toyStreamPrint=atoi(readConfStr("toyStreamPrint", "0", _runSec));
+    // do not keep toy results in memory
+    toyStreamOnly=("yes"==readConfStr("toyStreamOnly", "no", _runSec));
+  }
+
   // now see if we have toyFitMinos (do Minos only for some parameters)
   RooArgSet toyFitMinosAS;
   TString toyFitMinosStr=readConfStr("toyFitMinos", "notSet", _runSec);
@@ -1842,6 +1981,9 @@ RooDataSet *rarMLFitter::doToyStudy(RooArgSet fullParams)
     // save params after possible randomization
     string randParamSStr;
     writeToStr(fullParams, randParamSStr);
+    // true values for streamed pulls
+    RooArgSet *toyTruth(0);
+    if (toyStore) toyTruth=(RooArgSet*)fullParams.snapshot(kFALSE);
     // now check if there are any data need to be generated from dataset
     TString genStr="";
     Double_t toyNevtGen=toyNevt;
@@ -1986,6 +2128,9 @@ RooDataSet *rarMLFitter::doToyStudy(RooArgSet fullParams)
       toyChkNegativePdf=kTRUE;
     }
     RooDataSet *chkNPdfDS(0);
+    // generated samples, owned by theToy unless from toyGen
+    TList toySamples;
+    Bool_t fastGen(kFALSE);
     // generate
     if ("no"!=readConfStr("toyGenerate", "yes", _runSec)) {
       if (firstToy) {
@@ -1996,8 +2141,24 @@ RooDataSet *rarMLFitter::doToyStudy(RooArgSet fullParams)
       if (toyChkNegativePdf) {
         chkNPdfDS=_dummyPdf.generate(toyDeps, *protData, (Int_t)toyNevt);
       }
-      // generate through standard RooMCStudy
-      theToy->generate(nExpPerLoop, randInt(toyNevtGen), kTRUE);
+      // generate through cached CDF tables if the generator allows
+      if (toyGen) {
+        fastGen=toyGen->prepare(theGen, toyDeps, protData);
+        if (firstToy&&!fastGen)
+          cout<<"Toy Generator can not be tabulated,"
+              <<" use RooMCStudy to generate"<<endl;
+      }
+      if (fastGen) {
+        for (Int_t i=0; i<nExpPerLoop; i++) {
+          Int_t nEvt=randInt(toyNevtGen);
+          if (extendedGen) nEvt=RooRandom::randomGenerator()->Poisson(nEvt);
+          toySamples.Add(toyGen->generate(nEvt));
+        }
+      } else { // generate through standard RooMCStudy
+        theToy->generate(nExpPerLoop, randInt(toyNevtGen), kTRUE);
+        for (Int_t i=0; i<nExpPerLoop; i++)
+          toySamples.Add((RooDataSet*)theToy->genData(i));
+      }
       RooArgSet toyObs(toyDeps);
       if (protData) toyObs.add(*protData->get(),kTRUE);
       if (firstToy) {
@@ -2018,28 +2179,28 @@ RooDataSet *rarMLFitter::doToyStudy(RooArgSet fullParams)
 	  _protDataEVars.Print("v");
 	  cout<<"Toy genStr "<<genStr<<endl;
 	}
-	generate(theToy, etoyDeps, genStr, genOpt, nExpPerLoop);
+	generate(toySamples, etoyDeps, genStr, genOpt);
       }
       if (!toyFileName.BeginsWith("no")) { // output toy data per request
         Int_t nSamples=nExpPerLoop;
         while (nSamples--) {
 	  TString thisToyFileName=Form(toyFileName.Data(),nSamples);
-          ((RooDataSet*)theToy->genData(nSamples))->write(thisToyFileName);
+          ((RooDataSet*)toySamples.At(nSamples))->write(thisToyFileName);
           //cout<<"toy sample structure"<<endl;
-          //((RooDataSet*)theToy->genData(nSamples))->Print();
+          //((RooDataSet*)toySamples.At(nSamples))->Print();
 	  thisToyFileName.ReplaceAll(".text", ".root");
 #ifndef USENEWROOT
 	  TFile f(thisToyFileName, "recreate");
-	  ((RooDataSet*)theToy->genData(nSamples))->tree().Write();
+	  ((RooDataSet*)toySamples.At(nSamples))->tree().Write();
 	  f.Close();
 #else
-	  RooDataSet *theSet = (RooDataSet*) theToy->genData(nSamples);
+	  RooDataSet *theSet = (RooDataSet*) toySamples.At(nSamples);
 	  saveAsRootFile(theSet, thisToyFileName, kTRUE);
 #endif
 	}
       }
       if (firstToy) { // save sample 
-	RooDataSet *toySample=(RooDataSet*)theToy->genData(0);
+	RooDataSet *toySample=(RooDataSet*)toySamples.At(0);
 	toySample=(RooDataSet*)toySample->Clone();
 	toySample->SetName(_datasets->getDSName("toySample"));
 	_datasets->getDatasetList()->Add(toySample);
@@ -2071,7 +2232,7 @@ RooDataSet *rarMLFitter::doToyStudy(RooArgSet fullParams)
         // construct dataset list
         TList genSamples;
         Int_t nSamples=nExpPerLoop;
-        while (nSamples--) genSamples.Add(theToy->genData(nSamples)->Clone());
+        while (nSamples--) genSamples.Add(toySamples.At(nSamples)->Clone());
         theToy->fit(nExpPerLoop, genSamples);
       } else {
         theToy->fit(nExpPerLoop, toyFileName);
@@ -2138,7 +2299,7 @@ RooDataSet *rarMLFitter::doToyStudy(RooArgSet fullParams)
         RooRealVar GOFChisq("GOFChisq", "GOFChisq", 0);
         fitParData.addColumn(GOFChisq);
       }
-      if (!toyResults) {
+      if (!toyResults&&!toyStreamOnly) {
 	toyResults=new
           RooDataSet("toyResults","toyResults",*theToy->fitParDataSet().get());
       }
@@ -2146,6 +2307,8 @@ RooDataSet *rarMLFitter::doToyStudy(RooArgSet fullParams)
       Int_t ii=0;
       for (Int_t i=0; i<nExpPerLoop; i++) {
 	RooFitResult *fr=(RooFitResult*)theToy->fitResult(i);
+	if (toyStore)
+	  toyStore->fill(fr, *toyTruth, _toyID, expIdx, nExpPerLoop-i);
 	if (fr->status()) {
 	  cout<<"Toy Fit status for experiment #"<<expIdx<<"-"<<nExpPerLoop-i
 	      <<": "<<fr->status()<<endl;
@@ -2175,16 +2338,25 @@ RooDataSet *rarMLFitter::doToyStudy(RooArgSet fullParams)
         Double_t gofChisq(0);
 	TString postMLGOFChisq=readConfStrCnA("postMLGOFChisq", "no");
         if (!postMLGOFChisq.BeginsWith("no"))
-          gofChisq=doGOFChisq((RooDataSet*)theToy->genData(i), cout);
+          gofChisq=doGOFChisq((RooDataSet*)toySamples.At(i), cout);
         ((RooRealVar*)fitResultSet->find("GOFChisq"))->setVal(gofChisq);
 
-	toyResults->add(*fitResultSet);
+	if (toyResults) toyResults->add(*fitResultSet);
 	ii++;
       }
+      if (toyStore&&(toyStreamPrint>0)&&(0==(expIdx+1)%toyStreamPrint))
+        toyStore->printSummary(cout);
     }
+    if (toyTruth) delete toyTruth;
+    if (fastGen) toySamples.Delete();
     delete theToy;
     firstToy=kFALSE;
   }
+  if (toyGen) {
+    delete toyGen;
+    rarToyGen::clearCache();
+  }
+  if (toyStore) delete toyStore;
   
   //return theToy;
   return toyResults;
@@ -2295,14 +2467,31 @@ void rarMLFitter::generate(RooMCStudy *theToy,
 			   const RooArgList& etoyDeps,
 			   const TString genStr, const TString genOpt,
 			   const Int_t toyNexp)
+{
+  TList genSamples;
+  for (Int_t i=0; i<toyNexp; i++)
+    genSamples.Add((RooDataSet*)theToy->genData(i));
+  generate(genSamples, etoyDeps, genStr, genOpt);
+}
+
+/// \brief Append events from data sources to toy samples
+///
+/// \param genSamples Toy samples generated by PDFs
+/// \param etoyDeps Observables to be embedded from dataset
+/// \param genStr Generation string
+/// \param genOpt Generation option
+///
+/// Same as the RooMCStudy version, for samples not kept by RooMCStudy.
+void rarMLFitter::generate(TList &genSamples, const RooArgList& etoyDeps,
+			   const TString genStr, const TString genOpt)
 {
   cout<<endl<<" In rarMLFitter generate (embed) for "<<GetName()<<endl;
   
   // generate toys
-  Int_t nSamples=toyNexp;
+  Int_t nSamples=genSamples.GetSize();
   while(nSamples--) {
     cout<<endl;
-    RooDataSet *genSample=(RooDataSet *)theToy->genData(nSamples);
+    RooDataSet *genSample=(RooDataSet *)genSamples.At(nSamples);
     // generate each sub sample from genStr
     rarStrParser genStrParser=genStr;
     Int_t nSubset=genStrParser.nArgs()/2;
@@ -2422,15 +2611,9 @@ RooDataSet *rarMLFitter::generate(const RooArgList& dependents,
       subSample=new RooDataSet("subSample", "subSample", subSampleSet);
     }
     if(!subSample) continue;
-    for (Int_t j=0; j<nEvtGen; j++) {
-      Int_t I=RooRandom::randomGenerator()->Integer(genSrcData->numEntries());
-      const RooArgSet* row=genSrcData->get(I);
-      if(!row) {
-	cout<<"skipping null row entry I="<<I<<endl;
-	continue;
-      }
-      subSample->add(*row);
-    }
+    vector<Int_t> genIdx;
+    sampleIndices(genSrcData->numEntries(), (Int_t)nEvtGen, kTRUE, genIdx);
+    copyRows(genSrcData, genIdx, subSample);
     if (!theSample)
       theSample=subSample;
     else {
@@ -2444,12 +2627,9 @@ RooDataSet *rarMLFitter::generate(const RooArgList& dependents,
     RooDataSet *protSample=
       new RooDataSet("protEDataSet", "prot embedded Dataset", _protDataEVars);
     Int_t nEvt=theSample->numEntries();
-    for (Int_t i=0; i<nEvt; i++) {
-      Int_t Idx=RooRandom::randomGenerator()->
-	Integer(_protDataset->numEntries());
-      const RooArgSet* row=_protDataset->get(Idx);
-      protSample->add(*row);
-    }
+    vector<Int_t> protIdx;
+    sampleIndices(_protDataset->numEntries(), nEvt, kTRUE, protIdx);
+    copyRows(_protDataset, protIdx, protSample);
     cout<<"Merge "<<nEvt<<" events from prototype dataset "
 	<<_protDataset->GetName()<<endl;
     theSample->merge(protSample);
@@ -2795,13 +2975,53 @@ void rarMLFitter::getSnB()
   return;
 }
 
+/// \brief Evaluate LLR for each event of a dataset
+/// \param theData The dataset
+/// \param LLR LLR function
+/// \param llrVals Array to store LLR values, one per event
+///
+/// The LLR function (and so the S and B pdfs) is evaluated once per event,
+/// in contiguous chunks of events on \p projLLRNumProcs
+/// (default \p useNumCPU) worker processes.
+void rarMLFitter::getLLRValues(RooDataSet *theData, RooAbsReal *LLR,
+                               TArrayD &llrVals)
+{
+  Int_t nEvts=theData->numEntries();
+  llrVals.Set(nEvts);
+  Int_t nProcs=atoi(readConfStr("projLLRNumProcs",
+                                readConfStr("useNumCPU", "1", getMasterSec()),
+                                _runSec));
+  // same as RooDataSet::addColumn: a clone attached to the dataset
+  RooAbsReal *theLLR=(RooAbsReal*)LLR->cloneTree();
+  theLLR->attachDataSet(*theData);
+  const RooArgSet *nset=theData->get();
+  cout<<" Evaluating "<<LLR->GetName()<<" for "<<nEvts<<" events of "
+      <<theData->GetName()<<endl;
+  Bool_t ok=rarForkFor(nEvts, nProcs, 1, llrVals.GetArray(),
+                       [&](Int_t first, Int_t last, Double_t *out) {
+                         for (Int_t i=first; i<last; i++) {
+                           theData->get(i);
+                           out[i]=theLLR->getVal(nset);
+                         }
+                       });
+  delete theLLR;
+  if (!ok) {
+    cout<<" LLR worker processes for "<<theData->GetName()<<" failed"<<endl;
+    exit(-1);
+  }
+}
+
 /// \brief Get dataset with LLR added
 /// \param theData The dataset to add LLR
 /// \param LLR LLR function to add
+/// \param llrVals Array to store LLR values if not null
 /// \return The dataset created
 ///
-/// It creates dataset with LLR added
-RooDataSet *rarMLFitter::getLLRDataset(RooDataSet *theData, RooFormulaVar *LLR)
+/// It creates dataset with LLR added.
+/// The LLR values are computed by #getLLRValues
+/// and merged into the new dataset as one column.
+RooDataSet *rarMLFitter::getLLRDataset(RooDataSet *theData, RooFormulaVar *LLR,
+                                       TArrayD *llrVals)
 {
   RooDataSet *retDS=new
     RooDataSet(*theData,Form("%s_wLLR", theData->GetName()));
@@ -2814,7 +3034,18 @@ RooDataSet *rarMLFitter::getLLRDataset(RooDataSet *theData, RooFormulaVar *LLR)
   //LLR->Print("v");
   //retDS->Print();
   //retDS->Print("v");
-  retDS->addColumn(*LLR);
+  TArrayD theVals;
+  if (!llrVals) llrVals=&theVals;
+  getLLRValues(retDS, LLR, *llrVals);
+  RooRealVar llrVar(LLR->GetName(), LLR->GetTitle(),
+                    -RooNumber::infinity(), RooNumber::infinity());
+  RooDataSet llrData("llrData", "llrData", RooArgSet(llrVar));
+  const Double_t *vals=llrVals->GetArray();
+  for (Int_t i=0; i<llrVals->GetSize(); i++) {
+    llrVar.setVal(vals[i]);
+    llrData.add(RooArgSet(llrVar));
+  }
+  retDS->merge(&llrData);
   // now remove the limits
   setColLimits(retDS, kFALSE);
   // if removing limits of derived columns is keeping causing problems,
@@ -2826,6 +3057,31 @@ RooDataSet *rarMLFitter::getLLRDataset(RooDataSet *theData, RooFormulaVar *LLR)
   return retDS;
 }
 
+/// \brief Get LLR cut scan
+/// \param plotList Plot list
+/// \param LLRHist LLR histogram
+///
+/// With \p projLLRCutScan set to yes, it adds a histogram
+/// with the (weighted) number of events passing LLR>cut
+/// for each cut at the lower bin edges of \p LLRHist,
+/// so cuts can be scanned without evaluating the pdfs again.
+void rarMLFitter::getLLRCutScan(TList &plotList, TH1F *LLRHist)
+{
+  TString llrCutScan=readConfStr("projLLRCutScan", "no", _runSec);
+  if ("no"==llrCutScan) return;
+  Int_t nBins=LLRHist->GetNbinsX();
+  TString histName=Form("%s_cutScan", LLRHist->GetName());
+  TH1F *scanHist=new TH1F(histName, "LLR cut scan", nBins,
+                          LLRHist->GetXaxis()->GetXmin(),
+                          LLRHist->GetXaxis()->GetXmax());
+  Double_t nPass(LLRHist->GetBinContent(nBins+1));
+  for (Int_t i=nBins; i>=1; i--) {
+    nPass+=LLRHist->GetBinContent(i);
+    scanHist->SetBinContent(i, nPass);
+  }
+  plotList.Add(scanHist);
+}
+
 /// \brief Get LLR plot
 /// \param projData Dataset to fit for mlFit action
 /// \param plotList Plot list
@@ -2853,14 +3109,20 @@ void rarMLFitter::doLLRPlot(RooDataSet *projData, TList &plotList)
   Int_t nBins=atoi(readConfStr("plotBins_LLR", "100", _runSec));
   // now for projection dataset
   TH1F *LLRP0=new TH1F(Form("LLR_%s", projData->GetName()),"LLR ds",nBins,0,1);
-  projData=getLLRDataset(projData, lRatioFunc);
+  TArrayD llrVals;
+  projData=getLLRDataset(projData, lRatioFunc, &llrVals);
+  Bool_t isWeighted=projData->isWeighted();
   for (Int_t idxEvt=0; idxEvt<projData->numEntries(); idxEvt++) {
-    RooArgSet *dEntry=(RooArgSet*)projData->get(idxEvt);
-    LLRP0->Fill(((RooRealVar*)dEntry->find(funcName))->getVal(),
-                projData->weight());
+    Double_t wgt(1);
+    if (isWeighted) {
+      projData->get(idxEvt);
+      wgt=projData->weight();
+    }
+    LLRP0->Fill(llrVals[idxEvt], wgt);
   }
   LLRP0->Print("v");
   plotList.Add(LLRP0);
+  getLLRCutScan(plotList, LLRP0);
   RooDataSet *protData(0);
   /// \todo this _protDataVars should be replaced with fullProtVars
   if (_protDataVars.getSize()>0)
@@ -2941,15 +3203,21 @@ void rarMLFitter::getLLRPlot(TList &plotList, TString plotName,
   if (protData)
     theData=thePdf->generate(theDeps,*protData,nEvt,kFALSE,kTRUE);
   else theData=thePdf->generate(theDeps, nEvt);
-  theData->addColumn(*LLRFunc);
+  TArrayD llrVals;
+  getLLRValues(theData, LLRFunc, llrVals);
   theHist=new TH1F(histName, "LLR hist", nBins,0,1);
+  Bool_t isWeighted=theData->isWeighted();
   for (Int_t idxEvt=0; idxEvt<theData->numEntries(); idxEvt++) {
-    RooArgSet *dEntry=(RooArgSet*)theData->get(idxEvt);
-    theHist->Fill(((RooRealVar*)dEntry->find(LLRFunc->GetName()))->getVal(),
-                  theData->weight());
+    Double_t wgt(1);
+    if (isWeighted) {
+      theData->get(idxEvt);
+      wgt=theData->weight();
+    }
+    theHist->Fill(llrVals[idxEvt], wgt);
   }
   theHist->Print("v");
   plotList.Add(theHist);
+  getLLRCutScan(plotList, theHist);
   delete theData;
   return;
 }
@@ -3044,10 +3312,11 @@ RooPlot *rarMLFitter::doProjPlot(RooDataSet *projData, RooRealVar *theVar,
       // create histogram for ratio searching
       TH1F *nTotHist=new TH1F("nTotHist_"+varName,"nTotHist_"+varName,sStep,0,1);
       cout<<" Creating nTotHist_"+varName<<endl;
+      // the row set is reused by get(idxEvt), find the column once
+      RooRealVar *llrCol=(RooRealVar*)theData->get()->find(funcName);
       for (Int_t idxEvt=0; idxEvt<theData->numEntries(); idxEvt++) {
-	RooArgSet *dEntry=(RooArgSet*)theData->get(idxEvt);
-	nTotHist->Fill(((RooRealVar*)dEntry->find(funcName))->getVal(),
-		       theData->weight());
+	theData->get(idxEvt);
+	nTotHist->Fill(llrCol->getVal(), theData->weight());
       }
       delete theData;
       nTotHist->Print("v");
@@ -3109,10 +3378,10 @@ RooPlot *rarMLFitter::doProjPlot(RooDataSet *projData, RooRealVar *theVar,
 	TString hName=Form("hist_%s_%s", rarPdf->GetName(), varName.Data());
 	TH1F *h=new TH1F(hName, hName, sStep, 0, 1);
 	cout<<" Creating histogram "<<h->GetName()<<endl;
+	RooRealVar *llrCol=(RooRealVar*)theData->get()->find(funcName);
 	for (Int_t idxEvt=0; idxEvt<theData->numEntries(); idxEvt++) {
-	  RooArgSet *dEntry=(RooArgSet*)theData->get(idxEvt);
-	  h->Fill(((RooRealVar*)dEntry->find(funcName))->getVal(),
-		  theData->weight());
+	  theData->get(idxEvt);
+	  h->Fill(llrCol->getVal(), theData->weight());
 	}
 	plotList.Add(h);
 	h->Scale(sigScale/h->GetEntries());
@@ -3193,8 +3462,12 @@ RooPlot *rarMLFitter::doProjPlot(RooDataSet *projData, RooRealVar *theVar,
   // Lists for proj datasets
   TList projDS;
   TList projNames;
+  TList projCatNames; // category and cut of each proj dataset
+  TList projCuts;
   projDS.Add(sliceData);
   projNames.Add(new TObjString(frameName));
+  projCatNames.Add(new TObjString(""));
+  projCuts.Add(new TObjString(""));
   // proj cat
   TString projPlotCat=readConfStr("projPlotCat_"+varName,"notSet", _runSec);
   if ("notSet"==projPlotCat)
@@ -3222,18 +3495,28 @@ RooPlot *rarMLFitter::doProjPlot(RooDataSet *projData, RooRealVar *theVar,
 	RooDataSet *catSliceData=(RooDataSet*)sliceData->reduce(catCut);
 	projDS.Add(catSliceData);
 	projNames.Add(new TObjString(frameName+"_"+catCut));
+	projCatNames.Add(new TObjString(catName));
+	projCuts.Add(new TObjString(catCut));
       }
       delete cIter;
     }
   }
+  // binned projection data, built once for all the plots of theVar:
+  // that of each (category) slice is reduced from it
+  RooDataHist *binnedData=getBinnedProjData((RooDataSet*)projDS.At(0), theVar);
   // projection plot for each dataset
   for (Int_t pIdx=0; pIdx<projDS.GetSize(); pIdx++) {
     sliceData=(RooDataSet*)projDS.At(pIdx);
     frameName=projNames.At(pIdx)->GetName();
+    RooDataHist *sliceBinned=binnedData;
+    if (binnedData&&pIdx>0)
+      sliceBinned=reduceBinnedProjData(binnedData, projCatNames.At(pIdx)->
+                                       GetName(), projCuts.At(pIdx)->
+                                       GetName(), sliceData);
     if ("no"==projAsymPlot) {
       frame=getProjPlot(theVar, plotMin, plotMax, nBins, sliceData,
 		     frameName, frameTitle, plotList, RooCmdArg(), RooCmdArg(),
-		      XErrorSize(xerrorscale));
+		      XErrorSize(xerrorscale), 0, 0, sliceBinned);
     } else { // asym plot
       // check cat
       RooCategory *cat=(RooCategory *)_fullObs->find(projAsymPlot);
@@ -3260,18 +3543,28 @@ RooPlot *rarMLFitter::doProjPlot(RooDataSet *projData, RooRealVar *theVar,
       RooDataSet *catSliceData=(RooDataSet*)sliceData->reduce(catCutMinus);
       cout<<"Dataset (-) with cut: "<<catCutMinus<<endl;
       catSliceData->Print();
+      RooDataHist *catBinned(0);
+      if (sliceBinned) catBinned=reduceBinnedProjData
+        (sliceBinned, projAsymPlot, catCutMinus, catSliceData);
       RooPlot *frameM=
 	getProjPlot(theVar, plotMin, plotMax, nBins, catSliceData,
 		    frameName+"_Minus", frameTitle+" Minus", plotList,
-		    RooCmdArg(), RooCmdArg(), XErrorSize(xerrorscale));
+		    RooCmdArg(), RooCmdArg(), XErrorSize(xerrorscale),
+		    0, 0, catBinned);
+      delete catBinned;
       delete catSliceData;
       catSliceData=(RooDataSet*)sliceData->reduce(catCutPlus);
       cout<<"Dataset (+) with cut: "<<catCutPlus<<endl;
       catSliceData->Print();
+      catBinned=0;
+      if (sliceBinned) catBinned=reduceBinnedProjData
+        (sliceBinned, projAsymPlot, catCutPlus, catSliceData);
       RooPlot *frameP=
 	getProjPlot(theVar, plotMin, plotMax, nBins, catSliceData,
 		    frameName+"_Plus", frameTitle+" Plus", plotList,
-		     RooCmdArg(), RooCmdArg(), XErrorSize(xerrorscale));
+		     RooCmdArg(), RooCmdArg(), XErrorSize(xerrorscale),
+		    0, 0, catBinned);
+      delete catBinned;
       delete catSliceData;
       delete catI;
       // now asym plot
@@ -3281,9 +3574,13 @@ RooPlot *rarMLFitter::doProjPlot(RooDataSet *projData, RooRealVar *theVar,
 			XErrorSize(xerrorscale), frameM, frameP);
     }
     sliceData->Print("v");
+    if (sliceBinned!=binnedData) delete sliceBinned;
   }
+  delete binnedData;
   projDS.Delete();
   projNames.Delete();
+  projCatNames.Delete();
+  projCuts.Delete();
   
   // do we need to save the dataset as well
   TString saveDS=readConfStrCnA("projPlotSaveLLR", "no");
@@ -3317,6 +3614,8 @@ RooPlot *rarMLFitter::doProjPlot(RooDataSet *projData, RooRealVar *theVar,
 /// \param xerrorscale Scale of X errors with respect to bin width
 /// \param frameM Frame of Minus type
 /// \param frameP Frame of Plus type
+/// \param binnedData Binned projection data of \p sliceData,
+///        from #getBinnedProjData if 0
 /// \return The frame created
 ///
 /// This the actual function to draw the projection plots.
@@ -3329,7 +3628,8 @@ RooPlot *rarMLFitter::getProjPlot(RooRealVar *theVar, Double_t plotMin,
 				  const RooCmdArg &asymCat,
 				  const RooCmdArg &nuBins,
 				  const RooCmdArg &xerrorscale,
-				  RooPlot *frameM, RooPlot *frameP)
+				  RooPlot *frameM, RooPlot *frameP,
+				  RooDataHist *binnedData)
 {
   // first add limits to addOns for sliceData
   setColLimits(sliceData);
@@ -3347,8 +3647,13 @@ RooPlot *rarMLFitter::getProjPlot(RooRealVar *theVar, Double_t plotMin,
   Int_t lineWidth=2;
   Int_t lineColor=kBlue;
   if (!(frameM&&frameP)) { // plot pdf and components
+    // binned projection data shared by the pdf and all its components
+    RooDataHist *ownBinned(0);
+    if (!binnedData) binnedData=ownBinned=getBinnedProjData(sliceData, theVar);
+    RooAbsData *projWData=sliceData;
+    if (binnedData) projWData=binnedData;
     //_thePdf->plotOn(frame, ProjWData(_conditionalObs, *sliceData),asymCat,
-    _thePdf->plotOn(frame, ProjWData(*sliceData),asymCat,
+    _thePdf->plotOn(frame, ProjWData(*projWData),asymCat,
                     LineStyle(lineStyle), LineColor(lineColor));
     for (Int_t i=0; i<_fCompList.GetSize(); i++) {
       if (lineStyle>2) lineStyle=2;
@@ -3357,10 +3662,11 @@ RooPlot *rarMLFitter::getProjPlot(RooRealVar *theVar, Double_t plotMin,
       TString pdfName=compPdf->getPdf()->GetName();
       TString compStr=pdfName+","+pdfName+"_*";
       cout<<"Comps to proj: "<<compStr<<endl;
-      _thePdf->plotOn(frame, Components(compStr), ProjWData(*sliceData),
+      _thePdf->plotOn(frame, Components(compStr), ProjWData(*projWData),
 		      asymCat, LineWidth(lineWidth), LineStyle(lineStyle),
 		      LineColor(getColor(i)), Name(pdfName));
     }
+    delete ownBinned;
   } else { // plot asym between two sets of pdf components
     Int_t nCurves=(Int_t)frameP->numItems();
     for (Int_t i=1; i<nCurves; i++) {
@@ -3391,6 +3697,94 @@ RooPlot *rarMLFitter::getProjPlot(RooRealVar *theVar, Double_t plotMin,
   return frame;
 }
 
+/// \brief Get binned projection data
+/// \param sliceData Reduced dataset to project with
+/// \param theVar obs to plot
+/// \return The binned dataset, 0 if binned projection is not used
+///
+/// With \p projBinned_<var> (or \p projBinned) set to yes,
+/// the observables projected over (all pdf observables
+/// in \p sliceData except \p theVar) are binned with
+/// \p projBinnedBins (default 20) bins for each real observable,
+/// so that the pdf and each component are evaluated once per
+/// occupied bin instead of once per event for every curve point.
+/// If the binned dataset would not be smaller than \p sliceData,
+/// 0 is returned and the event-by-event projection is used.
+RooDataHist *rarMLFitter::getBinnedProjData(RooDataSet *sliceData,
+                                            RooRealVar *theVar)
+{
+  TString varName=theVar->GetName();
+  TString projBinned=readConfStr("projBinned_"+varName, "notSet", _runSec);
+  if ("notSet"==projBinned)
+    projBinned=readConfStr("projBinned", "no", _runSec);
+  if ("no"==projBinned) return 0;
+  Int_t nBins=atoi(readConfStr("projBinnedBins", "20", _runSec));
+  if (nBins<=0) nBins=20;
+  // obs to project over
+  RooArgSet *projVars=_thePdf->getObservables(sliceData);
+  projVars->remove(*theVar, kFALSE, kTRUE);
+  if (projVars->getSize()<1) {
+    delete projVars;
+    return 0;
+  }
+  // named binning, so the default binning of the obs is untouched
+  Double_t nGrid(1);
+  TIterator *iter=projVars->createIterator();
+  RooAbsArg *theArg(0);
+  while(theArg=(RooAbsArg*)iter->Next()) {
+    RooRealVar *theRVar=dynamic_cast<RooRealVar*>(theArg);
+    if (theRVar) {
+      theRVar->setBins(nBins, "projBinned");
+      nGrid*=nBins;
+    } else {
+      RooAbsCategory *theCat=dynamic_cast<RooAbsCategory*>(theArg);
+      if (theCat) nGrid*=theCat->numTypes();
+    }
+  }
+  delete iter;
+  if (nGrid>=sliceData->numEntries()) {
+    cout<<" "<<nGrid<<" bins for binned projection of "<<varName
+        <<" not fewer than "<<sliceData->numEntries()<<" events"<<endl
+        <<" use unbinned projection"<<endl;
+    delete projVars;
+    return 0;
+  }
+  RooDataHist *binnedData=
+    new RooDataHist(Form("%s_projBinned", sliceData->GetName()),
+                    sliceData->GetTitle(), *projVars, "projBinned");
+  binnedData->add(*sliceData);
+  delete projVars;
+  cout<<" Binned projection data for "<<varName<<": "
+      <<binnedData->numEntries()<<" bins"<<endl;
+  return binnedData;
+}
+
+/// \brief Reduce binned projection data to a category slice
+/// \param binnedData Binned projection data of the full dataset
+/// \param catName Category of the slice
+/// \param catCut Cut defining the slice
+/// \param sliceData Reduced dataset of the slice
+/// \return The binned dataset of the slice, 0 if it cannot be
+///         derived from \p binnedData (then built by #getProjPlot)
+///
+/// This way the events are binned once for all the projection
+/// plots of an obs, the slices only taking their bins.
+/// \p catName has to be binned over, and the grid has to remain
+/// smaller than \p sliceData.
+RooDataHist *rarMLFitter::reduceBinnedProjData(RooDataHist *binnedData,
+                                               TString catName,
+                                               TString catCut,
+                                               RooDataSet *sliceData)
+{
+  if (!binnedData->get()->find(catName)) return 0;
+  RooDataHist *sliceBinned=(RooDataHist*)binnedData->reduce(catCut);
+  if (sliceBinned->numEntries()>=sliceData->numEntries()) {
+    delete sliceBinned;
+    return 0;
+  }
+  return sliceBinned;
+}
+
 /// \brief Combine two RooCurves by a formula
 /// \param crv1 The first RooCurve
 /// \param crv2 The second RooCurve
@@ -3982,6 +4376,10 @@ Double_t rarMLFitter::getUL(RooCurve *curve, Double_t CL)
 /// It then draws a 2D contour plot for specified floating parameters
 /// with number of contour given by config \p nContours in action section,
 /// and finally it returns the frame containing the plot.
+/// \p contourPoints sets the points per contour,
+/// \p contourNumProcs larger than 1 (<=0 for all cores) computes the points
+/// in parallel, and \p contourRefine sets the rounds of adding points
+/// where a contour turns by more than \p contourRefineAngle (deg).
 RooPlot *rarMLFitter::doContourPlot(TList &plotList)
 {
   cout<<endl<<" In rarMLFitter doContourPlot for "<<GetName()<<endl;
@@ -4113,6 +4511,11 @@ RooPlot *rarMLFitter::doContourPlot(TList &plotList)
       <<contX->GetName()<<" vs "<<contY->GetName()<<endl<<endl;
   RooNLLVar nll("nll","nll",*_thePdf, *contourPlotData, kTRUE);
   rarMinuit min(nll);
+  // points per contour, refinement, and worker processes
+  min.setContourPoints(atoi(readConfStr("contourPoints", "25", _runSec)));
+  min.setContourRefine(atoi(readConfStr("contourRefine", "0", _runSec)),
+                       atof(readConfStr("contourRefineAngle", "15", _runSec)));
+  min.setNumProcs(atoi(readConfStr("contourNumProcs", "1", _runSec)));
   if      (nContours<=1) frame = min.contour(*contX, *contY, 1, 0);
   else if (2==nContours) frame = min.contour(*contX, *contY, 1, 2);
   else if (3==nContours) frame = min.contour(*contX, *contY, 1, 2, 3);
@@ -4784,8 +5187,14 @@ RooPlot *rarMLFitter::doSPlot(RooRealVar *theVar, TList &plotList)
 
   // create sPlot obj
   TString sPlotName=Form("sPlot_%s", theVar->GetName());
+  // threads for the sWeight loops (default to useNumCPU)
+  Int_t sPlotNumThreads=atoi(readConfStr("sPlotNumThreads",
+                                         readConfStr("useNumCPU", "1",
+                                                     getMasterSec()),
+                                         _runSec));
   rarSPlot mySPlot(sPlotName, sPlotName, theVar, *sPlotData, fitStat,
-                   pdfsWOvar, yields, pdf0sWOvar, yield0s, projDeps);
+                   pdfsWOvar, yields, pdf0sWOvar, yield0s, projDeps,
+                   kTRUE, sPlotNumThreads);
   // plot comps
   rarStrParser sPlotComps=readConfStr("sPlotComps", "all", _runSec);
   // do we need to have asym plot?
@@ -33,6 +33,7 @@
 
 #include "RooAddPdf.h"
 
+#include "rarFormulaCompiler.hh"
 #include "rarMLFitter.hh"
 #include "rarMLPdf.hh"
 
@@ -323,8 +324,9 @@ void rarMLPdf::init()
 	  createAbsVar(Form("%s %s RooFormulaVar %s %s",
 			    catCoeffTypeName.Data(), catCoeffTypeName.Data(),
 			    cat1FormulaStr.Data(), cat1ArgSet.Data()));
-	// make sure it is RooFormulaVar
-	if ("RooFormulaVar"!=TString(catCoeffType->ClassName())) {
+	// make sure it is RooFormulaVar (or its compiled version)
+	if (("RooFormulaVar"!=TString(catCoeffType->ClassName()))&&
+	    !rarFormulaCompiler::isCompiled(catCoeffType)) {
 	  cout<<catCoeffTypeName<<" is created in config file as "
 	      <<catCoeffType->ClassName()<<","<<endl
 	      <<"but it should be RooFormulaVar"<<endl;
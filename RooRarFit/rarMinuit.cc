@@ -21,6 +21,9 @@
 #include "rarVersion.hh"
 
 #include "Riostream.h"
+#include <cmath>
+#include <map>
+#include <vector>
 #include "TH1.h"
 #include "TH2.h"
 #include "TMarker.h"
@@ -28,6 +31,7 @@
 #include "TStopwatch.h"
 #include "TFitter.h"
 #include "TMinuit.h"
+#include "TMath.h"
 #include "TDirectory.h"
 #include "RooMinuit.h"
 #include "RooArgSet.h"
@@ -36,6 +40,7 @@
 #include "RooRealVar.h"
 #include "RooPlot.h"
 #include "rarMinuit.hh"
+#include "rarParallel.hh"
 
 using namespace std;
 
@@ -54,6 +59,19 @@ rarMinuit::rarMinuit(RooAbsReal& function) : RooMinuit(function)
   }
   _floatParamList->setName("floatParamList") ;
   
+  _nPoints = 25 ;
+  _nRefine = 0 ;
+  _refineAngle = 15 ;
+  _nProcs = 1 ;
+  _bestParams = 0 ;
+  _fMin = _x0 = _y0 = 0 ;
+  _sx = _sy = 1 ;
+}
+
+rarMinuit::~rarMinuit()
+{
+  delete _floatParamList ;
+  delete _bestParams ;
 }
 
 RooPlot* rarMinuit::contour(RooRealVar& var1, RooRealVar& var2,
@@ -82,77 +100,41 @@ RooPlot* rarMinuit::contour(RooRealVar& var1, RooRealVar& var2,
   RooPlot *frame = new RooPlot(var1, var2) ;
   frame->SetStats(kFALSE);
   
-  // draw a point at the current parameter values
-  TMarker *point= new TMarker(var1.getVal(), var2.getVal(), 8);
-  
-  // remember our original value of ERRDEF
-  Double_t errdef= gMinuit->fUp;
-  
-  TGraph* graph1 = 0;
-  if(n1 > 0) {
-    // set the value corresponding to an n1-sigma contour
-    gMinuit->SetErrorDef(n1*n1*errdef);
-    // calculate and draw the contour
-    graph1= (TGraph*)gMinuit->Contour(25, index1, index2);
-    fixGraph(graph1);
+  Double_t levels[6] = {n1, n2, n3, n4, n5, n6} ;
+  TGraph* graphs[6] = {0, 0, 0, 0, 0, 0} ;
+  // independent points (on rays from the minimum) for
+  // parallel or refined contours, MINUIT's MNCONT otherwise
+  Bool_t useRays = (_nProcs != 1) || (_nRefine > 0) ;
+  if (useRays) {
+    migrad() ;
+    hesse() ;
   }
   
-  TGraph* graph2 = 0;
-  if(n2 > 0) {
-    // set the value corresponding to an n2-sigma contour
-    gMinuit->SetErrorDef(n2*n2*errdef);
-    // calculate and draw the contour
-    graph2= (TGraph*)gMinuit->Contour(25, index1, index2);
-    fixGraph(graph2,2);
-  }
-  
-  TGraph* graph3 = 0;
-  if(n3 > 0) {
-    // set the value corresponding to an n3-sigma contour
-    gMinuit->SetErrorDef(n3*n3*errdef);
-    // calculate and draw the contour
-    graph3= (TGraph*)gMinuit->Contour(25, index1, index2);
-    fixGraph(graph3,3);
-  }
-  
-  TGraph* graph4 = 0;
-  if(n4 > 0) {
-    // set the value corresponding to an n4-sigma contour
-    gMinuit->SetErrorDef(n4*n4*errdef);
-    // calculate and draw the contour
-    graph4= (TGraph*)gMinuit->Contour(25, index1, index2);
-    fixGraph(graph4,4);
-  }
-  
-  TGraph* graph5 = 0;
-  if(n5 > 0) {
-    // set the value corresponding to an n5-sigma contour
-    gMinuit->SetErrorDef(n5*n5*errdef);
-    // calculate and draw the contour
-    graph5= (TGraph*)gMinuit->Contour(25, index1, index2);
-    fixGraph(graph5,5);
-  }
+  // draw a point at the current parameter values
+  TMarker *point= new TMarker(var1.getVal(), var2.getVal(), 8);
   
-  TGraph* graph6 = 0;
-  if(n6 > 0) {
-    // set the value corresponding to an n6-sigma contour
-    gMinuit->SetErrorDef(n6*n6*errdef);
-    // calculate and draw the contour
-    graph6= (TGraph*)gMinuit->Contour(25, index1, index2);
-    fixGraph(graph6,6);
+  if (useRays) {
+    rayContours(var1, var2, levels, graphs) ;
+  } else {
+    // remember our original value of ERRDEF
+    Double_t errdef= gMinuit->fUp;
+    for (Int_t l=0; l<6; l++) {
+      if (levels[l] <= 0) continue ;
+      // set the value corresponding to an n-sigma contour
+      gMinuit->SetErrorDef(levels[l]*levels[l]*errdef);
+      // calculate and draw the contour
+      graphs[l]= (TGraph*)gMinuit->Contour(_nPoints, index1, index2);
+    }
+    // restore the original ERRDEF
+    gMinuit->SetErrorDef(errdef);
   }
-  // restore the original ERRDEF
-  gMinuit->SetErrorDef(errdef);
-  
+  for (Int_t l=0; l<6; l++) fixGraph(graphs[l], l+1) ;
   
   // Add all objects to the frame
   frame->addObject(point);
-  if (graph1) frame->addObject(graph1, "C");
-  if (graph2) frame->addObject(graph2, "C");
-  if (graph3) frame->addObject(graph3, "C");
-  if (graph4) frame->addObject(graph4, "C");
-  if (graph5) frame->addObject(graph5, "C");
-  if (graph6) frame->addObject(graph6, "C");
+  for (Int_t l=0; l<6; l++) {
+    if (graphs[l]) frame->addObject(graphs[l], "C");
+  }
   
   return frame;
 }
@@ -171,3 +153,158 @@ void rarMinuit::fixGraph(TGraph *graph, Int_t lineStyle) {
   return;
 }
 
+
+/// \brief Compute contours from independent points on rays
+/// \param var1 The x parameter
+/// \param var2 The y parameter
+/// \param levels The 6 contour levels (in sigma), <=0 for none
+/// \param graphs The 6 graphs returned
+///
+/// Each contour point is found on a ray from the minimum,
+/// in units of the parabolic errors of \p var1 and \p var2,
+/// by minimising with \p var1 and \p var2 fixed on the ray.
+/// All points (of all levels) are independent, so they are computed
+/// in contiguous chunks on forked copies of the minimiser.
+/// Each refinement round adds a point between two neighbours
+/// if the contour turns by more than the refinement angle at either.
+/// The minimum must be found before.
+void rarMinuit::rayContours(RooRealVar& var1, RooRealVar& var2,
+                            const Double_t *levels, TGraph **graphs)
+{
+  _fMin = _func->getVal() ;
+  _x0 = var1.getVal() ;
+  _y0 = var2.getVal() ;
+  _sx = var1.getError() > 0 ? var1.getError() : 1 ;
+  _sy = var2.getError() > 0 ? var2.getError() : 1 ;
+  delete _bestParams ;
+  _bestParams = (RooArgSet*) _floatParamList->snapshot() ;
+  Double_t errdef= gMinuit->fUp;
+  
+  // contour points of each level, ordered by ray angle
+  std::map<Double_t, std::pair<Double_t, Double_t> > points[6] ;
+  // the points to compute
+  std::vector<Int_t> tLevels ;
+  std::vector<Double_t> tAngles ;
+  for (Int_t l=0; l<6; l++) {
+    if (levels[l] <= 0) continue ;
+    for (Int_t i=0; i<_nPoints; i++) {
+      tLevels.push_back(l) ;
+      tAngles.push_back(2*M_PI*i/_nPoints) ;
+    }
+  }
+  
+  var1.setConstant(kTRUE) ;
+  var2.setConstant(kTRUE) ;
+  Int_t printLevel = setPrintLevel(-1) ;
+  setNoWarn() ;
+  for (Int_t round=0; round<=_nRefine; round++) {
+    Int_t nTasks = tLevels.size() ;
+    if (nTasks <= 0) break ;
+    cout << "rarMinuit::contour(" << GetName() << ") "
+         << nTasks << " points with " << rarNThreads(_nProcs)
+         << " process(es)" << endl ;
+    std::vector<Double_t> xy(2*nTasks) ;
+    Bool_t ok = rarForkFor(nTasks, _nProcs, 2, &xy[0],
+                           [&](Int_t first, Int_t last, Double_t *out) {
+                             for (Int_t i=first; i<last; i++) {
+                               Double_t n = levels[tLevels[i]] ;
+                               rayPoint(var1, var2, n*n*errdef, tAngles[i],
+                                        out[2*i], out[2*i+1]) ;
+                             }
+                           }) ;
+    if (!ok) {
+      cout << "rarMinuit::contour(" << GetName()
+           << ") ERROR: contour worker processes failed" << endl ;
+      break ;
+    }
+    for (Int_t i=0; i<nTasks; i++) {
+      points[tLevels[i]][tAngles[i]] = std::make_pair(xy[2*i], xy[2*i+1]) ;
+    }
+    if (round >= _nRefine) break ;
+    // find where the contours turn sharply
+    tLevels.clear() ;
+    tAngles.clear() ;
+    Double_t cosRefine = cos(_refineAngle*M_PI/180) ;
+    for (Int_t l=0; l<6; l++) {
+      Int_t nP = points[l].size() ;
+      if (nP < 3) continue ;
+      std::vector<Double_t> t, u, v ;
+      std::map<Double_t, std::pair<Double_t, Double_t> >::iterator it ;
+      for (it=points[l].begin(); it!=points[l].end(); it++) {
+        t.push_back(it->first) ;
+        u.push_back((it->second.first-_x0)/_sx) ;
+        v.push_back((it->second.second-_y0)/_sy) ;
+      }
+      std::vector<Bool_t> sharp(nP) ;
+      for (Int_t i=0; i<nP; i++) {
+        Int_t p = (i+nP-1)%nP, q = (i+1)%nP ;
+        Double_t ax = u[i]-u[p], ay = v[i]-v[p] ;
+        Double_t bx = u[q]-u[i], by = v[q]-v[i] ;
+        Double_t ab = sqrt((ax*ax+ay*ay)*(bx*bx+by*by)) ;
+        sharp[i] = (ab > 0) && ((ax*bx+ay*by)/ab < cosRefine) ;
+      }
+      for (Int_t i=0; i<nP; i++) {
+        Int_t q = (i+1)%nP ;
+        if (!(sharp[i]||sharp[q])) continue ;
+        Double_t tq = (q > i) ? t[q] : t[q]+2*M_PI ;
+        tLevels.push_back(l) ;
+        tAngles.push_back(fmod((t[i]+tq)/2, 2*M_PI)) ;
+      }
+    }
+  }
+  setPrintLevel(printLevel) ;
+  var1.setConstant(kFALSE) ;
+  var2.setConstant(kFALSE) ;
+  // back to the minimum
+  _floatParamList->assignValueOnly(*_bestParams) ;
+  
+  for (Int_t l=0; l<6; l++) {
+    Int_t nP = points[l].size() ;
+    if (nP <= 0) continue ;
+    graphs[l] = new TGraph(nP) ;
+    Int_t i(0) ;
+    std::map<Double_t, std::pair<Double_t, Double_t> >::iterator it ;
+    for (it=points[l].begin(); it!=points[l].end(); it++, i++) {
+      graphs[l]->SetPoint(i, it->second.first, it->second.second) ;
+    }
+  }
+}
+
+/// \brief Find the contour point on one ray
+/// \param var1 The x parameter (constant)
+/// \param var2 The y parameter (constant)
+/// \param target The function change at the contour
+/// \param theta The ray angle
+/// \param x The x of the point found
+/// \param y The y of the point found
+///
+/// The distance on the ray is updated assuming a parabolic
+/// function change, starting from the minimum each time.
+void rarMinuit::rayPoint(RooRealVar& var1, RooRealVar& var2, Double_t target,
+                         Double_t theta, Double_t &x, Double_t &y)
+{
+  Double_t c = cos(theta), s = sin(theta) ;
+  // stay in the parameter ranges
+  Double_t rMax = 1e30 ;
+  if (c > 0) rMax = TMath::Min(rMax, (var1.getMax()-_x0)/(_sx*c)) ;
+  if (c < 0) rMax = TMath::Min(rMax, (var1.getMin()-_x0)/(_sx*c)) ;
+  if (s > 0) rMax = TMath::Min(rMax, (var2.getMax()-_y0)/(_sy*s)) ;
+  if (s < 0) rMax = TMath::Min(rMax, (var2.getMin()-_y0)/(_sy*s)) ;
+  Double_t r = TMath::Min(sqrt(target/gMinuit->fUp), rMax) ;
+  for (Int_t i=0; i<8; i++) {
+    _floatParamList->assignValueOnly(*_bestParams) ;
+    var1.setVal(_x0+r*_sx*c) ;
+    var2.setVal(_y0+r*_sy*s) ;
+    migrad() ;
+    Double_t d = _func->getVal()-_fMin ;
+    if (fabs(d-target) < 1e-3*target) break ;
+    Double_t rNew = (d > 0) ? r*sqrt(target/d) : 2*r ;
+    if (rNew >= rMax) {
+      if (r >= rMax) break ;
+      rNew = rMax ;
+    }
+    r = rNew ;
+  }
+  x = _x0+r*_sx*c ;
+  y = _y0+r*_sy*s ;
+}
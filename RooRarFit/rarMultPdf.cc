@@ -30,6 +30,7 @@
 #include "RooGlobalFunc.h"
 using namespace RooFit;
 
+#include "rarFormulaCompiler.hh"
 #include "rarMultPdf.hh"
 
 ClassImp(rarMultPdf)
@@ -85,8 +86,9 @@ void rarMultPdf::init()
     format += Form (" * @%d", i);
   }
   
-  _thePdf=new RooGenericPdf(Form("the_%s", GetName()), _pdfType+" "+GetTitle(),
-			    format, _subPdfs);
+  _thePdf=rarFormulaCompiler::createGenericPdf(Form("the_%s", GetName()),
+                                               _pdfType+" "+GetTitle(),
+                                               format, _subPdfs);
   
   
   cout<<"done init of rarMultPdf for "<<GetName()<<endl<<endl;
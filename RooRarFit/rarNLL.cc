@@ -20,6 +20,7 @@
 #include "rarVersion.hh"
 
 #include "Riostream.h"
+#include <algorithm>
 #include <sstream>
 #include <vector>
 using namespace std;
@@ -78,8 +79,8 @@ void rarNLL::init(RooCurve *curve)
 {
   _nPoints=0;
   _nSteps=0;
-  _coeffMList.Delete();
-  _lCoefMList.Delete();
+  _coefs.Set(0);
+  _lCoefs.Set(0);
   
   if (!curve) {
     cout<<" Can not find any NLL curve"<<endl;
@@ -131,6 +132,8 @@ void rarNLL::init(RooCurve *curve)
   _x2s.Set(_nSteps);
   _iLIntegrals.Set(_nSteps);
   _tLIntegrals.Set(_nSteps+1); // The last one is the total integral
+  _coefs.Set(3*_nSteps);
+  _lCoefs.Set(3*_nSteps);
   
   // save points, and minY index
   _mIdx=0;
@@ -163,17 +166,19 @@ void rarNLL::init(RooCurve *curve)
     
     // invert X
     TMatrixD invX=TMatrixD(TMatrixD::kInverted, X);
-    // get coeff matrix
-    TMatrixD *A=new TMatrixD(invX*Y);
-    _coeffMList.Add(A);
-    // coeff matrix in likelihood space
-    TMatrixD *lA=new TMatrixD(invX*lY);
-    _lCoefMList.Add(lA);
+    // get coeffs
+    TMatrixD AM(invX*Y);
+    Double_t *A=&_coefs[3*i];
+    for (Int_t j=0; j<3; j++) A[j]=AM(j,0);
+    // coeffs in likelihood space
+    TMatrixD lAM(invX*lY);
+    Double_t *lA=&_lCoefs[3*i];
+    for (Int_t j=0; j<3; j++) lA[j]=lAM(j,0);
     
     // calculate integral
-    Double_t a=A->operator()(0,0);
-    Double_t b=A->operator()(1,0);
-    Double_t c=A->operator()(2,0);
+    Double_t a=A[0];
+    Double_t b=A[1];
+    Double_t c=A[2];
     // check if a <= 0
     if (a<=0) {
       cout<<" W A R N I N G !"<<endl
@@ -203,11 +208,11 @@ void rarNLL::init(RooCurve *curve)
     const Double_t bignumber = 1e10;
     if (i<=0) x = -bignumber;
     // get lower integral for this step
-    _iLIntegrals[i]=lIntegralFunc(x, *A, *lA);
+    _iLIntegrals[i]=lIntegralFunc(x, A, lA);
     x=_x2s[i];
     if (i>=_nSteps-1) x = bignumber;
     // get integral for this step
-    Double_t thisIntegral=lIntegralFunc(x, *A, *lA)-_iLIntegrals[i];
+    Double_t thisIntegral=lIntegralFunc(x, A, lA)-_iLIntegrals[i];
     if (thisIntegral<0) {
       cout<<" Negative integral="<<thisIntegral
           <<" for i="<<i<<" x0="<<_x0s[i]
@@ -222,10 +227,11 @@ void rarNLL::init(RooCurve *curve)
   if (_verbose) {
     cout<<" rarNLL based on:"<<endl;
     curve->Print("v");
-    _coeffMList.Print();
     cout<<" "<<_nSteps<<" steps for integral calculation:"<<endl;
     for (Int_t i=0; i<_nSteps; i++) {
       cout<<" i="<<i<<"\t x0="<<_x0s[i]
+          <<"\t a="<<_coefs[3*i]<<"\t b="<<_coefs[3*i+1]
+          <<"\t c="<<_coefs[3*i+2]
           <<"\t I="<<_iLIntegrals[i]
           <<"\t T="<<_tLIntegrals[i]
           <<endl;
@@ -257,24 +263,20 @@ Double_t rarNLL::getY(Double_t x)
   Double_t retVal(0);
   if (_nSteps<=0) return retVal;
   // if exact match, return cached value
-  for (Int_t i=0; i<_nPoints; i++) {
-    if (x==_xs[i]) {
-      if (_verbose) cout<<" curve point #"<<i<<" = "<<_ys[i]<<endl;
-      return _ys[i];
-    }
+  Long64_t iP=TMath::BinarySearch(_nPoints, _xs.GetArray(), x);
+  if ((iP>=0)&&(x==_xs[iP])) {
+    if (_verbose) cout<<" curve point #"<<iP<<" = "<<_ys[iP]<<endl;
+    return _ys[iP];
   }
   
-  // first find the bin
-  Int_t i;
-  for (i=0; i<_nSteps; i++) {
-    if (x<=_x2s[i]) break;
-  }
-  if (i<0) i=0;
+  // first find the bin, the first with x<=x2
+  Int_t i=std::lower_bound(_x2s.GetArray(), _x2s.GetArray()+_nSteps, x)
+    -_x2s.GetArray();
   if (i>=_nSteps) i=_nSteps-1;
-  TMatrixD *A=(TMatrixD*)_coeffMList.At(i);
-  Double_t a=A->operator()(0,0);
-  Double_t b=A->operator()(1,0);
-  Double_t c=A->operator()(2,0);
+  const Double_t *A=&_coefs[3*i];
+  Double_t a=A[0];
+  Double_t b=A[1];
+  Double_t c=A[2];
   retVal=a*x*x+b*x+c;
   
   if (_verbose) {
@@ -305,10 +307,10 @@ TArrayD rarNLL::getX(Double_t y)
     if (0==i) x0 = -bignumber;
     Double_t x2=_x2s[i];
     if (_nSteps-1==i) x2 = bignumber;
-    TMatrixD *A=(TMatrixD*)_coeffMList.At(i);
-    Double_t a=A->operator()(0,0);
-    Double_t b=A->operator()(1,0);
-    Double_t c=A->operator()(2,0);
+    const Double_t *A=&_coefs[3*i];
+    Double_t a=A[0];
+    Double_t b=A[1];
+    Double_t c=A[2];
     if ((0==a)&&(0==b)) continue;
     Double_t b24ac=b*b-4*a*(c-y);
     if (0==a) { // for a==0
@@ -450,10 +452,10 @@ void rarNLL::getMin(Double_t &x, Double_t &y)
     Double_t x1=_x1s[i];
     Double_t x2=_x2s[i];
     if (_nSteps-1==i) x2 = bignumber;
-    TMatrixD *A=(TMatrixD*)_coeffMList.At(i);
-    Double_t a=A->operator()(0,0);
-    Double_t b=A->operator()(1,0);
-    Double_t c=A->operator()(2,0);
+    const Double_t *A=&_coefs[3*i];
+    Double_t a=A[0];
+    Double_t b=A[1];
+    Double_t c=A[2];
     if (_verbose)
       cout<<" i="<<i
           <<" x0="<<x0
@@ -487,6 +489,16 @@ TArrayD rarNLL::getMin()
   return xy;
 }
 
+/// \brief Return the step a point falls into
+/// \param x The point
+/// \return The last step with x0<=x (the first step starts at -inf)
+Int_t rarNLL::findStep(Double_t x)
+{
+  Int_t i=std::upper_bound(_x0s.GetArray()+1, _x0s.GetArray()+_nSteps, x)
+    -_x0s.GetArray()-1;
+  return i<0?0:i;
+}
+
 /// \brief Return the likelihood curve integral
 /// \param x The limit for integration
 /// \return The likelihood curve integral
@@ -499,27 +511,20 @@ Double_t rarNLL::getLIntegral(Double_t x)
   if (_nSteps<=0) return retVal;
   
   // first find the bin
-  Int_t i(0);
-  for (i=0; i<_nSteps; i++) {
-    Double_t x0=_x0s[i];
-    if (0==i) x0 = -bignumber;
-    if (x==x0) {
-      if (_verbose)
-	cout<<" i="<<i<<" x="<<x<<" integral="<<_tLIntegrals[i]<<endl;
-      return _tLIntegrals[i];
-    }
-    if (x<x0) break;
-  }
-  // the point falls into the previous bin
-  i--;
-  if (i<0) return 0; // below the lowest point
-  // get x0, a, b, c
+  if (x<-bignumber) return 0; // below the lowest point
+  Int_t i=findStep(x);
   Double_t x0=_x0s[i];
-  TMatrixD *A=(TMatrixD*)_coeffMList.At(i);
-  TMatrixD *lA=(TMatrixD*)_lCoefMList.At(i);
+  if (0==i) x0 = -bignumber;
+  if (x==x0) {
+    if (_verbose)
+      cout<<" i="<<i<<" x="<<x<<" integral="<<_tLIntegrals[i]<<endl;
+    return _tLIntegrals[i];
+  }
+  const Double_t *A=&_coefs[3*i];
+  const Double_t *lA=&_lCoefs[3*i];
   if (_verbose) cout<<" i="<<i<<" x0="<<x0<<endl;
   // get integral for this x, a b c within the bin
-  Double_t thisIntegral=lIntegralFunc(x, *A, *lA)-_iLIntegrals[i];
+  Double_t thisIntegral=lIntegralFunc(x, A, lA)-_iLIntegrals[i];
   retVal=_tLIntegrals[i]+thisIntegral;
   
   if (_verbose)
@@ -566,18 +571,18 @@ Double_t rarNLL::getLIntegralInverse(Double_t xl, Double_t iVal)
   if (iVal<=0) return (-bignumber);
   if (iVal>=_tLIntegrals[_nSteps]) return (bignumber);
   
-  // first identify which step iVal belongs to
-  Int_t i(0);
-  for (i=0; i<_nSteps; i++) {
-    if (iVal<_tLIntegrals[i+1]) break;
-  }
+  // first identify which step iVal belongs to, the first with iVal<T[i+1]
+  Int_t i=std::upper_bound(_tLIntegrals.GetArray()+1,
+                           _tLIntegrals.GetArray()+_nSteps+1, iVal)
+    -(_tLIntegrals.GetArray()+1);
+  if (i>=_nSteps) i=_nSteps-1;
   
   // get x0, a, b, c
   Double_t x0=_x0s[i];
-  TMatrixD *A=(TMatrixD*)_coeffMList.At(i);
-  Double_t a=A->operator()(0,0);
-  Double_t b=A->operator()(1,0);
-  Double_t c=A->operator()(2,0);
+  const Double_t *A=&_coefs[3*i];
+  Double_t a=A[0];
+  Double_t b=A[1];
+  Double_t c=A[2];
   // get iVal's residual within the bin
   Double_t residual=iVal-_tLIntegrals[i];
   if (_verbose) 
@@ -593,7 +598,7 @@ Double_t rarNLL::getLIntegralInverse(Double_t xl, Double_t iVal)
   // identify integral method as in rarNLL::lIntegralFunc().
   // for a=b=0
   if ((0==a)&&(0==b)) {
-    cout<<" Using constant fit"<<endl;
+    if (_verbose) cout<<" Using constant fit"<<endl;
     x=thisXI*exp(c/2.);
   } else if (a>0) { // normal fit
     // get erf value
@@ -605,21 +610,37 @@ Double_t rarNLL::getLIntegralInverse(Double_t xl, Double_t iVal)
       x=(y*sqrt(8*a)-b)/2/a;
     }
   } else if ((0!=b)&&(a>-1e-5)&&(TMath::Abs(a/b)<100)) { // a ~ 0
-    cout<<" Using linear fit"<<endl;
+    if (_verbose) cout<<" Using linear fit"<<endl;
     Double_t thisXExp=-thisXI*b/2.;
     if (thisXExp<=0) {
       cout<<" "<<thisXExp<<" should be >0"<<endl;
     } else {
       x=-(2*TMath::Log(thisXExp)+c)/b;
     }
-  } else { // numerical integral
-    TMatrixD *lA=(TMatrixD*)_lCoefMList.At(i);
-    Double_t la=lA->operator()(0,0);
-    Double_t lb=lA->operator()(1,0);
-    Double_t lc=lA->operator()(2,0);
-    x=lIntegralFuncInverse(_x0s[i], _x2s[i], 10, thisXI, la, lb, lc);
-    cout<<" Using numerical integral: la="<<la<<" lb="<<lb<<" lc="<<lc<<endl
-	<<" x="<<x<<endl;
+  } else { // numerical integral, a cubic in x
+    const Double_t *lA=&_lCoefs[3*i];
+    Double_t la=lA[0];
+    Double_t lb=lA[1];
+    Double_t lc=lA[2];
+    // closed form first, the root within the step
+    Bool_t found(kFALSE);
+    if (0!=la) {
+      Double_t coef[4]={-thisXI, lc, lb/2, la/3};
+      Double_t r[3];
+      Int_t nRoots=TMath::RootsCubic(coef, r[0], r[1], r[2])?1:3;
+      for (Int_t j=0; j<nRoots; j++) {
+        if ((_x0s[i]<=r[j])&&(r[j]<=_x2s[i])) {
+          x=r[j];
+          found=kTRUE;
+          break;
+        }
+      }
+    }
+    if (!found)
+      x=lIntegralFuncInverse(_x0s[i], _x2s[i], 50, thisXI, la, lb, lc);
+    if (_verbose)
+      cout<<" Using numerical integral: la="<<la<<" lb="<<lb<<" lc="<<lc
+          <<endl<<" x="<<x<<endl;
   }
   
   if (_verbose) cout<<" x="<<x<<endl;
@@ -689,28 +710,43 @@ Double_t rarNLL::getLIntegralInverse(Double_t iVal)
 /// http://mathworld.wolfram.com/Erf.html \n
 /// http://mathworld.wolfram.com/Erfi.html
 Double_t rarNLL::lIntegralFunc(Double_t x, TMatrixD &A, TMatrixD &lA)
+{
+  Double_t a[3]={A(0,0), A(1,0), A(2,0)};
+  Double_t la[3]={lA(0,0), lA(1,0), lA(2,0)};
+  return lIntegralFunc(x, a, la);
+}
+
+/// \brief The likelihood curve integral function
+/// \param x x value
+/// \param A Coeffs (a, b, c)
+/// \param lA Coeffs in likelihood space
+///
+/// Same as above with coeffs in plain arrays
+Double_t rarNLL::lIntegralFunc(Double_t x, const Double_t *A,
+                               const Double_t *lA)
 {
   Double_t retVal(0);
-  Double_t a=A(0,0);
-  Double_t b=A(1,0);
-  Double_t c=A(2,0);
+  Double_t a=A[0];
+  Double_t b=A[1];
+  Double_t c=A[2];
   // for a=b=0
   if ((0==a)&&(0==b)) {
-    cout<<" Using constant fit"<<endl;
+    if (_verbose) cout<<" Using constant fit"<<endl;
     retVal=x/exp(c/2.);
   } else if (a>0) { // normal fit
     retVal=sqrt(TMath::Pi()/2/a)*exp((b*b-4*a*c)/8/a)*
       TMath::Erf((b+2*a*x)/sqrt(8*a));
   } else if ((0!=b)&&(a>-1e-5)&&(TMath::Abs(a/b)<100)) { // a ~ 0
-    cout<<" Using linear fit"<<endl;
+    if (_verbose) cout<<" Using linear fit"<<endl;
     retVal=-2/b*exp((-b*x-c)/2.);
   } else { // numerical integral
-    Double_t la=lA(0,0);
-    Double_t lb=lA(1,0);
-    Double_t lc=lA(2,0);
+    Double_t la=lA[0];
+    Double_t lb=lA[1];
+    Double_t lc=lA[2];
     retVal=la/3*x*x*x+lb/2*x*x+lc*x;
-    cout<<" Using numerical integral: la="<<la<<" lb="<<lb<<" lc="<<lc<<endl
-	<<" x="<<x<<" retV:"<<retVal<<endl;
+    if (_verbose)
+      cout<<" Using numerical integral: la="<<la<<" lb="<<lb<<" lc="<<lc
+          <<endl<<" x="<<x<<" retV:"<<retVal<<endl;
   }
   const Double_t bignumber = 1e200;
   if (retVal>bignumber)  { retVal = bignumber; }
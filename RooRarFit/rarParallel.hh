@@ -0,0 +1,149 @@
+/*****************************************************************************
+ * Project: BaBar detector at the SLAC PEP-II B-factory
+ * Package: RooRarFit
+ *    File: $Id: rarParallel.hh,v 1.1 $
+ * Authors:
+ * History:
+ *
+ * Copyright (C) 2005-2012 University of California, Riverside
+ *****************************************************************************/
+#ifndef RAR_PARALLEL
+#define RAR_PARALLEL
+
+// Internal helper, only to be included by .cc files
+// (keep std::thread and fork out of the headers seen by rootcint).
+
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "Rtypes.h"
+
+/// \brief Resolve the number of worker threads to use
+/// \param nThreads Requested number of threads, <=0 means all cores
+/// \return Number of threads, at least 1
+inline Int_t rarNThreads(Int_t nThreads)
+{
+  if (nThreads<=0) nThreads=std::thread::hardware_concurrency();
+  if (nThreads<=0) nThreads=1;
+  return nThreads;
+}
+
+/// \brief Run a loop over [0, n) in contiguous chunks on several threads
+/// \param n Loop length
+/// \param nThreads Number of threads (see #rarNThreads)
+/// \param func Functor called as func(first, last, iThread)
+/// \return Number of chunks (threads) actually used
+///
+/// The functor must only touch plain arrays (no RooFit objects),
+/// and writes must go to disjoint indices or per-iThread slots.
+template<class F>
+Int_t rarParallelFor(Int_t n, Int_t nThreads, F func)
+{
+  nThreads=rarNThreads(nThreads);
+  if (nThreads>n) nThreads=n;
+  if (nThreads<=1) {
+    if (n>0) func(0, n, 0);
+    return 1;
+  }
+  Int_t chunk=(n+nThreads-1)/nThreads;
+  std::vector<std::thread> workers;
+  for (Int_t t=0; t<nThreads; t++) {
+    Int_t first=t*chunk;
+    Int_t last=first+chunk;
+    if (last>n) last=n;
+    if (first>=last) break;
+    workers.push_back(std::thread(func, first, last, t));
+  }
+  for (UInt_t t=0; t<workers.size(); t++) workers[t].join();
+  return workers.size();
+}
+
+/// \brief Run a loop over [0, n) in contiguous chunks in forked processes
+/// \param n Loop length
+/// \param nProcs Number of processes (see #rarNThreads)
+/// \param nOut Number of doubles written per iteration
+/// \param out Output array of n*nOut doubles
+/// \param func Functor called as func(first, last, out)
+/// \return kTRUE if all chunks succeeded
+///
+/// Unlike #rarParallelFor, the functor may use RooFit objects,
+/// since each chunk runs in its own copy of the process.
+/// It must write its results to out[first*nOut, last*nOut),
+/// which are sent back to the parent through a pipe.
+template<class F>
+Bool_t rarForkFor(Int_t n, Int_t nProcs, Int_t nOut, Double_t *out, F func)
+{
+  nProcs=rarNThreads(nProcs);
+  if (nProcs>n) nProcs=n;
+  if (nProcs<=1) {
+    if (n>0) func(0, n, out);
+    return kTRUE;
+  }
+  Int_t chunk=(n+nProcs-1)/nProcs;
+  std::vector<pid_t> pids;
+  std::vector<Int_t> fds, firsts, lasts;
+  std::cout.flush();
+  fflush(stdout);
+  for (Int_t p=0; p<nProcs; p++) {
+    Int_t first=p*chunk;
+    Int_t last=first+chunk;
+    if (last>n) last=n;
+    if (first>=last) break;
+    Int_t fd[2];
+    if (pipe(fd)) break;
+    pid_t pid=fork();
+    if (pid<0) {
+      close(fd[0]);
+      close(fd[1]);
+      break;
+    }
+    if (0==pid) { // worker
+      close(fd[0]);
+      func(first, last, out);
+      const char *buf=(const char*)(out+first*nOut);
+      size_t nBytes=(last-first)*nOut*sizeof(Double_t);
+      while (nBytes>0) {
+        ssize_t nw=write(fd[1], buf, nBytes);
+        if (nw<=0) break;
+        buf+=nw;
+        nBytes-=nw;
+      }
+      close(fd[1]);
+      std::cout.flush();
+      fflush(stdout);
+      _exit(nBytes>0?1:0);
+    }
+    close(fd[1]);
+    pids.push_back(pid);
+    fds.push_back(fd[0]);
+    firsts.push_back(first);
+    lasts.push_back(last);
+  }
+  // read back while the workers write, then reap them
+  // (if no fork succeeded, all the loop is done inline below)
+  Bool_t ok(kTRUE);
+  for (UInt_t p=0; p<pids.size(); p++) {
+    char *buf=(char*)(out+firsts[p]*nOut);
+    size_t nBytes=(lasts[p]-firsts[p])*nOut*sizeof(Double_t);
+    while (nBytes>0) {
+      ssize_t nr=read(fds[p], buf, nBytes);
+      if (nr<=0) break;
+      buf+=nr;
+      nBytes-=nr;
+    }
+    close(fds[p]);
+    Int_t status(0);
+    waitpid(pids[p], &status, 0);
+    if ((nBytes>0)||!WIFEXITED(status)||WEXITSTATUS(status)) ok=kFALSE;
+  }
+  // chunks not started are done here
+  Int_t done=pids.size()>0?lasts.back():0;
+  if (done<n) func(done, n, out);
+  return ok;
+}
+
+#endif
@@ -20,6 +20,7 @@
 #include "rarVersion.hh"
 
 #include "rarSPlot.hh"
+#include "rarParallel.hh"
 #include "RooAbsPdf.h"
 
 #include "TMatrixD.h"
@@ -35,7 +36,7 @@ rarSPlot::rarSPlot() :
   TNamed(),
   _obs(0), _fitRes(0),
   _nComps(0), _nComp0s(0), _idxMap(0), _covM(0,0), _iV(0,0), _V(0,0),
-  _sHist(0), _sData(0),
+  _nThreads(1), _sHist(0), _sData(0),
   _verbose(kFALSE)
 {
   // Default constructor
@@ -53,6 +54,7 @@ rarSPlot::rarSPlot() :
 /// \param yield0s The fixed component yields
 /// \param projDeps Obs to be ignored for normalization
 /// \param verbose Boolean to control debug output
+/// \param nThreads Number of threads for the sWeight loops
 ///
 /// Default ctor to set several common data members,
 /// and then call #init.
@@ -60,14 +62,15 @@ rarSPlot::rarSPlot(const char* name, const char *title, RooAbsReal *obs,
                    RooDataSet &data, RooFitResult *fitRes,
                    const RooArgList &pdfs, const RooArgList &yields,
                    const RooArgList &pdf0s, const RooArgList &yield0s,
-                   const RooArgSet &projDeps, const Bool_t verbose) :
+                   const RooArgSet &projDeps, const Bool_t verbose,
+                   const Int_t nThreads) :
   TNamed(name, title),
   _obs(obs), _data(data), _nEvts(_data.numEntries()),
   _fitRes(fitRes), _fitPars(fitRes->floatParsFinal()),
   _pdfs(pdfs), _yields(yields), _pdf0s(pdf0s), _yield0s(yield0s),
   _projDeps(projDeps), _normVars(*pdfs[0].getDependents(&data)),
   _nComps(0), _nComp0s(0), _idxMap(0), _covM(0,0), _iV(0,0), _V(0,0),
-  _sHist(0), _sData(0),
+  _nThreads(nThreads), _sHist(0), _sData(0),
   _verbose(verbose)
 {
   init();
@@ -216,31 +219,38 @@ void rarSPlot::init()
     _iV.Print();
   }
   
+  // evaluate all component pdfs once over the dataset
+  tabulatePdfs();
+  
+  // yields are constant over the event loops
+  TArrayD yieldVals(_nComps), yield0Vals(_nComp0s);
+  for (Int_t k=0; k<_nComps; k++)
+    yieldVals[k]=((RooAbsReal*)_yields.at(_idxMap[k]))->getVal();
+  for (Int_t k=0; k<_nComp0s; k++)
+    yield0Vals[k]=((RooAbsReal*)_yield0s.at(k))->getVal();
+  
   // calculate all denominators
   _dens.Set(_nEvts);
-  cout<<" calculate denominators ";
-  for (Int_t ievt=0; ievt<_nEvts; ievt++) {
-    if (_verbose&&ievt%1000==0) {
-      cout << ".";
-      cout.flush();
-    }
-    _data.get(ievt);
-    _dens[ievt]=0;
-    for (Int_t k=0; k<_nComps; k++) {
-      _dens[ievt]+=((RooAbsReal*)_yields.at(_idxMap[k]))->getVal()*
-	((RooAbsPdf*)_pdfs.at(_idxMap[k]))->getVal(&_normVars);
-      if (0==((RooAbsPdf*)_pdfs.at(_idxMap[k]))->getVal(&_normVars)) {
-        _data.get(ievt);
-        _dens[ievt]+=((RooAbsReal*)_yields.at(_idxMap[k]))->getVal()*
-          ((RooAbsPdf*)_pdfs.at(_idxMap[k]))->getVal(&_normVars);
+  cout<<" calculate denominators"<<endl;
+  {
+    const Int_t nEvts(_nEvts), nComps(_nComps), nComp0s(_nComp0s);
+    const Int_t *idxMap=_idxMap.GetArray();
+    const Double_t *pdfVals=_pdfVals.GetArray();
+    const Double_t *pdf0Vals=_pdf0Vals.GetArray();
+    const Double_t *yv=yieldVals.GetArray();
+    const Double_t *y0v=yield0Vals.GetArray();
+    Double_t *dens=_dens.GetArray();
+    rarParallelFor(nEvts, _nThreads, [=](Int_t first, Int_t last, Int_t) {
+      for (Int_t ievt=first; ievt<last; ievt++) {
+        Double_t den(0);
+        for (Int_t k=0; k<nComps; k++)
+          den+=yv[k]*pdfVals[idxMap[k]*nEvts+ievt];
+        for (Int_t k=0; k<nComp0s; k++)
+          den+=y0v[k]*pdf0Vals[k*nEvts+ievt];
+        dens[ievt]=den;
       }
-    }
-    for (Int_t k=0; k<_nComp0s; k++) {
-      _dens[ievt]+=((RooAbsReal*)_yield0s.at(k))->getVal()*
-	((RooAbsPdf*)_pdf0s.at(k))->getVal(&_normVars);
-    }
+    });
   }
-  cout<<endl;
   
   // init _sPns
   _sPns.Set((_nComps+1)*_nEvts);
@@ -248,17 +258,31 @@ void rarSPlot::init()
   _sPnb.Reset();
   
   if (_nComp0s>0) {
-    // now using eqn 15 in BAD 509 to calculate #_iV
+    // now using eqn 15 in BAD 509 to calculate #_iV,
+    // with one partial sum matrix per thread
+    const Int_t nEvts(_nEvts), nComps(_nComps);
+    const Int_t nThreads=rarNThreads(_nThreads);
+    const Int_t *idxMap=_idxMap.GetArray();
+    const Double_t *pdfVals=_pdfVals.GetArray();
+    const Double_t *dens=_dens.GetArray();
+    TArrayD partSums(nThreads*nComps*nComps);
+    Double_t *ps=partSums.GetArray();
+    Int_t nChunks=
+      rarParallelFor(nEvts, nThreads, [=](Int_t first, Int_t last, Int_t t) {
+        Double_t *sums=ps+t*nComps*nComps;
+        for (Int_t ievt=first; ievt<last; ievt++) {
+          Double_t iden2=1./dens[ievt]/dens[ievt];
+          for (Int_t i=0; i<nComps; i++) {
+            Double_t fi=pdfVals[idxMap[i]*nEvts+ievt]*iden2;
+            for (Int_t j=i; j<nComps; j++)
+              sums[i*nComps+j]+=fi*pdfVals[idxMap[j]*nEvts+ievt];
+          }
+        }
+      });
     for (Int_t i=0; i<_nComps; i++) {
-      RooAbsPdf *fi=(RooAbsPdf*)_pdfs.at(_idxMap[i]);
       for (Int_t j=i; j<_nComps; j++) {
-	RooAbsPdf *fj=(RooAbsPdf*)_pdfs.at(_idxMap[j]);
 	Double_t iVij(0);
-	for(Int_t ievt=0; ievt<_nEvts; ievt++) {
-	  _data.get(ievt);
-	  iVij+=fi->getVal(&_normVars)*fj->getVal(&_normVars)
-	    /_dens[ievt]/_dens[ievt];
-	}
+        for (Int_t t=0; t<nChunks; t++) iVij+=ps[(t*nComps+i)*nComps+j];
 	_iV(i,j)=iVij;
       }
     }
@@ -282,6 +306,40 @@ void rarSPlot::init()
   }
 }
 
+/// \brief Evaluate all component pdfs over the dataset
+///
+/// It loops once over the dataset and stores the normalized value of
+/// every pdf in #_pdfs and #_pdf0s for every event in #_pdfVals and
+/// #_pdf0Vals, so that the sWeight loops only work on plain arrays
+/// (and can be run in parallel) instead of going through RooFit.
+void rarSPlot::tabulatePdfs()
+{
+  _pdfVals.Set(_nComps*_nEvts);
+  _pdf0Vals.Set(_nComp0s*_nEvts);
+  cout<<" evaluate component pdfs ";
+  for (Int_t ievt=0; ievt<_nEvts; ievt++) {
+    if (_verbose&&ievt%1000==0) {
+      cout << ".";
+      cout.flush();
+    }
+    _data.get(ievt);
+    for (Int_t k=0; k<_nComps; k++) {
+      RooAbsPdf *pdf=(RooAbsPdf*)_pdfs.at(k);
+      Double_t val=pdf->getVal(&_normVars);
+      if (0==val) {
+        _data.get(ievt);
+        val=pdf->getVal(&_normVars);
+      }
+      _pdfVals[k*_nEvts+ievt]=val;
+    }
+    for (Int_t k=0; k<_nComp0s; k++) {
+      _pdf0Vals[k*_nEvts+ievt]=
+        ((RooAbsPdf*)_pdf0s.at(k))->getVal(&_normVars);
+    }
+  }
+  cout<<endl;
+}
+
 /// \brief Fill sPn array
 /// \param compIdx Component index
 void rarSPlot::fillsPn(Int_t compIdx)
@@ -292,42 +350,42 @@ void rarSPlot::fillsPn(Int_t compIdx)
   }
   // check if done already
   if (_sPnb[compIdx]) return;
+  const Int_t nEvts(_nEvts), nComps(_nComps);
+  Double_t *sPn=_sPns.GetArray()+compIdx*nEvts;
   if (compIdx==_nComps) {
     // fill sPn's
     for (Int_t i=0; i<_nComps; i++) {
       fillsPn(i);
     }
     // fill sP0
-    cout<<" fill sP0 ";
-    for (Int_t i=0; i<_nEvts; i++) {
-      if (_verbose&&i%1000==0) {
-        cout << ".";
-        cout.flush();
-      }
-      _sPns[compIdx*_nEvts+i]=1;
-      for (Int_t j=0; j<_nComps; j++) {
-	_sPns[compIdx*_nEvts+i]-=_sPns[j*_nEvts+i];
+    cout<<" fill sP0"<<endl;
+    const Double_t *sPns=_sPns.GetArray();
+    rarParallelFor(nEvts, _nThreads, [=](Int_t first, Int_t last, Int_t) {
+      for (Int_t i=first; i<last; i++) {
+        Double_t sP0=1;
+        for (Int_t j=0; j<nComps; j++) sP0-=sPns[j*nEvts+i];
+        sPn[i]=sP0;
       }
-    }
+    });
   } else {
     // fill sPn
     cout<<" fill sPn for fitPar #"<<compIdx
-        <<" "<<_fitPars[compIdx].GetName()<<" ";
-    for (Int_t i=0; i<_nEvts; i++) {
-      if (_verbose&&i%1000==0) {
-        cout << ".";
-        cout.flush();
-      }
-      _data.get(i);
-      Double_t numerator=0.;
-      for (Int_t j=0; j<_nComps; j++) {
-        numerator+=_V(compIdx,j)*
-          ((RooAbsPdf*)_pdfs.at(_idxMap[j]))->getVal(&_normVars);
+        <<" "<<_fitPars[compIdx].GetName()<<endl;
+    TArrayD Vrow(_nComps);
+    for (Int_t j=0; j<_nComps; j++) Vrow[j]=_V(compIdx,j);
+    const Double_t *vr=Vrow.GetArray();
+    const Int_t *idxMap=_idxMap.GetArray();
+    const Double_t *pdfVals=_pdfVals.GetArray();
+    const Double_t *dens=_dens.GetArray();
+    rarParallelFor(nEvts, _nThreads, [=](Int_t first, Int_t last, Int_t) {
+      for (Int_t i=first; i<last; i++) {
+        Double_t numerator=0.;
+        for (Int_t j=0; j<nComps; j++)
+          numerator+=vr[j]*pdfVals[idxMap[j]*nEvts+i];
+        sPn[i]=numerator/dens[i];
       }
-      _sPns[compIdx*_nEvts+i]=numerator/_dens[i];
-    }
+    });
   }
-  cout<<endl;
   
   _sPnb[compIdx]=1;
   return;
@@ -401,27 +459,32 @@ RooDataSet* rarSPlot::fill(RooAbsReal &yield, Int_t nbins,
   if (_nComp0s>0) cout<<" Nratio = "<<Nratio<<" \tNratio2 = "<<Nratio2<<endl;
   cout<<" loop over dataset to fill sPlot ";
   //_data.write("/tmp/sd.txt");
+  // the dataset always hands back the same row object,
+  // so look up the obs once and stream through the events
+  const Double_t *sPn=_sPns.GetArray()+istar*_nEvts;
+  const Double_t *sP0=_sPns.GetArray()+_nComps*_nEvts;
+  const Double_t *pdfVals=_pdfVals.GetArray()+istar*_nEvts;
+  const RooArgSet *row=_data.get();
+  RooAbsReal *rowObs=(RooAbsReal*)row->find(_obs->GetName());
   for (Int_t ievt=0; ievt<_nEvts; ievt++) {
     if (_verbose&&ievt%1000==0) {
       cout << ".";
       cout.flush();
     }
     // Read this event and find the value of x for this event.
-    const RooArgSet *row=_data.get(ievt);
-    Double_t obsVal = ((RooAbsReal*)row->find(_obs->GetName()))->getVal();
-    Double_t p=1/Nstar*_sPns[istar*_nEvts+ievt];
-    if (_nComp0s>0) {
-      p=1/Nstar*(_sPns[istar*_nEvts+ievt]+Nratio*_sPns[_nComps*_nEvts+ievt]);
-    }
-    sumtmp += ((RooAbsPdf*)_pdfs.at(istar))->getVal(&_normVars)/_dens[ievt];
+    _data.get(ievt);
+    Double_t obsVal = rowObs->getVal();
+    Double_t wgt=sPn[ievt];
+    if (_nComp0s>0) wgt+=Nratio*sP0[ievt];
+    sumtmp += pdfVals[ievt]/_dens[ievt];
     
     //if (obsVal > min && obsVal < max)
-    sum += p*Nstar;
+    sum += wgt;
     
     // Add weighted event to the sPlot histogram
-    _sHist->Fill(obsVal, p*Nstar);
+    _sHist->Fill(obsVal, wgt);
     // ... and to the dataSet
-    _sData->add(*row, p*Nstar);
+    _sData->add(*row, wgt);
     
   }// end event loop
   cout<<endl;
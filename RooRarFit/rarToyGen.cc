@@ -0,0 +1,437 @@
+/*****************************************************************************
+* Project: BaBar detector at the SLAC PEP-II B-factory
+* Package: RooRarFit
+ *    File: $Id: rarToyGen.cc,v 1.1 $
+ * Authors:
+ * History:
+ *
+ * Copyright (C) 2005-2012, University of California, Riverside
+ *****************************************************************************/
+
+// -- CLASS DESCRIPTION [RooRarFit] --
+// This class provides toy generator class for RooRarFit
+//////////////////////////////////////////////////////
+//
+// BEGIN_HTML
+// This class provides toy generator class for RooRarFit
+// END_HTML
+//
+
+#include "rarVersion.hh"
+
+#include "Riostream.h"
+#include <algorithm>
+#include <map>
+#include <string>
+
+#include "TMath.h"
+#include "TRandom3.h"
+
+#include "RooAbsCategoryLValue.h"
+#include "RooAbsPdf.h"
+#include "RooAddPdf.h"
+#include "RooCatType.h"
+#include "RooDataSet.h"
+#include "RooProdPdf.h"
+#include "RooRandom.h"
+#include "RooRealVar.h"
+#include "RooSimultaneous.h"
+
+#include "rarParallel.hh"
+#include "rarToyGen.hh"
+
+using std::cout;
+using std::endl;
+using std::vector;
+
+ClassImp(rarToyGen)
+  ;
+
+/// \brief CDF table of a 1D pdf
+struct rarToyGenTable {
+  Double_t min; ///< Lower edge
+  Double_t max; ///< Upper edge
+  vector<Double_t> cdf; ///< Cumulative sums at bin edges
+};
+
+// tables kept across toys, and their keys
+static vector<rarToyGenTable> rarToyGenTables;
+static std::map<std::string, Int_t> rarToyGenTableIdx;
+
+// events drawn from one random number stream
+static const Int_t rarToyGenBlockSize=10000;
+
+/// \brief Draw a value from a CDF table
+static inline Double_t rarToyGenDraw(const rarToyGenTable &table, Double_t u)
+{
+  const vector<Double_t> &cdf=table.cdf;
+  Int_t nBins=cdf.size()-1;
+  Double_t y=u*cdf[nBins];
+  Int_t k=std::upper_bound(cdf.begin(), cdf.end(), y)-cdf.begin()-1;
+  if (k<0) k=0;
+  if (k>=nBins) k=nBins-1;
+  Double_t dc=cdf[k+1]-cdf[k];
+  Double_t f=(dc>0)?(y-cdf[k])/dc:.5;
+  return table.min+(k+f)*(table.max-table.min)/nBins;
+}
+
+/// \brief Pick an index from cumulative weights
+static inline Int_t rarToyGenPick(const Double_t *cum, Int_t n, Double_t u)
+{
+  Int_t k=std::upper_bound(cum, cum+n, u*cum[n-1])-cum;
+  return (k<n)?k:n-1;
+}
+
+/// \brief Default ctor
+/// \param nBins Bins of each CDF table
+/// \param nThreads Threads for event generation (<=0 for all cores)
+rarToyGen::rarToyGen(Int_t nBins, Int_t nThreads)
+  : TObject(), _nBins(nBins), _nThreads(nThreads), _simCat(0), _protData(0)
+{
+  if (_nBins<10) _nBins=10;
+}
+
+rarToyGen::~rarToyGen()
+{
+}
+
+/// \brief Drop all cached CDF tables
+void rarToyGen::clearCache()
+{
+  rarToyGenTables.clear();
+  rarToyGenTableIdx.clear();
+}
+
+/// \brief Prepare to generate from a pdf
+/// \param gen The generator pdf
+/// \param genVars Observables to generate
+/// \param protData Prototype dataset, if any
+/// \return kTRUE if the generator can be used
+///
+/// It finds the categories (slots) of a simultaneous generator,
+/// flattens each slot pdf into weighted products of 1D pdfs (leaves),
+/// and gets the CDF table of each 1D pdf.
+/// As for RooFit, obs a leaf does not depend on are generated flat.
+Bool_t rarToyGen::prepare(RooAbsPdf *gen, const RooArgSet &genVars,
+                          RooDataSet *protData)
+{
+  _obsList.removeAll();
+  _allObs.removeAll();
+  _rowVars.removeAll();
+  _simCat=0;
+  _protData=protData;
+  _catIdx.clear();
+  _slotCum.clear();
+  _protSlot.clear();
+  _leafBegin.clear();
+  _leafCum.clear();
+  _leafTables.clear();
+
+  // real obs, and cats which can only come from the sim index cat
+  RooArgSet genCats;
+  TIterator *iter=genVars.createIterator();
+  RooAbsArg *theArg(0);
+  while(theArg=(RooAbsArg*)iter->Next()) {
+    if (dynamic_cast<RooRealVar*>(theArg)) _obsList.add(*theArg);
+    else if (dynamic_cast<RooAbsCategory*>(theArg)) genCats.add(*theArg);
+    else {
+      delete iter;
+      return kFALSE;
+    }
+  }
+  delete iter;
+  _allObs.add(_obsList);
+  _rowVars.add(_obsList);
+  if (_protData) {
+    _allObs.add(*_protData->get(), kTRUE);
+    _rowVars.add(*_protData->get(), kTRUE);
+  }
+
+  RooSimultaneous *simGen=dynamic_cast<RooSimultaneous*>(gen);
+  if (!simGen) {
+    if (genCats.getSize()>0) return kFALSE;
+    _catIdx.push_back(0);
+    _slotCum.push_back(1);
+    _leafBegin.push_back(0);
+    if (!addLeaves(gen, 1)) return kFALSE;
+  } else {
+    _simCat=(RooAbsCategoryLValue*)&simGen->indexCat();
+    RooArgSet *simCatVars=_simCat->getVariables();
+    // do the prototype events fix the category?
+    Bool_t catFromProt(kFALSE);
+    if (_protData) {
+      RooArgSet *protCats=(RooArgSet*)
+        simCatVars->selectCommon(*_protData->get());
+      if (protCats->getSize()==simCatVars->getSize()) catFromProt=kTRUE;
+      else if (protCats->getSize()>0) {
+        delete protCats;
+        delete simCatVars;
+        return kFALSE;
+      }
+      delete protCats;
+    }
+    if (!catFromProt) {
+      _allObs.add(*simCatVars, kTRUE);
+      _rowVars.add(*simCatVars, kTRUE);
+    }
+    genCats.remove(*simCatVars, kTRUE, kTRUE);
+    delete simCatVars;
+    if (genCats.getSize()>0) return kFALSE;
+    Double_t cum(0);
+    std::map<Int_t, Int_t> slotOfCat;
+    TIterator *catIter=_simCat->typeIterator();
+    RooCatType *theType(0);
+    while(theType=(RooCatType*)catIter->Next()) {
+      RooAbsPdf *catPdf=simGen->getPdf(theType->GetName());
+      Double_t weight(0);
+      if (catPdf&&!catFromProt) {
+        if (!catPdf->canBeExtended()) {
+          delete catIter;
+          return kFALSE;
+        }
+        weight=catPdf->expectedEvents(_allObs);
+      }
+      slotOfCat[theType->getVal()]=_catIdx.size();
+      _catIdx.push_back(theType->getVal());
+      cum+=weight;
+      _slotCum.push_back(cum);
+      _leafBegin.push_back(_leafCum.size());
+      // leaves are only needed for slots which get events
+      if (catPdf&&(catFromProt||(weight>0))&&!addLeaves(catPdf, 1)) {
+        delete catIter;
+        return kFALSE;
+      }
+    }
+    delete catIter;
+    if (catFromProt) {
+      // slot of each prototype event
+      RooAbsCategory *protCat=(RooAbsCategory*)_simCat->cloneTree();
+      protCat->attachDataSet(*_protData);
+      Int_t nProt=_protData->numEntries();
+      _protSlot.resize(nProt);
+      for (Int_t i=0; i<nProt; i++) {
+        _protData->get(i);
+        _protSlot[i]=slotOfCat[protCat->getIndex()];
+      }
+      delete protCat;
+    } else if (cum<=0) return kFALSE;
+  }
+  _leafBegin.push_back(_leafCum.size());
+  // slots which get events need leaves
+  Int_t nSlots=_catIdx.size();
+  for (Int_t s=0; s<nSlots; s++) {
+    Bool_t used=_protSlot.size()>0?
+      (std::find(_protSlot.begin(), _protSlot.end(), s)!=_protSlot.end()):
+      (_slotCum[s]>(s>0?_slotCum[s-1]:0));
+    if (used&&(_leafBegin[s+1]<=_leafBegin[s])) return kFALSE;
+  }
+  // leaf weights to cumulative within each slot
+  for (Int_t s=0; s<nSlots; s++) {
+    Double_t cum(0);
+    for (Int_t l=_leafBegin[s]; l<_leafBegin[s+1]; l++) {
+      cum+=_leafCum[l];
+      _leafCum[l]=cum;
+    }
+  }
+  return kTRUE;
+}
+
+/// \brief Add the leaves of a slot pdf
+/// \param pdf The pdf
+/// \param weight Weight of the pdf in its slot
+/// \return kFALSE if the pdf can not be flattened
+Bool_t rarToyGen::addLeaves(RooAbsPdf *pdf, Double_t weight)
+{
+  RooArgSet *pdfObs=pdf->getObservables(_allObs);
+  Int_t nPdfObs=pdfObs->getSize();
+  delete pdfObs;
+  RooAddPdf *addPdf=dynamic_cast<RooAddPdf*>(pdf);
+  if ((nPdfObs>1)&&addPdf) {
+    RooArgList pdfList(addPdf->pdfList());
+    RooArgList coefList(addPdf->coefList());
+    Int_t nPdfs=pdfList.getSize();
+    Int_t nCoefs=coefList.getSize();
+    if ((nCoefs!=nPdfs)&&(nCoefs!=nPdfs-1)) return kFALSE;
+    vector<Double_t> fracs(nPdfs);
+    Double_t sum(0);
+    for (Int_t i=0; i<nCoefs; i++) {
+      fracs[i]=((RooAbsReal&)coefList[i]).getVal();
+      if (fracs[i]<0) return kFALSE;
+      sum+=fracs[i];
+    }
+    if (nCoefs<nPdfs) { // fractions
+      fracs[nPdfs-1]=1-sum;
+      if (fracs[nPdfs-1]<0) return kFALSE;
+      sum=1;
+    }
+    if (sum<=0) return kFALSE;
+    for (Int_t i=0; i<nPdfs; i++) {
+      if (fracs[i]<=0) continue;
+      if (!addLeaves((RooAbsPdf*)pdfList.at(i), weight*fracs[i]/sum))
+        return kFALSE;
+    }
+    return kTRUE;
+  }
+  // one product of 1D pdfs
+  Int_t nObs=_obsList.getSize();
+  vector<Int_t> tables(nObs, -1);
+  if (!addFactors(pdf, tables)) return kFALSE;
+  _leafCum.push_back(weight);
+  _leafTables.insert(_leafTables.end(), tables.begin(), tables.end());
+  return kTRUE;
+}
+
+/// \brief Add the 1D factors of a product pdf to a leaf
+/// \param pdf The pdf
+/// \param tables Table of each obs of the leaf
+/// \return kFALSE if the pdf does not factorize into 1D pdfs
+Bool_t rarToyGen::addFactors(RooAbsPdf *pdf, vector<Int_t> &tables)
+{
+  RooArgSet *pdfObs=pdf->getObservables(_allObs);
+  Int_t nPdfObs=pdfObs->getSize();
+  RooAbsArg *theObs=nPdfObs>0?pdfObs->first():0;
+  delete pdfObs;
+  if (nPdfObs<=0) return kTRUE; // constant factor
+  if (1==nPdfObs) {
+    Int_t idx=_obsList.index(_obsList.find(theObs->GetName()));
+    if ((idx<0)||(tables[idx]>=0)) return kFALSE;
+    tables[idx]=getTable(pdf, (RooRealVar*)theObs);
+    return kTRUE;
+  }
+  RooProdPdf *prodPdf=dynamic_cast<RooProdPdf*>(pdf);
+  if (!prodPdf) return kFALSE;
+  RooArgList pdfList(prodPdf->pdfList());
+  for (Int_t i=0; i<pdfList.getSize(); i++) {
+    if (!addFactors((RooAbsPdf*)pdfList.at(i), tables)) return kFALSE;
+  }
+  return kTRUE;
+}
+
+/// \brief Get the CDF table of a 1D pdf
+/// \param pdf The pdf
+/// \param obs Its observable
+/// \return Index of the table in the cache
+///
+/// The table is looked up by pdf, obs, range, bins and parameter values,
+/// and only computed if not found.
+Int_t rarToyGen::getTable(RooAbsPdf *pdf, RooRealVar *obs)
+{
+  TString key=Form("%s|%s|%d|%.17g|%.17g", pdf->GetName(), obs->GetName(),
+                   _nBins, obs->getMin(), obs->getMax());
+  RooArgSet *params=pdf->getParameters(RooArgSet(*obs));
+  TIterator *iter=params->createIterator();
+  RooAbsArg *theParam(0);
+  while(theParam=(RooAbsArg*)iter->Next()) {
+    RooAbsReal *theReal=dynamic_cast<RooAbsReal*>(theParam);
+    RooAbsCategory *theCat=dynamic_cast<RooAbsCategory*>(theParam);
+    if (theReal) key+=Form("|%.17g", theReal->getVal());
+    else if (theCat) key+=Form("|%d", theCat->getIndex());
+  }
+  delete iter;
+  delete params;
+  std::map<std::string, Int_t>::iterator it=
+    rarToyGenTableIdx.find(key.Data());
+  if (it!=rarToyGenTableIdx.end()) return it->second;
+
+  rarToyGenTable table;
+  table.min=obs->getMin();
+  table.max=obs->getMax();
+  table.cdf.resize(_nBins+1);
+  table.cdf[0]=0;
+  Double_t obsVal=obs->getVal();
+  RooArgSet normSet(*obs);
+  Double_t binW=(table.max-table.min)/_nBins;
+  for (Int_t i=0; i<_nBins; i++) {
+    obs->setVal(table.min+(i+.5)*binW);
+    Double_t val=pdf->getVal(&normSet);
+    if (!(val>0)) val=0;
+    table.cdf[i+1]=table.cdf[i]+val;
+  }
+  obs->setVal(obsVal);
+  if (table.cdf[_nBins]<=0) { // flat if the pdf vanishes
+    for (Int_t i=0; i<=_nBins; i++) table.cdf[i]=i;
+  }
+  rarToyGenTables.push_back(table);
+  Int_t idx=rarToyGenTables.size()-1;
+  rarToyGenTableIdx[key.Data()]=idx;
+  return idx;
+}
+
+/// \brief Generate a toy dataset
+/// \param nEvt Number of events
+/// \return The dataset generated
+///
+/// Prototype events are used in random order, as for RooMCStudy.
+RooDataSet *rarToyGen::generate(Int_t nEvt)
+{
+  RooDataSet *data=new RooDataSet("rarToyGenData", "rarToyGen data",
+                                  _rowVars);
+  if (nEvt<=0) return data;
+  Int_t nObs=_obsList.getSize();
+  Int_t nSlots=_catIdx.size();
+  // prototype event order
+  Int_t nProt=_protData?_protData->numEntries():0;
+  vector<Int_t> protIdx(nProt);
+  for (Int_t i=0; i<nProt; i++) protIdx[i]=i;
+  for (Int_t i=nProt-1; i>0; i--) {
+    Int_t j=RooRandom::randomGenerator()->Integer(i+1);
+    std::swap(protIdx[i], protIdx[j]);
+  }
+  // one random number stream per block
+  Int_t nBlocks=(nEvt+rarToyGenBlockSize-1)/rarToyGenBlockSize;
+  vector<UInt_t> seeds(nBlocks);
+  for (Int_t b=0; b<nBlocks; b++)
+    seeds[b]=1+RooRandom::randomGenerator()->Integer(kMaxInt);
+  vector<Int_t> slots(nEvt);
+  vector<Double_t> vals(nEvt*nObs);
+  {
+    const Int_t *protSlot=_protSlot.size()>0?&_protSlot[0]:0;
+    const Int_t *pIdx=nProt>0?&protIdx[0]:0;
+    const Double_t *slotCum=&_slotCum[0];
+    const Int_t *leafBegin=&_leafBegin[0];
+    const Double_t *leafCum=_leafCum.size()>0?&_leafCum[0]:0;
+    const Int_t *leafTables=_leafTables.size()>0?&_leafTables[0]:0;
+    const rarToyGenTable *tables=
+      rarToyGenTables.size()>0?&rarToyGenTables[0]:0;
+    const UInt_t *seed=&seeds[0];
+    Int_t *slot=&slots[0];
+    Double_t *val=&vals[0];
+    vector<Double_t> obsMin(nObs), obsMax(nObs);
+    for (Int_t j=0; j<nObs; j++) {
+      obsMin[j]=((RooRealVar&)_obsList[j]).getMin();
+      obsMax[j]=((RooRealVar&)_obsList[j]).getMax();
+    }
+    const Double_t *oMin=nObs>0?&obsMin[0]:0;
+    const Double_t *oMax=nObs>0?&obsMax[0]:0;
+    rarParallelFor(nBlocks, _nThreads, [=](Int_t first, Int_t last, Int_t) {
+      for (Int_t b=first; b<last; b++) {
+        TRandom3 rng(seed[b]);
+        Int_t evtEnd=TMath::Min((b+1)*rarToyGenBlockSize, nEvt);
+        for (Int_t ev=b*rarToyGenBlockSize; ev<evtEnd; ev++) {
+          Int_t s=protSlot?protSlot[pIdx[ev%nProt]]:
+            rarToyGenPick(slotCum, nSlots, rng.Rndm());
+          Int_t nLeaves=leafBegin[s+1]-leafBegin[s];
+          Int_t l=leafBegin[s]+
+            rarToyGenPick(leafCum+leafBegin[s], nLeaves, rng.Rndm());
+          slot[ev]=s;
+          for (Int_t j=0; j<nObs; j++) {
+            Int_t t=leafTables[l*nObs+j];
+            Double_t u=rng.Rndm();
+            val[ev*nObs+j]=(t>=0)?rarToyGenDraw(tables[t], u):
+              oMin[j]+u*(oMax[j]-oMin[j]);
+          }
+        }
+      }
+    });
+  }
+  // fill the dataset
+  vector<RooRealVar*> obsVars(nObs);
+  for (Int_t j=0; j<nObs; j++) obsVars[j]=(RooRealVar*)_obsList.at(j);
+  for (Int_t ev=0; ev<nEvt; ev++) {
+    if (nProt>0) _rowVars=*_protData->get(protIdx[ev%nProt]);
+    else if (_simCat) _simCat->setIndex(_catIdx[slots[ev]]);
+    for (Int_t j=0; j<nObs; j++) obsVars[j]->setVal(vals[ev*nObs+j]);
+    data->add(_rowVars);
+  }
+  return data;
+}
@@ -0,0 +1,196 @@
+/*****************************************************************************
+* Project: BaBar detector at the SLAC PEP-II B-factory
+* Package: RooRarFit
+ *    File: $Id: rarToyStore.cc,v 1.1 $
+ * Authors:
+ * History:
+ *
+ * Copyright (C) 2005-2012, University of California, Riverside
+ *****************************************************************************/
+
+// -- CLASS DESCRIPTION [RooRarFit] --
+// This class provides toy result store class for RooRarFit
+//////////////////////////////////////////////////////
+//
+// BEGIN_HTML
+// This class provides toy result store class for RooRarFit
+// END_HTML
+//
+
+#include "rarVersion.hh"
+
+#include "Riostream.h"
+
+#include "TFile.h"
+#include "TMath.h"
+#include "TTree.h"
+
+#include "RooAbsReal.h"
+#include "RooArgList.h"
+#include "RooArgSet.h"
+#include "RooFitResult.h"
+#include "RooRealVar.h"
+
+#include "rarToyStore.hh"
+
+using std::cout;
+using std::endl;
+using std::ios;
+
+ClassImp(rarToyStore)
+  ;
+
+/// \brief Default ctor
+/// \param fileName Output root file
+/// \param nFlush Entries between auto-saves
+rarToyStore::rarToyStore(const char *fileName, Int_t nFlush)
+  : TObject(), _file(0), _tree(0), _nFlush(nFlush), _nEntries(0),
+    _nFailed(0), _status(0), _covQual(0), _minNll(0), _edm(0)
+{
+  if (_nFlush<1) _nFlush=1;
+  _ids[0]=_ids[1]=_ids[2]=0;
+  _file=new TFile(fileName, "RECREATE");
+  if (!_file||_file->IsZombie()) {
+    cout<<" rarToyStore: Can not open "<<fileName<<endl;
+    exit(-1);
+  }
+  cout<<" rarToyStore: Streaming toy results to "<<fileName<<endl;
+}
+
+rarToyStore::~rarToyStore()
+{
+  close();
+}
+
+/// \brief Book the tree branches
+/// \param fr The first fit result
+///
+/// The floating params of the first fit define the branches.
+void rarToyStore::book(const RooFitResult *fr)
+{
+  const RooArgList &pars=fr->floatParsFinal();
+  Int_t nPars=pars.getSize();
+  _names.resize(nPars);
+  _buf.resize(4*nPars);
+  _n.assign(nPars, 0);
+  _nBad.assign(nPars, 0);
+  _sumPull.assign(nPars, 0);
+  _sumPull2.assign(nPars, 0);
+  _sumBias.assign(nPars, 0);
+  _sumBias2.assign(nPars, 0);
+  _file->cd();
+  _tree=new TTree("toyResults", "toyResults");
+  for (Int_t i=0; i<nPars; i++) {
+    TString name=pars[i].GetName();
+    _names[i]=name;
+    _tree->Branch(name, &_buf[4*i], name+"/D");
+    _tree->Branch(name+"err", &_buf[4*i+1], name+"err/D");
+    _tree->Branch(name+"pull", &_buf[4*i+2], name+"pull/D");
+    _tree->Branch(name+"truth", &_buf[4*i+3], name+"truth/D");
+  }
+  _tree->Branch("status", &_status, "status/I");
+  _tree->Branch("covQual", &_covQual, "covQual/I");
+  _tree->Branch("minNll", &_minNll, "minNll/D");
+  _tree->Branch("edm", &_edm, "edm/D");
+  _tree->Branch("ID_COL0", &_ids[0], "ID_COL0/I");
+  _tree->Branch("ID_COL1", &_ids[1], "ID_COL1/I");
+  _tree->Branch("ID_COL2", &_ids[2], "ID_COL2/I");
+}
+
+/// \brief Append a toy fit
+/// \param fr The fit result
+/// \param truth Params holding the generated values
+/// \param toyID Toy job ID
+/// \param loopID Toy loop ID
+/// \param sampleID Sample # in the loop
+///
+/// Params not in \p truth use their initial fit values as truth.
+/// Failed fits are stored too, with their status,
+/// but do not enter the pull and bias summaries.
+void rarToyStore::fill(const RooFitResult *fr, const RooArgSet &truth,
+                       Int_t toyID, Int_t loopID, Int_t sampleID)
+{
+  if (!fr) return;
+  if (!_tree) book(fr);
+  _status=fr->status();
+  _covQual=fr->covQual();
+  _minNll=fr->minNll();
+  _edm=fr->edm();
+  _ids[0]=toyID;
+  _ids[1]=loopID;
+  _ids[2]=sampleID;
+  if (_status) _nFailed++;
+  const RooArgList &pars=fr->floatParsFinal();
+  const RooArgList &initPars=fr->floatParsInit();
+  Int_t nPars=_names.size();
+  for (Int_t i=0; i<nPars; i++) {
+    Double_t *buf=&_buf[4*i];
+    RooRealVar *par=(RooRealVar*)pars.find(_names[i]);
+    if (!par) {
+      buf[0]=buf[1]=buf[2]=buf[3]=0;
+      _nBad[i]++;
+      continue;
+    }
+    RooAbsReal *truePar=dynamic_cast<RooAbsReal*>(truth.find(_names[i]));
+    if (!truePar) truePar=(RooAbsReal*)initPars.find(_names[i]);
+    buf[0]=par->getVal();
+    buf[1]=par->getError();
+    buf[3]=truePar?truePar->getVal():buf[0];
+    buf[2]=buf[1]>0?(buf[0]-buf[3])/buf[1]:0;
+    if (_status||!(buf[1]>0)||!TMath::Finite(buf[0])) {
+      _nBad[i]++;
+      continue;
+    }
+    Double_t bias=buf[0]-buf[3];
+    _n[i]++;
+    _sumPull[i]+=buf[2];
+    _sumPull2[i]+=buf[2]*buf[2];
+    _sumBias[i]+=bias;
+    _sumBias2[i]+=bias*bias;
+  }
+  _file->cd();
+  _tree->Fill();
+  _nEntries++;
+  if (0==_nEntries%_nFlush) _tree->AutoSave("SaveSelf");
+}
+
+/// \brief Print running pull and bias summaries
+/// \param os The output stream
+void rarToyStore::printSummary(ostream &os) const
+{
+  os<<" rarToyStore: "<<_nEntries<<" toy fits, "<<_nFailed
+    <<" with bad status"<<endl;
+  if (_nEntries<=0) return;
+  ios::fmtflags oldFlags=os.flags();
+  os<<Form(" %-24s %6s %6s %10s %10s %12s %12s", "param", "nFit", "nFail",
+           "pullMean", "pullRMS", "biasMean", "biasRMS")<<endl;
+  Int_t nPars=_names.size();
+  for (Int_t i=0; i<nPars; i++) {
+    Double_t pullMean(0), pullRMS(0), biasMean(0), biasRMS(0);
+    if (_n[i]>0) {
+      pullMean=_sumPull[i]/_n[i];
+      pullRMS=TMath::Sqrt(TMath::Max(_sumPull2[i]/_n[i]-pullMean*pullMean,
+                                     0.));
+      biasMean=_sumBias[i]/_n[i];
+      biasRMS=TMath::Sqrt(TMath::Max(_sumBias2[i]/_n[i]-biasMean*biasMean,
+                                     0.));
+    }
+    os<<Form(" %-24s %6d %6d %10.4f %10.4f %12.5g %12.5g",
+             _names[i].Data(), _n[i], _nBad[i],
+             pullMean, pullRMS, biasMean, biasRMS)<<endl;
+  }
+  os.flags(oldFlags);
+}
+
+/// \brief Write the tree and close the file
+void rarToyStore::close()
+{
+  if (!_file) return;
+  printSummary(cout);
+  _file->cd();
+  if (_tree) _tree->Write(0, TObject::kOverwrite);
+  _file->Close();
+  delete _file;
+  _file=0;
+  _tree=0;
+}
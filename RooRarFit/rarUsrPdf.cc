@@ -51,6 +51,7 @@
 //==================================================================>
 // Please include your RooFit Pdf header here                       v
 // #include "mydir/myPdf.hh"                                        v
+// #include "rarFormulaCompiler.hh" // for compiled formula pdfs    v
 
 //                                                                  ^
 //                                                                  ^
@@ -139,6 +140,10 @@ void rarUsrPdf::init()
   // create pdf
   //_thePdf=new myPdf(Form("the_%s", GetName()),_pdfType+" "+GetTitle(),
   // *_x, *_a, *_b, *_c, *_d, *_e);
+  // or, for a formula pdf (compiled if rarFit runs with -c):
+  //_thePdf=rarFormulaCompiler::createGenericPdf
+  //  (Form("the_%s", GetName()), _pdfType+" "+GetTitle(),
+  //   "exp(-@1*@0)*(1+@2*@0)", RooArgList(*_x, *_a, *_b));
   //                                                                  ^
   // change the lines in between the marks as you want                ^
   //==================================================================>
@@ -1178,7 +1178,7 @@ void fit_table_K0(int cc){
       RooRealVar frac_s("frac_s","frac_s",0.65,0.5,0.7) ; //
       RooAddPdf sig("sig","sig",RooArgList(gauss1,gauss2),frac_s) ;
 
-      RooFormulaVar N_a_s("N_a_s","N_pi_s + N_k_s + N_p_s + N_u_s",RooArgSet(N_pi_s,N_k_s,N_p_s,N_u_s));
+      RooAddition N_a_s("N_a_s","N_pi_s + N_k_s + N_p_s + N_u_s",RooArgList(N_pi_s,N_k_s,N_p_s,N_u_s));
 
       RooAddPdf model_all("model_all","model_all",RooArgList(sig,bgna),RooArgList(N_a_s,N_a_b)) ;
       RooAddPdf model_pi("model_pi","model_pi",RooArgList(sig,bgna),RooArgList(N_pi_s,N_pi_b)) ; // checked with bgnpi
@@ -1450,7 +1450,7 @@ void fit_table_phi(int cc){
       ent = h[2+cc][4][p][t]->GetEntries(); //[p][t]
       RooRealVar N_u_s("N_u_s","N_u_s",0.77*ent,0.,1.05*ent) ;
       RooRealVar N_u_b("N_u_b","N_u_b",0.23*ent,0.,1.05*ent) ;
-      RooFormulaVar N_a_s("N_a_s","N_pi_s + N_k_s + N_p_s + N_u_s",RooArgSet(N_pi_s,N_k_s,N_p_s,N_u_s));
+      RooAddition N_a_s("N_a_s","N_pi_s + N_k_s + N_p_s + N_u_s",RooArgList(N_pi_s,N_k_s,N_p_s,N_u_s));
 
       //bedingung nur für t = 2
 
@@ -1797,7 +1797,7 @@ void fit_table_Lambda(int cc){
       RooRealVar N_u_s("N_u_s","N_u_s",0.77*ent,0.,1.05*ent) ;
       RooRealVar N_u_b("N_u_b","N_u_b",0.11*ent,0.,1.05*ent) ;
 
-      RooFormulaVar N_a_s("N_a_s","N_pi_s + N_k_s + N_p_s + N_u_s",RooArgSet(N_pi_s,N_k_s,N_p_s,N_u_s));
+      RooAddition N_a_s("N_a_s","N_pi_s + N_k_s + N_p_s + N_u_s",RooArgList(N_pi_s,N_k_s,N_p_s,N_u_s));
 
       if(t == 1 && p == Np-2) {
 	N_k_s.setVal(0);
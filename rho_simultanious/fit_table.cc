@@ -1530,7 +1530,7 @@ void fit_table_k0(int cc){
 			RooRealVar frac_s("frac_s","frac_s",0.65,0.5,0.7) ; //
 			RooAddPdf sig("sig","sig",RooArgList(gauss1,gauss2),frac_s) ;
 
-			RooFormulaVar N_a_s("N_a_s","N_pi_s + N_k_s + N_p_s + N_u_s",RooArgSet(N_pi_s,N_k_s,N_p_s,N_u_s));
+			RooAddition N_a_s("N_a_s","N_pi_s + N_k_s + N_p_s + N_u_s",RooArgList(N_pi_s,N_k_s,N_p_s,N_u_s));
 
 			RooAddPdf model_all("model_all","model_all",RooArgList(sig,bgna),RooArgList(N_a_s,N_a_b)) ;
 			RooAddPdf model_pi("model_pi","model_pi",RooArgList(sig,bgna),RooArgList(N_pi_s,N_pi_b)) ; // checked with bgnpi
@@ -1840,7 +1840,7 @@ void fit_table_phi(int cc){
 			ent = h[2+cc][4][p][t]->GetEntries(); //[p][t]
 			RooRealVar N_u_s("N_u_s","N_u_s",0.77*ent,0.,1.05*ent) ;
 			RooRealVar N_u_b("N_u_b","N_u_b",0.23*ent,0.,1.05*ent) ;
-			RooFormulaVar N_a_s("N_a_s","N_pi_s + N_k_s + N_p_s + N_u_s",RooArgSet(N_pi_s,N_k_s,N_p_s,N_u_s));
+			RooAddition N_a_s("N_a_s","N_pi_s + N_k_s + N_p_s + N_u_s",RooArgList(N_pi_s,N_k_s,N_p_s,N_u_s));
 // 			RooFormulaVar N_a_b("N_a_b","N_pi_b + N_k_b + N_p_b + N_u_b",RooArgSet(N_pi_b,N_k_b,N_p_b,N_u_b));
 
 			//bedingung nur für t = 2
@@ -2282,7 +2282,7 @@ void fit_table_lambda(int cc){
 			RooRealVar N_u_s("N_u_s","N_u_s",0.77*ent,0.,1.05*ent) ;
 			RooRealVar N_u_b("N_u_b","N_u_b",0.11*ent,0.,1.05*ent) ;
 
-			RooFormulaVar N_a_s("N_a_s","N_pi_s + N_k_s + N_p_s + N_u_s",RooArgSet(N_pi_s,N_k_s,N_p_s,N_u_s));
+			RooAddition N_a_s("N_a_s","N_pi_s + N_k_s + N_p_s + N_u_s",RooArgList(N_pi_s,N_k_s,N_p_s,N_u_s));
 // 			RooFormulaVar N_a_b("N_a_b","N_pi_b + N_k_b + N_p_b + N_u_b",RooArgSet(N_pi_b,N_k_b,N_p_b,N_u_b));
 
 			if(t == 1 && p == Np-2) {
@@ -2877,7 +2877,7 @@ void fit_table_rho(int cc){
 			RooRealVar frac_s("frac_s","frac_s",0.65,0.5,0.7); //
 			RooAddPdf sig("sig","sig",RooArgList(gauss1,gauss2),frac_s);
 
-			RooFormulaVar N_a_s("N_a_s","N_pi_s + N_k_s + N_p_s + N_u_s",RooArgSet(N_pi_s,N_k_s,N_p_s,N_u_s));
+			RooAddition N_a_s("N_a_s","N_pi_s + N_k_s + N_p_s + N_u_s",RooArgList(N_pi_s,N_k_s,N_p_s,N_u_s));
 
 			RooAddPdf model_all("model_all","model_all",RooArgList(sig,bgna),RooArgList(N_a_s,N_a_b));
 			RooAddPdf model_pi("model_pi","model_pi",RooArgList(sig,bgna),RooArgList(N_pi_s,N_pi_b)); // checked with bgnpi
@@ -20,6 +20,7 @@
 #include "TH2.h"
 #include "Masses.h"
 #include "Phast.h"
+#include "RICHPlane.h"
 
 // *************** Lambda MASS conditioned by VERTEX LINE ***************
 static TH1D *hm_Lc0, *hm_aLc0;
@@ -160,6 +161,7 @@ void FillLambda(double m_ppi, double m_pip,
 		bool hasmumup,            // p-V has mu/mu'
 		const PaTrack &trk1,      // >0 track
 		const PaTrack &trk2,      // <0 track
+		const RICHPlane &rp1, const RICHPlane &rp2, // State @ RICH
 		bool downstreamOfTarget,  // s-Vertex downstream of target
 		int pID)      // 2-bit pattern: LSB = Lambda, MSB = \bar{Lambda}
 {
@@ -187,7 +189,7 @@ void FillLambda(double m_ppi, double m_pip,
 	      double ThetX = hi2(3)-hi1(3), bin = floor(ThetX/.04)+2;
 	      if (bin<0) bin = 0; if (bin>3) bin = 3;
 	      hm_LcllX->Fill(m_ppi,bin);                // vs. Theta X
-	      double BetaX = trk2.vAux()[0]-trk1.vAux()[0];
+	      double BetaX = rp2.XR-rp1.XR;
 	      bin = floor(BetaX/.04)+3; if (bin<0) bin = 0; if (bin>5) bin = 5;
 	      hm_LcllB->Fill(m_ppi,bin);                // vs. Beta X
 	    }
@@ -199,11 +201,11 @@ void FillLambda(double m_ppi, double m_pip,
 	  else {
 	    hm_Lcss->Fill(m_ppi);                  // SAS times SAS
 	    if (hLevel_Lambda&0x10) {
-	      double ThetX = trk2.vAux()[0]-trk1.vAux()[0];
+	      double ThetX = rp2.XR-rp1.XR;
 	      double bin = floor(ThetX/.025)+2;
 	      if (bin<0) bin = 0; if (bin>3) bin = 3;
 	      hm_LcssX->Fill(m_ppi,bin);                // vs. Theta X
-	      double BetaX = trk2.vAux()[2]-trk1.vAux()[2];
+	      double BetaX = rp2.tgXR-rp1.tgXR;
 	      bin = floor(BetaX/.025)+3; if (bin<0) bin = 0; if (bin>5) bin = 5;
 	      hm_LcssB->Fill(m_ppi,bin);                // vs. Beta X
 
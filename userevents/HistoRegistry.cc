@@ -0,0 +1,132 @@
+// $Id: HistoRegistry.cc,v 1.1 $
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "TDirectory.h"
+#include "TH1.h"
+#include "TH2.h"
+#include "TProfile.h"
+#include "HistoRegistry.h"
+
+using namespace std;
+
+HistoRegistry *HistoRegistry::address = 0; // Init static pointer
+
+HistoRegistry::HistoRegistry()
+{
+  if (address) {
+    printf("** HistoRegistry::HistoRegistry:\a Already instantiated\n");
+    assert(false);
+  }
+  address = this;
+
+  // ***** OPTIONS FILE: "<family> on|off" per line, '#' = comment
+  const char *fileName = getenv("U3_HISTO_OPTIONS"); bool required = true;
+  if (!fileName) { fileName = "UserEvent103.histos"; required = false; }
+  FILE *f = fopen(fileName,"r");
+  if (!f) {
+    if (required) {
+      printf("** HistoRegistry:\a Cannot open options file \"%s\"\n",fileName);
+      assert(false);
+    }
+    return;
+  }
+  char line[256]; int iLine = 0; while (fgets(line,sizeof(line),f)) {
+    iLine++;
+    char *c = strchr(line,'#'); if (c) *c = '\0';
+    char name[128], onOff[8];
+    int n = sscanf(line,"%127s %7s",name,onOff); if (n<=0) continue;
+    if (n!=2 || (strcmp(onOff,"on") && strcmp(onOff,"off"))) {
+      printf("** HistoRegistry:\a \"%s\":%d: Syntax error, expecting \"<family> on|off\"\n",
+	     fileName,iLine);
+      assert(false);
+    }
+    options.push_back(make_pair(string(name),!strcmp(onOff,"on")));
+  }
+  fclose(f);
+  printf(" * HistoRegistry: %d family settings read from \"%s\"\n",
+	 (int)options.size(),fileName);
+}
+
+int HistoRegistry::Family(const char *name, bool enabledByDefault)
+{
+  for (int i = 0; i<(int)fams.size(); i++) if (fams[i].name==name) {
+      printf("** HistoRegistry::Family:\a Family \"%s\" already declared\n",name);
+      assert(false);
+    }
+  Fam f; f.name = name; f.enabled = enabledByDefault; f.booked = false;
+  for (int i = 0; i<(int)options.size(); i++) // Last setting prevails
+    if (options[i].first==name) f.enabled = options[i].second;
+  fams.push_back(f);
+  return (int)fams.size()-1;
+}
+
+int HistoRegistry::Declare(int family, char type,
+			   const char *name, const char *title,
+			   int nx, double xlo, double xhi,
+			   int ny, double ylo, double yhi)
+{
+  if (family<0 || (int)fams.size()<=family) {
+    printf("** HistoRegistry:\a Histo \"%s\": No such family %d\n",name,family);
+    assert(false);
+  }
+  if (fams[family].booked) {
+    printf("** HistoRegistry:\a Histo \"%s\": Family \"%s\" already booked\n",
+	   name,fams[family].name.c_str());
+    assert(false);
+  }
+  Histo s;
+  s.family = family; s.type = type; s.name = name; s.title = title;
+  s.nx = nx; s.xlo = xlo; s.xhi = xhi; s.ny = ny; s.ylo = ylo; s.yhi = yhi;
+  s.dir = gDirectory; s.h = 0;
+  histos.push_back(s);
+  int h = (int)histos.size()-1; fams[family].histos.push_back(h);
+  return h;
+}
+
+int HistoRegistry::H1(int family, const char *name, const char *title,
+		      int nx, double xlo, double xhi)
+{
+  return Declare(family,'1',name,title,nx,xlo,xhi,0,0,0);
+}
+int HistoRegistry::H2(int family, const char *name, const char *title,
+		      int nx, double xlo, double xhi,
+		      int ny, double ylo, double yhi)
+{
+  return Declare(family,'2',name,title,nx,xlo,xhi,ny,ylo,yhi);
+}
+int HistoRegistry::Prof(int family, const char *name, const char *title,
+			int nx, double xlo, double xhi)
+{
+  return Declare(family,'P',name,title,nx,xlo,xhi,0,0,0);
+}
+
+void HistoRegistry::Book(Fam &f)
+{
+  // Book all histos of the family, each in the TDirectory that was current
+  // when it was declared, and restore the current TDirectory.
+  TDirectory *current = gDirectory;
+  for (int i = 0; i<(int)f.histos.size(); i++) {
+    Histo &s = histos[f.histos[i]];
+    s.dir->cd();
+    const char *n = s.name.c_str(), *t = s.title.c_str();
+    if      (s.type=='1') s.h = new TH1D(n,t,s.nx,s.xlo,s.xhi);
+    else if (s.type=='2') s.h = new TH2D(n,t,s.nx,s.xlo,s.xhi,s.ny,s.ylo,s.yhi);
+    else                  s.h = new TProfile(n,t,s.nx,s.xlo,s.xhi);
+  }
+  current->cd();
+  f.booked = true;
+}
+
+void HistoRegistry::Print() const
+{
+  printf(" * HistoRegistry: %d families, %d histos\n",
+	 (int)fams.size(),(int)histos.size());
+  for (int i = 0; i<(int)fams.size(); i++) {
+    const Fam &f = fams[i];
+    printf("   %-16s %-3s %4d histos%s\n",f.name.c_str(),f.enabled?"on":"off",
+	   (int)f.histos.size(),f.booked?", booked":"");
+  }
+}
@@ -0,0 +1,94 @@
+// $Id: HistoRegistry.h,v 1.1 $
+
+#ifndef HistoRegistry_h
+#define HistoRegistry_h
+/*!
+  \class HistoRegistry
+  \brief Registry of histograms, w/ runtime enabling and lazy booking
+
+  Histograms are grouped in families (e.g. all the RICH efficiency vs. phase
+  space histos of the phi). Each family and each histogram is referred to by a
+  dense integer handle, returned upon declaration.
+  - Declaring a histogram only records its specifications, together w/ the
+  TDirectory that is current at that time: no ROOT object is created.
+  - The whole family is booked, in one go, upon the first "Fill" of any of
+  its members. A family that is never filled costs no ROOT memory.
+  - A disabled family is never booked: "Fill" then reduces to one test.
+  Families are enabled by default, or not, as specified upon declaration. This
+  can be overridden at run time by an options file, whose lines read:
+    <family name> on|off
+  ('#' starts a comment), and whose path is given by the env. variable
+  "U3_HISTO_OPTIONS", else defaults to "./UserEvent103.histos", if it exists.
+*/
+
+#include <string>
+#include <vector>
+#include "TH1.h"
+
+class TDirectory;
+
+class HistoRegistry {
+public:
+  //! Constructor: reads the options file, if any. Returned error has to be asserted
+  HistoRegistry();
+
+  //! Returns pointer to HistoRegistry
+  static HistoRegistry *Ptr() { return address; }
+
+  //! Declare family, return its handle
+  int Family(const char *name, bool enabledByDefault = true);
+  //! Is family enabled?
+  bool Enabled(int family) const { return fams[family].enabled; }
+
+  //! Declare histograms (booked lazily), in current TDirectory. Return handle
+  int H1(int family, const char *name, const char *title,
+	 int nx, double xlo, double xhi);
+  int H2(int family, const char *name, const char *title,
+	 int nx, double xlo, double xhi, int ny, double ylo, double yhi);
+  int Prof(int family, const char *name, const char *title,
+	   int nx, double xlo, double xhi);
+
+  //! Fill: 1D, 1D w/ weight (TH1D), 2D (TH2D), profile (TProfile)...
+  void Fill(int h, double x) {
+    const Histo &s = histos[h]; Fam &f = fams[s.family];
+    if (!f.enabled) return;
+    if (!f.booked) Book(f);
+    s.h->Fill(x);
+  }
+  //! ...as per TH1::Fill(double,double), i.e. dispatched by the ROOT class
+  void Fill(int h, double x, double y) {
+    const Histo &s = histos[h]; Fam &f = fams[s.family];
+    if (!f.enabled) return;
+    if (!f.booked) Book(f);
+    s.h->Fill(x,y);
+  }
+
+  //! Print families, enabled status, #histos, booked status
+  void Print() const;
+
+private:
+  static HistoRegistry *address;        //! (-) address of this object
+
+  struct Histo {
+    int family;
+    char type;             // '1', '2' or 'P'
+    std::string name, title;
+    int nx, ny; double xlo, xhi, ylo, yhi;
+    TDirectory *dir;
+    TH1 *h;                // =0 until booked
+  };
+  struct Fam {
+    std::string name;
+    bool enabled, booked;
+    std::vector<int> histos;
+  };
+  std::vector<Histo> histos;
+  std::vector<Fam> fams;
+  std::vector<std::pair<std::string,bool> > options; // From options file
+
+  int Declare(int family, char type, const char *name, const char *title,
+	      int nx, double xlo, double xhi, int ny, double ylo, double yhi);
+  void Book(Fam &f);
+};
+// End of HistoRegistry class
+#endif
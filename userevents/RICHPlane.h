@@ -0,0 +1,22 @@
+// $Id: RICHPlane.h,v 1.1 $
+
+// Per-track state @ RICH entrance (and downstream of SM2), as computed by
+// "transport" in UserEvent103.
+
+#ifndef RICHPlane_h
+#define RICHPlane_h 1
+
+struct RICHPlane {
+  int aR;          // RICH acceptance flag:
+  //                  =0: Not yet evaluated
+  //                  =1: W/in RICH acceptance
+  //                  =2: Tighter cuts
+  //                  =-1: W/out acceptance
+  //                  =-2: Downstream of RICH (all other fields then =0)
+  int ihBest;      // Index of the helix, upstream of SM2, closest to ZRICH
+  float XR, YR;    // Position @ ZRICH
+  float tgXR, tgYR;// Slopes @ ZRICH
+  float tgXSM2;    // Horizontal slope 1m downstream of SM2 (0x4-zone tracks)
+};
+
+#endif
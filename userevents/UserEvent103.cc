@@ -58,11 +58,14 @@
 // Dependencies:
 // - UserEvent103.h
 // - Masses.h, GetPIDs.cc, RICH.cc|h, MCInfo.cc|h, DataTakingDB.cc|h,
-//  HistoLambda.cc, MCLambda.cc|h, UsParticle.h
+//  HistoLambda.cc, MCLambda.cc|h, UsParticle.h, RICHPlane.h, V0Kine.h,
+//  HistoRegistry.cc|h, U3Selection.h
 
 #include <math.h>
+#include <stdlib.h>
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 
 #include "TVectorD.h"
 #include "TMatrixD.h"
@@ -86,6 +89,10 @@
 #include "Masses.h"
 #include "UsParticle.h"
 #include "DataTakingDB.h"
+#include "RICHPlane.h"
+#include "V0Kine.h"
+#include "U3Selection.h"
+#include "HistoRegistry.h"
 
 // *************************************************************************
 // *************************  UserEvent103 VERSIONS  *************************
@@ -169,6 +176,19 @@
 // It's set low: CSEvtTree analysis may set it tighter
 #define Ephi_pTCUT 5  // pT ('hadron' w.r.t VM) cut for excl. phi uDST selection
 #define Iphi_pTCUT 5  // pT CUT for incl. phi selection
+// Cascade search: prefilter 3rd tracks on their distance of closest approach
+// to the Lambda line of flight, both approximated by straight lines, prior to
+// vertexing them w/ PaTPar::FindCDA. The cut is derived from the significance
+// cut on D @ CDA ("d3hSigCut"): dd3h, the error projected along D, is <=
+// sqrt(Tr) (Tr = trace of the XY covariance of the 2 helices), so that any
+// candidate passing it has D < d3hSigCut*sqrt(Tr). The prefilter cuts @
+// "CDAPrefilter" times that, the margin covering the growth of covariance
+// from first helix to CDA and the straight-line approximation.
+// The factor is set at run time by the env. variable "U3_CASCADE_CDA_PREFILTER"
+// (default 3, 0 = off: vertex all tracks). That no candidate is lost has to be
+// checked w/ U3_CASCADE_CDA_PREFILTER_CHECK (vertex all tracks and report those
+// the prefilter would have rejected), for the data set at hand.
+//#define U3_CASCADE_CDA_PREFILTER_CHECK
 
 
 // - DO NOT IMPACT uDST SELECTION
@@ -467,6 +487,7 @@ static double zCutS = .20, cLowCutS = -.85, cUpCutS = .85;
 static double zCut0 = .25, cLowCut0 = -.50, cUpCut0 = .50;
 // RICH GLOBALS
 static RICH *rich;
+static HistoRegistry *hReg;
 static double piThr, KThr, pThr;
 // FI/MM ASCISSAE
 static double ZFI02X, ZMM02X;
@@ -564,7 +585,101 @@ static double RRBin = 6;
 static double ARBin = .012;
 #  endif
 #endif
-static int *tZones, *aRs;
+static int *tZones;
+//   ***** LH-RATIO ID DECISIONS for ALL TRACKS *****
+// Bit pattern per track (cf. "U3Selection.h"), built once per event by
+// "getLHIDs", in a single flat loop over the arrays filled by "GetPIDs".
+static int *LHIDs;
+// Per-track state @ RICH: filled lazily, at most once per event and track, by
+// "richPlane" (which calls "transport").
+static RICHPlane *rPlanes;
+// The above arrays are views into a per-job scratch arena, allocated in a few
+// blocks grown to the max. #tracks seen so far, and reset, not reallocated, at
+// each event.
+static int        trkArenaSize = 0;
+static int       *trkArenaInts = 0;    // PIDs, tZones, LHIDs
+static double    *trkArenaDoubles = 0; // richDths, richLHs[5], richChi2s[5]
+static RICHPlane *trkArenaPlanes = 0;  // rPlanes
+
+//   ***** TABLE of ACCEPTED TRACKS of BEST pVERTEX *****
+// Built once per event, upon first request, by "getPVTracks", for the
+// combinatorial searches of "fillK0X". Retains the tracks passing the
+// standard rejections (mu', fringe field, chi2, muons, downstream of RICH),
+// w/ their 4-momenta @ pV under the pi, K and p hypotheses and their RICH
+// PID, so that inner loops need not re-derive them.
+struct PVTrack {
+  int iET, Q;
+  double P;                       // |P| @ pV: table is sorted on it
+  TLorentzVector lvpi, lvK, lvp;  // 4-momenta @ pV
+  int aboveK;                     // P @ first helix above KThr (w/ margin)
+  int piok, Kok, pok;             // RICH ID: 1 = above Thr, 2 = subThreshold
+#ifdef piS_e_REJECTION
+  bool eVeto;                     // e-rejection for the soft pi of D*
+#endif
+};
+static vector<PVTrack> pVTracks;  // Capacity kept from event to event
+static int pVTracksNeg;           // #Negative tracks, stored at the end
+static bool lessPVTrackP(const PVTrack &a, const PVTrack &b) { return a.P<b.P; }
+static double pVspT;              // Sum of pT w.r.t. virtual photon
+static bool pVTracksOK;           // Table up to date for current event
+//   ***** INDEX of TRACKS for CASCADE SEARCH *****
+// Built once per event, upon first request, by "getLCTracks", for the search
+// of "fillLCascades". Retains the tracks passing the Lambda-independent
+// rejections, w/ the tangent to their first helix, split by charge and sorted
+// on the X of that tangent @ best pV, so that each Lambda only looks at a
+// window in X. Tracks w/ first helix downstream of SM1, for which the tangent
+// is meaningless, are kept aside, and always vertexed.
+struct LCTrack {
+  int iET;
+  double X, Y, tx, ty;            // Tangent to first helix @ Z = lcTracksZ
+  double cov;                     // Trace of XY covariance of first helix
+};
+static vector<LCTrack> lcTracks[2];    // [0]: Q<=0, [1]: Q>=0, sorted on X
+static vector<LCTrack> lcTracksFar[2]; // Not indexed
+static double lcTracksZ, lcTracksTxMn[2], lcTracksTxMx[2], lcTracksCovMx[2];
+static const double d3hSigCut = 16; // Loose cut on D/dD @ CDA of cascade
+static double CDAPrefilter = 3;     // Prefilter cut, in units of d3hSigCut
+static bool lcTracksOK;
+static bool lessLCTrackX(const LCTrack &a, const LCTrack &b) { return a.X<b.X; }
+static void resetTrackArena(int nTrks)
+{
+  if (nTrks>trkArenaSize) {
+    int nAlloc = trkArenaSize ? trkArenaSize : 64;
+    while (nAlloc<nTrks) nAlloc *= 2;
+    delete[] trkArenaInts; delete[] trkArenaDoubles; delete[] trkArenaPlanes;
+    trkArenaInts = new int[3*nAlloc];
+    trkArenaDoubles = new double[11*nAlloc](); // =0: "getLHIDs" reads them all
+    trkArenaPlanes = new RICHPlane[nAlloc];
+    trkArenaSize = nAlloc;
+    int i, n = trkArenaSize;
+    PIDs = trkArenaInts; tZones = trkArenaInts+n; LHIDs = trkArenaInts+2*n;
+    rPlanes = trkArenaPlanes;
+    richDths = trkArenaDoubles;
+    for (i = 0; i<5; i++) richLHs[i]   = trkArenaDoubles+(1+i)*n;
+    for (i = 0; i<5; i++) richChi2s[i] = trkArenaDoubles+(6+i)*n;
+  }
+  // Only PIDs, tZones and the RICH planes need be reset: "GetPIDs" fills the
+  // double arrays for those tracks that have PIDs&0x8 set, and "getLHIDs"
+  // fills LHIDs for all tracks.
+  memset((void*)PIDs,   0,nTrks*sizeof(int));
+  memset((void*)tZones, 0,nTrks*sizeof(int));
+  memset((void*)rPlanes,0,nTrks*sizeof(RICHPlane));
+  pVTracksOK = false; lcTracksOK = false;
+}
+static void getLHIDs(int nTrks)
+{
+  U3LHCuts c;
+  c.LHCut = LHCut; c.LHBckCut = LHBckCut; c.piLHeVeto = piLHeVeto;
+  c.subKThrLHpiVeto = subKThrLHpiVeto;
+#ifdef REJECT_SubKThr_e
+  c.subKThrLHeVeto = subKThrLHeVeto; c.subKThre = 1;
+#else
+  c.subKThrLHeVeto = 0;              c.subKThre = 0;
+#endif
+  c.subpThrLHpiVeto = subpThrLHpiVeto; c.subpThrLHVeto = subpThrLHVeto;
+  c.subpiThrLHeVeto = subpiThrLHeVeto;
+  U3LHIDs(nTrks,PIDs,richLHs,c,LHIDs);
+}
 
 static double ZSM1, ZSM2;// Z absissae of magnets (retrieved from PaSetup)...
 static double ZTarget;   // ...and target
@@ -572,7 +687,10 @@ static double ZTarget;   // ...and target
 #ifdef U3_OUTPUT_TREE
 static CSEventData *fCSEvt;
 static vector<CSHadronData> fHadrons;
-static map<int,int> fPa2fH;  // X-reference PaParticle::MyIndex -> fHadrons
+// X-reference PaParticle::MyIndex -> fHadrons (-1: not yet). Dense, sized to
+// #particles at each event: capacity kept from event to event, as is that of
+// "fHadrons" and "fResonances", in which objects are constructed in place.
+static vector<int> fPa2fH;
 static vector<CSResonanceData> fResonances;
 static TTree *fCSEvtTree;
 static PaPid *fPid;
@@ -624,10 +742,11 @@ void fillK0woPV(double m_pipi, double Xs, double Ys, double Zs,
 		double pT, double zL1, double zL2, const TLorentzVector &lvpipi);
 #ifdef U3_K0_HIGHLEVEL
 void fillK0HighLevel(const PaTrack &trk1, const PaTrack &trk2,
+		     const RICHPlane &rp1, const RICHPlane &rp2,
 		     double m_pipi, const TLorentzVector &lvpipi,
 		     double Theta, double Thetx, double Thety, double ThetX,
 		     double alpha, double beta);
-void getK0Incidence(const PaTrack &trk1, const PaTrack &trk2,
+void getK0Incidence(const RICHPlane &rp1, const RICHPlane &rp2,
 		    int zones1, int zones2,
 		    const TVector3 &v13, const TVector3 &v23,
 		    const PaTPar &hi1, const PaTPar &hi2,
@@ -646,6 +765,7 @@ void fillK0X(PaEvent &e, int ipV, int imuS,
 	     const TLorentzVector &lvq,
 	     int iET1, int iET2, const TLorentzVector &lvK0,
 	     double KSMassCut, double dM_phi, double phiMassCut);
+void getPVTracks(PaEvent &e, int ipV, int imuS, const TLorentzVector &lvq);
 void bookK0_RICHPerf(double dM_K0, double K0MassCut);
 void bookK0_RICHPur(double dM_K0);
 void fillK0_RICHPerf(PaEvent &e, int iET1, int iET2,
@@ -659,6 +779,7 @@ void FillLambda(double m_ppi, double m_pip,
 		bool hasmumuS,            // p-V has mu/mu'
 		const PaTrack &trk1,      // >0 track
 		const PaTrack &trk2,      // <0 track
+		const RICHPlane &rp1, const RICHPlane &rp2, // State @ RICH
 		bool downstreamOfTarget,  // s-Vertex downstream of target
 		int pID);                 // 2-bit pattern, w/ LSB = >0 particle
 void bookLambdaMisc(const double *V0DsdD, const double *V0cthCut, const double *V0pTCut,
@@ -675,16 +796,15 @@ void fillLCascades(PaEvent &e, int ipV, TMatrixD &CovP, int imuS,
 		   int isV, TMatrixD &CovS, int iET1, int iET2, int iLaL,
 		   const TLorentzVector *lvL, unsigned short ppiID,
 		   bool &uDSTSelection);
+void getLCTracks(PaEvent &e, int imuS, double Zref);
 //void FillLambdaMC(double m, int pID);
 void bookLambda_RICHPerf(double dM_Lambda, double LMassCut);
 void fillLambda_RICHPerf(PaEvent &e, int iET1, int iET2, int iETp,
 			 const TLorentzVector &lvp1,
 			 double m_ppi, bool &isLambda, int Run);
 #endif
-void transport(PaEvent &e,
-	       PaTrack &trk,    // 
-	       int &aR,         // RICH acceptance flag
-	       int zones);
+void transport(const PaTrack &trk, int zones, RICHPlane &rp);
+const RICHPlane &richPlane(PaEvent &e, int iET);
 #if defined U3_K0_HIGHLEVEL || defined U3_L_HIGHLEVEL
 void getGM0709WB(int *gm0709Ws, unsigned int *gm0709Bs);
 #  ifdef U3_K0_HIGHLEVEL
@@ -864,6 +984,13 @@ void UserEvent103(PaEvent &e)
     
     // ***** INSTANTIATE RICH **********
     if ((rich = RICH::Ptr())==0) rich = new RICH(nSigmas,nVeto);
+    // ***** INSTANTIATE HISTOGRAM REGISTRY (reads runtime histo options)
+    if ((hReg = HistoRegistry::Ptr())==0) hReg = new HistoRegistry();
+    // ***** CASCADE CDA PREFILTER: RUNTIME FACTOR (0 = off)
+    const char *cPrefilter = getenv("U3_CASCADE_CDA_PREFILTER");
+    if (cPrefilter) CDAPrefilter = atof(cPrefilter);
+    printf(" * U3: Cascade CDA prefilter: %s (%.1f*%.0f sigmas)\n",
+	   CDAPrefilter>0 ? "on" : "off",CDAPrefilter,d3hSigCut);
 
     // *************** INSTANTIATE "MCInfo" "MCLambda" ***************
 #ifdef U3_FILL_Lambda
@@ -887,6 +1014,7 @@ void UserEvent103(PaEvent &e)
     //fCSEvtTree->Branch("Resonances","std::vector<CSResonanceData>",&fResonancesPtr);
     fCSEvtTree->Branch("Rs",&fResonances);
     fCSEvtTree->SetMaxTreeSize(1000000000);
+    fHadrons.reserve(32); fResonances.reserve(32);
     fPid = new PaPid;
 #endif
 
@@ -976,6 +1104,7 @@ void UserEvent103(PaEvent &e)
 #endif
 
     //       ********** END OF HISTOGRAM BOOKING **********
+    hReg->Print();  // All families now declared, w/ their on/off status
 
     // **********************************************************************
     //   ********** DETERMINE SOME GLOBAL VARIABLES (from cpp, PaSetup) *****
@@ -1142,14 +1271,7 @@ void UserEvent103(PaEvent &e)
   // the scattered muon, which in turn implies, for CPU optimization reasons,
   // a number of checks, involving RICH and tZone info.)
   int nTrks = e.vTrack().size();
-  PIDs  = new int[nTrks];
-  richDths = new double[nTrks];
-  for (i = 0; i<5; i++) richLHs[i]   = new double[nTrks];
-  for (i = 0; i<5; i++) richChi2s[i] = new double[nTrks];
-  tZones = new int[nTrks]; aRs = new int[nTrks];
-  memset((void*)tZones,0,nTrks*sizeof(int));
-  memset((void*)aRs,   0,nTrks*sizeof(int));
-  memset((void*)PIDs,  0,nTrks*sizeof(int));
+  resetTrackArena(nTrks);
 
   //          ******************** PREPARE for pID ********************
   // "deltaIndex": Diff between "runIndex" and "meanIndex"(averaged over period)
@@ -1165,6 +1287,7 @@ void UserEvent103(PaEvent &e)
   GetPIDs(e,rich,runIndex,prodIndex,deltaIndex,thCIndex,
 	  PIDs,richLHs,0,        tZones,richDths);
 #endif
+  getLHIDs(nTrks);      // LH-ratio ID decisions, all tracks at once
   //                                                         ***** PARSE BEST pV
   static double  Xp,  Yp,  Zp;  // Primary coordinates
   TMatrixD CovP(3,3);
@@ -1178,8 +1301,6 @@ void UserEvent103(PaEvent &e)
   //                                 ********** CHECK REQUIREMENTS on pVERTEX...
   h_primary->Fill(primaryPat);
   if ((primaryPat&primaryRequirements)!=primaryRequirements) {
-    delete PIDs; delete tZones; delete aRs; delete richDths;
-    for (i = 0; i<5; i++) { delete richLHs[i]; delete richChi2s[i]; }
     //                               ****************************************
     return;                       // ********** ... EXIT if NOT FULFILLED
     //                               ****************************************
@@ -1189,7 +1310,7 @@ void UserEvent103(PaEvent &e)
 
 #ifdef U3_OUTPUT_TREE
   copyCSEventHeader(e,primaryPat,spillOKPat,pV,E0,Q2,xB,yB,runIndex,prodIndex);
-  fHadrons.clear(); fPa2fH.clear();
+  fHadrons.clear(); fPa2fH.assign(e.vParticle().size(),-1);
   fResonances.clear();
 #endif
 #ifdef U3_ALLOUT_KINE
@@ -1346,9 +1467,9 @@ void UserEvent103(PaEvent &e)
     // relative to the end helix, and hence insensitive to any magnetic effect.
     // This, provided that the end helix is available, though: which is the case
     // in the latest mass productions.)
-    if (aRs[iET1]==0) /* If not yet done */ transport(e,trk1,aRs[iET1],zones1);
-    if (aRs[iET2]==0)                       transport(e,trk2,aRs[iET2],zones2);
-    if (aRs[iET1]<-1 || aRs[iET2]<-1)
+    richPlane(e,iET1); // Transport to RICH, if not yet done
+    richPlane(e,iET2);
+    if (rPlanes[iET1].aR<-1 || rPlanes[iET2].aR<-1)
       continue; // Skip if either track starting downstream of RICH
     const PaTPar &hv1 = pa1->ParInVtx(isV), &hv2 = pa2->ParInVtx(isV);
     TVector3 v13 = hv1.Mom3(), v23 = hv2.Mom3();
@@ -1357,12 +1478,11 @@ void UserEvent103(PaEvent &e)
     const PaTPar &hi1 = trk1.vTPar()[0], &hi2 = trk2.vTPar()[0];
     double mom1 = fabs(1/hi1(5)), mom2 = fabs(1/hi2(5));
 
-    //    *************** PI+PI- MASS ASSUMPTION ***************
-    double E1 = sqrt(v13.Mag2()+M2_pi), E2 = sqrt(v23.Mag2()+M2_pi);
-    TLorentzVector lvpi1(v13,E1), lvpi2(v23,E2), lvpipi = lvpi1+lvpi2;
-    double pT = lvpi1.Perp(lvpipi.Vect()), m_pipi = lvpipi.M();
-    double PL1 = sqrt(v13.Mag2()-pT*pT), PL2 = sqrt(v23.Mag2()-pT*pT);
-    double alpha = (PL1-PL2)/(PL1+PL2);
+    //    *************** ALL MASS ASSUMPTIONS, pT, alpha ***************
+    const V0Kine v0k(v13.X(),v13.Y(),v13.Z(),v23.X(),v23.Y(),v23.Z());
+    double m_pipi = v0k.m[V0Kine::pipi], pT = v0k.pT, alpha = v0k.alpha;
+    TLorentzVector lvpi1(v13,v0k.Epi1), lvpi2(v23,v0k.Epi2);
+    TLorentzVector lvpipi(v0k.P[0],v0k.P[1],v0k.P[2],v0k.E[V0Kine::pipi]);
     
     fillK0woPV(m_pipi,Xs,Ys,Zs,pT,zL1,zL2,lvpipi);  // ***** K0 W/O pV CONDITION
 
@@ -1373,8 +1493,7 @@ void UserEvent103(PaEvent &e)
 	CovS(i,j) = sV.Cov(k); if (i!=j) CovS(j,i) = sV.Cov(k);
       }
     TVector3  vv3(Xs-Xp,Ys-Yp,Zs-Zp);	// Vertex Line
-    double vvv0 = vv3*lvpipi.Vect(), dist = vv3.Mag();
-    double ctheta = vvv0/dist/lvpipi.Vect().Mag();
+    double dist = vv3.Mag(), ctheta = v0k.cth(vv3.X(),vv3.Y(),vv3.Z());
     dist = ctheta>0 ? dist : -dist;
 
     double ddist = 1; // dctheta = 1;
@@ -1403,18 +1522,10 @@ void UserEvent103(PaEvent &e)
     //   ********** V0 SELECTION CRITERIA ********** 
     //                                              ***** INDICES of FULFILLMENT
     double chi2_s = sV.Chi2()/sV.Ndf();
-    int s_dist = 0, s_ctheta = 0, s_pT = 0, s_chi2 = 0;
+    int s_dist, s_ctheta, s_pT, s_chi2;
     //int s_t = 0; // Time selection: not used yet
-    if      (ctheta>V0cthCut[2])   s_ctheta = 3;
-    else if (ctheta>V0cthCut[1])   s_ctheta = 2;
-    else if (ctheta>V0cthCut[0])   s_ctheta = 1;
-    if      (pT>V0pTCut[1])        s_pT = 2;
-    else if (pT>V0pTCut[0])        s_pT = 1;
-    if      (chi2_s<10) s_chi2 = 2; // Exceedingly loose, since chi2 is per NDF
-    else if (chi2_s<15) s_chi2 = 1;
-    if      (dist/ddist>V0DsdD[2]) s_dist = 3;
-    else if (dist/ddist>V0DsdD[1]) s_dist = 2;
-    else if (dist/ddist>V0DsdD[0]) s_dist = 1;
+    U3V0Indices(V0DsdD,V0cthCut,V0pTCut,dist/ddist,ctheta,pT,chi2_s,
+		s_dist,s_ctheta,s_pT,s_chi2);
     //                     ***** DISTRIBUTION HISTOS for K0 SIGNAL and SIDEBANDS
     if      (fabs(m_pipi-M_K0)<.008) {
       if (s_ctheta && s_pT     && s_chi2)   hs_dK0->Fill(dist/ddist);
@@ -1441,7 +1552,7 @@ void UserEvent103(PaEvent &e)
 #endif
 #ifdef U3_K0_HIGHLEVEL  // K0 vs. Incidence and related
     double Theta, Thetx, Thety, ThetX, alpha, beta;
-    getK0Incidence(trk1,trk2,zones1,zones2,v13,v23,hi1,hi2,
+    getK0Incidence(rPlanes[iET1],rPlanes[iET2],zones1,zones2,v13,v23,hi1,hi2,
 		   Theta,Thetx,Thety,ThetX,alpha,beta);
     if      (fabs(m_pipi-M_K0)<.008)             hs_TK0->Fill(Theta);
     else if (fabs(m_pipi-(M_K0-5.25*.008))<.004 ||
@@ -1470,47 +1581,16 @@ void UserEvent103(PaEvent &e)
       uDSTSelection = true;                     // ********** uDST SELECTION: K0
 
       //                                                      ***** EVALUATE PID
-      unsigned short id = 0; // 0x9: piThr<P<Pmax, 0x12: !e+e-, 0x24: actual piID
-      unsigned short idpipOrpim = 0, isNotee = 0;
-      int pm, iET; double mom; for (pm = 0, iET = iET1, mom = mom1; pm<2;
-				    pm++) {
-	if (aRs[iET]>0) {
-	  bool winRange = piThr<mom && mom<PRICHCut;
-	  if (winRange) {
-	    K0Pat |= (0x1<<pm)<<4; id |= 0x1<<(pm*3);
-	  }
-	  if (PIDs[iET]&0x10) {
-	    double eLH = richLHs[3][iET], piLH = richLHs[0][iET];
-	    double KLH = richLHs[1][iET], pLH =  richLHs[2][iET];
-	    double hadronLH = KLH>pLH ? KLH : pLH;
-	    if (eLH==0 || // eLH=piLH=0: eVeto even above piThr!
-		eLH<=piLHeVeto*piLH) {
-	      // eVeto: don't require piThr<P<Pmax. It's:
-	      // - Unnecessary: "piLHeVeto" is expected to be large => P>Pmax,
-	      //  where eLH=piLH, is anyway rejected,
-	      // - Harmful: P<piThr can be efficiently vetoed.
-	      // (Note that piID (i.e. id&0x4) here does not place any condition
-	      // on pi/eLH, which let well ID'd e+/e- pass through. One could
-	      // consider a cut on pi/eLH in the region below asymptotic pions,
-	      // to correct for this. But we want here to arbitrate the purity
-	      // vs. efficiency trade-off in favour of pion, efficiency, since
-	      // pion yield is large compared to e+e- and reasonable purity is
-	      // kind of automatically granted. Anyway, a consequence is that an
-	      // OR of pionID (id&0x4) and eVeto yields more than eVeto alone.)
-	      id |= 0x2<<(pm*3); isNotee |= 0x1<<pm;
-	    }
-	    if (winRange && piLH>LHCut*hadronLH && piLH>LHBckCut) {
-	      id |= 0x4<<(pm*3); idpipOrpim |= 0x1<<pm;
-	    }
-	  }
-	  else {
-	    // Absence of RICH block or LH =0: eVeto, even above piThr, cf. comment in Lambda PID
-	    id |= 0x2<<(pm*3); isNotee |= 0x1<<pm;
-	  }
-	}
-	iET = iET2; mom = mom2;
+      unsigned short id; // 0x9: piThr<P<Pmax, 0x12: !e+e-, 0x24: actual piID
+      {
+	const int aRs[2] = { rPlanes[iET1].aR, rPlanes[iET2].aR };
+	const double moms[2] = { mom1, mom2 };
+	const int pids[2] = { PIDs[iET1], PIDs[iET2] };
+	const int lhIDs[2] = { LHIDs[iET1], LHIDs[iET2] };
+	K0Pat |= U3K0PID(aRs,moms,pids,lhIDs,piThr,PRICHCut,id);
       }
-      K0Pat |= idpipOrpim<<6; K0Pat |= isNotee<<9;
+      unsigned short idpipOrpim = K0Pat>>6&0x3, isNotee = K0Pat>>9&0x3;
+      int pm, iET;
 
       if (s_dist>=1 && s_ctheta>=1)
 	hm_K0c11->Fill(m_pipi);              // ********** ALL K0s HISTOGRAMMING
@@ -1546,7 +1626,7 @@ void UserEvent103(PaEvent &e)
 	else                           hm_K0css->Fill(m_pipi);    // ***** SAS^2
 
 #ifdef U3_K0_HIGHLEVEL  // K0 vs. Incidence and related
-	fillK0HighLevel(trk1,trk2,m_pipi,lvpipi,
+	fillK0HighLevel(trk1,trk2,rPlanes[iET1],rPlanes[iET2],m_pipi,lvpipi,
 			Theta,Thetx,Thety,ThetX,alpha,beta);
 #endif
 	//                                               ***** IN/OUTSIDE TARGET
@@ -1596,16 +1676,16 @@ void UserEvent103(PaEvent &e)
 	       pm++) {	      
 	    if ((idpipOrpim&1<<(1-pm)) || (isNotee&1<<(1-pm))) {
 	      int mp = 1-2*pm; hk_PK0->Fill(mom,mp);
-	      const vector<Float_t> &aux = trk->vAux();
-	      if (aRs[iET]<-1) { // Ensure then "aRs" are meaningful
-		printf("** U3:\a Evt %d,%d Track %d(<-K0): Inconsistency: aRs = %d\n",
-		       e.RunNum(),(int)e.UniqueEvNum(),iET,aRs[iET]);
+	      const RICHPlane &rp = richPlane(e,iET);
+	      if (rp.aR<-1) { // Ensure then RICH plane is meaningful
+		printf("** U3:\a Evt %d,%d Track %d(<-K0): Inconsistency: aR = %d\n",
+		       e.RunNum(),(int)e.UniqueEvNum(),iET,rp.aR);
 		abort();
 	      }
-	      float tgx = aux[2], tgy = aux[3];
+	      float tgx = rp.tgXR, tgy = rp.tgYR;
 	      double thRICH = acos(1/sqrt(1.+ tgx*tgx + tgy*tgy));
 	      hk_PThK0->Fill(mom,thRICH);
-	      hk_XK0->Fill(aux[0],mp); hk_YK0->Fill(aux[1],mp);
+	      hk_XK0->Fill(rp.XR,mp); hk_YK0->Fill(rp.YR,mp);
 	      if (s_dist>=3 && s_ctheta>=3 && s_pT>=2 &&
 		  // Exclude pion decaying to muon, possibly upstream of RICH
 		  trk->XX0()<15 &&
@@ -1654,7 +1734,7 @@ void UserEvent103(PaEvent &e)
 	  // ***************    - MASS CUT           ********************
 	  // ***************    - (OPTIONALLY) eVETO ********************
 	  // ************************************************************
-	  double EK0 = sqrt(M2_K0+lvpipi.Vect().Mag2());  // Assuming M_K0
+	  double EK0 = sqrt(M2_K0+v0k.P2);  // Assuming M_K0
 	  TLorentzVector lvK0(lvpipi.Vect(),EK0);
 
 	  fillK0X(e,ipV,imuS,lvq,                                // ***** K0 + X
@@ -1690,10 +1770,8 @@ void UserEvent103(PaEvent &e)
     // ****************************************************************
 
     //      *************** P,PI PI,P MASS ASSUMTIONS ***************
-    E1 = sqrt(v13.Mag2()+M2_p); E2 = sqrt(v23.Mag2()+M2_p);
-    TLorentzVector lvp1(v13,E1), lvp2(v23,E2);
-    TLorentzVector lvppi = lvp1 + lvpi2, lvpip = lvpi1 + lvp2;
-    double m_ppi = lvppi.M(), m_pip = lvpip.M();
+    double m_ppi = v0k.m[V0Kine::ppi], m_pip = v0k.m[V0Kine::pip];
+    TLorentzVector lvp1(v13,v0k.Ep1), lvp2(v23,v0k.Ep2);
 
     int winLRange = 0;
     if      (fabs(m_ppi-M_Lam)<dM_Lambda) winLRange |= 0x1;
@@ -1711,12 +1789,9 @@ void UserEvent103(PaEvent &e)
       unsigned short RICHOKs[2] = {0,0}, isNotees[2] = {0,0};
       int pm, iET; double mom; for (pm = 0, iET = iET1, mom = mom1; pm<2;
 				    pm++) { 
-	if (aRs[iET]==0) {
-	  printf("** U3:\a Evt %d,%d Track %d(<-Lambda) RICH not yet checked\n\n",
-		 e.RunNum(),(int)e.UniqueEvNum(),iET); assert(false);
-	}
+	richPlane(e,iET); // Transport to RICH, if not yet done
 	for (iLaL = 0; iLaL<2; iLaL++) {
-	  if (aRs[iET]<0) continue;
+	  if (rPlanes[iET].aR<0) continue;
 	  unsigned short idpm = 0;
 	  if (iLaL==pm) {                   // Evaluate pID
 	    if (mom<piThr*subpThrPmin || pIDPmax<mom) continue;
@@ -1726,17 +1801,15 @@ void UserEvent103(PaEvent &e)
 #  endif
 	    idpm |= 0x1;
 	    if (PIDs[iET]&0x10) {// => LHs are availble
-	      double piLH = richLHs[0][iET], KLH = richLHs[1][iET];
-	      double pLH  = richLHs[2][iET], eLH = richLHs[3][iET];
-	      double elseLH = eLH>piLH?eLH:piLH; if (KLH>elseLH) elseLH = KLH;
+	      int lh = LHIDs[iET];
 	      if (pThr*pIDPmin<mom) {
 		// "pIDPmin" extra tuning knob that we do not have for the KID
-		if (pLH>LHCut*elseLH && pLH>LHBckCut) idpm |= 0x4;
+		if (lh&LHpIDe) idpm |= 0x4;
 	      }
 	      else {
-		bool veto = eLH>subpThrLHVeto || piLH>subpThrLHpiVeto;
+		bool veto = !(lh&LHsubpe) || !(lh&LHsubppi);
 		if (KThr<mom) {// The momentum cut here need not be precise: it only cuts out that relatively small fraction of background that the K's constitute => therefore no need to be efficient.
-		  veto |= KLH>subpThrLHVeto;
+		  veto |= !(lh&LHsubpK);
 		}
 		if (!veto) idpm |= 0x2;
 	      }
@@ -1759,14 +1832,12 @@ void UserEvent103(PaEvent &e)
 	    bool winRange = piThr<mom && mom<PRICHCut;
 	    if (winRange) { RICHOKs[iLaL] |= 0x1<<pm; idpm |= 0x1; }
 	    if (PIDs[iET]&0x10) {
-	      double eLH = richLHs[3][iET], piLH = richLHs[0][iET];
-	      double KLH = richLHs[1][iET], pLH =  richLHs[2][iET];
-	      double hadronLH = KLH>pLH ? KLH : pLH;
-	      if (eLH==0 || // eLH=piLH=0: eVeto even above piThr!
-		  eLH<piLHeVeto*piLH) {
+	      int lh = LHIDs[iET];
+	      if ((lh&LHe0) || // eLH=piLH=0: eVeto even above piThr!
+		  (lh&LHeLT)) {
 		idpm |= 0x2; isNotees[iLaL] |= 0x1<<pm;
 	      }
-	      if (winRange && piLH>LHCut*hadronLH && piLH>LHBckCut) idpm |= 0x4;
+	      if (winRange && (lh&LHpiID)) idpm |= 0x4;
 	    }
 	    else // Absence of RICH block or LH =0: eVeto even above piThr, cf. supra
 	      idpm |= 0x2;
@@ -1829,7 +1900,8 @@ void UserEvent103(PaEvent &e)
 	  printLambdaCuts(V0DsdD[1],V0cthCut[1],V0pTCut[1],10.);
 	}
 	FillLambda(m_ppi,m_pip,                   // ***** Lambda HISTOs *****
-		   s_dist,s_ctheta,primaryPat&0x10,trk1,trk2,Zs>ZTarget+65,papID);
+		   s_dist,s_ctheta,primaryPat&0x10,trk1,trk2,
+		   richPlane(e,iET1),richPlane(e,iET2),Zs>ZTarget+65,papID);
 
 #  ifdef U3_L_HIGHLEVEL      // Lambdas w/ either p or pi in pV
 	if (s_dist>=2 && s_ctheta>=2 && (papID&0x1)) {
@@ -1842,7 +1914,7 @@ void UserEvent103(PaEvent &e)
 	}
 	//                      Lambdas w/ p outside RICH, outside K0
 	if (s_dist>=2 && // (Would be better if!) Tight V0 vertex dist cut
-	    s_ctheta>=2 && !(papID&0x1) && aRs[iET1]<0) {
+	    s_ctheta>=2 && !(papID&0x1) && rPlanes[iET1].aR<0) {
 	  FillLambda(m_ppi,0x4);
 	  if (fabs(m_pipi-M_K0)>.018) // 3 sigma cut, assuming sigma = 6 MeV
 	    FillLambda(m_ppi,0x8);
@@ -1885,12 +1957,12 @@ void UserEvent103(PaEvent &e)
 
 	//                        ***** HISTO (p,pi) SYSTEM KINEMATICS AS A F(m)
 	if (winLRange&0x1) {
-	  double EL = sqrt(M2_Lam+lvppi.Vect().Mag2());
-	  lvLambda = new TLorentzVector(lvppi.Vect(),EL);
+	  double EL = sqrt(M2_Lam+v0k.P2);
+	  lvLambda = new TLorentzVector(lvpipi.Vect(),EL);
 	}
 	if (winLRange&0x2) {
-	  double EL = sqrt(M2_Lam+lvpip.Vect().Mag2());
-	  lvaLambda = new TLorentzVector(lvpip.Vect(),EL);
+	  double EL = sqrt(M2_Lam+v0k.P2);
+	  lvaLambda = new TLorentzVector(lvpipi.Vect(),EL);
 	}
 	double xF[2]; for (iLaL = 0; iLaL<2; iLaL++) {      // ***** FEYNMAN's X
 	  if (!(winLRange&0x1<<iLaL)) continue;
@@ -1969,16 +2041,16 @@ void UserEvent103(PaEvent &e)
 		 pm++) {	      
 	      if (idpOrms[iLaL]&1<<(1-pm)) {
 		int ppi = pm==iLaL ? 0 : 1, mp = 1-2*pm;
-		const vector<Float_t> &aux = trk->vAux();
-		if (aRs[iET]<-1) { // Ensure then "aRs" are meaningful
-		  printf("** U3:\a Evt %d,%d Track %d(<Lambda): Inconsistency: aRs = %d\n",
-			 e.RunNum(),(int)e.UniqueEvNum(),iET,aRs[iET]);
+		const RICHPlane &rp = richPlane(e,iET);
+		if (rp.aR<-1) { // Ensure then RICH plane is meaningful
+		  printf("** U3:\a Evt %d,%d Track %d(<Lambda): Inconsistency: aR = %d\n",
+			 e.RunNum(),(int)e.UniqueEvNum(),iET,rp.aR);
 		  abort();
 		}
-		float tgx = aux[2], tgy = aux[3];
+		float tgx = rp.tgXR, tgy = rp.tgYR;
 		double thRICH = acos(1/sqrt(1.+ tgx*tgx + tgy*tgy));
 		hk_PThL[ppi]->Fill(mom,thRICH);
-		hk_XL[ppi]->Fill(aux[0],mp); hk_YL[ppi]->Fill(aux[1],mp);
+		hk_XL[ppi]->Fill(rp.XR,mp); hk_YL[ppi]->Fill(rp.YR,mp);
 		if (ppi==0 &&
 		    s_dist>=3 && s_ctheta >=3 &&
 		    PIDs[iET]&0x10) {
@@ -2096,15 +2168,9 @@ void UserEvent103(PaEvent &e)
 	if (fabs(m_ppi-M_Lam)>LMassCut) isLambda &= 0x2;
 	if (fabs(m_pip-M_Lam)>LMassCut) isLambda &= 0x1;
 	for (iLaL = 0; iLaL<2; iLaL++) if (1<<iLaL&isLambda) {
-	    TLorentzVector *lvL = 0; // ***** VECTORS w/ *EXCACT* Lambda MASS
-	    if (iLaL==0) {
-	      double EL = sqrt(M2_Lam+lvppi.Vect().Mag2());
-	      lvL = new TLorentzVector(lvppi.Vect(),EL);
-	    }
-	    else {
-	      double EL = sqrt(M2_Lam+lvpip.Vect().Mag2());
-	      lvL = new TLorentzVector(lvpip.Vect(),EL);
-	    }
+	    // ***** VECTORS w/ *EXCACT* Lambda MASS (same 3-momentum for L and aL)
+	    double EL = sqrt(M2_Lam+v0k.P2);
+	    TLorentzVector *lvL = new TLorentzVector(lvpipi.Vect(),EL);
 	    fillLCascades(e,ipV,CovP,imuS,isV,CovS,iET1,iET2,iLaL,lvL,ppiIDs[iLaL],
 			  uDSTSelection);
 	  }
@@ -2142,10 +2208,6 @@ void UserEvent103(PaEvent &e)
     fCSEvtTree->Fill();
 #endif
   }
-
-  delete PIDs; delete tZones; delete aRs; delete richDths;
-  for (i = 0; i<5; i++) { delete richLHs[i]; delete richChi2s[i]; }
-
 }
 //*********************************************************************
 // *************************     parseBestPV    ***********************
@@ -2248,9 +2310,7 @@ void parseBestPV(PaEvent &e, int ipV,
       // Prior to, possibly re-scale momentum, determine exit angle for SM1 and
       // incidence/exit angle for SM2. May need to extrapolate, if so take
       // advantage to set also acceptance by RICH.
-      int zoness = tZones[iETs];
-      if (aRs[iETs]==0) // If not yet done
-	transport(e,trks,aRs[iETs],zoness);
+      richPlane(e,iETs); // Transport to RICH, if not yet done
       TVector3 vS3 = muS->ParInVtx(ipV).Mom3();
       double Es = sqrt(vS3.Mag2()+M2_mu); lvq = lvki-TLorentzVector(vS3,Es);
       double pq = lvp.Dot(lvq), pk = lvp.Dot(lvki);
@@ -2848,34 +2908,33 @@ void fillExclusive(PaEvent &e, int ipV, int imuS,
   // Prior to, possibly re-scale momentum, determine acceptance by RICH and
   // exit angle for SM1 and incidence/exit angle for SM2.
   // (Cf. also comment supra, in V0 block, concenring Marcin's rescaling.)
-  if (aRs[iET1]==0)/* Not yet done? */ transport(e,trk1,aRs[iET1],zones1);
-  if (aRs[iET2]==0)                    transport(e,trk2,aRs[iET2],zones2);
-  if (aRs[iET1]<-1 || aRs[iET2]<-1)
+  richPlane(e,iET1); // Transport to RICH, if not yet done
+  richPlane(e,iET2);
+  if (rPlanes[iET1].aR<-1 || rPlanes[iET2].aR<-1)
     return; // Skip if either track starting downstream of RICH
   const PaTPar &hv1 = pa1->ParInVtx(ipV), &hv2 = pa2->ParInVtx(ipV);
   TVector3 v13 = hv1.Mom3(), v23 = hv2.Mom3();
   // For P @ RICH, best would be a smoothing point in zone 0x2. Next best...
   const PaTPar &hi1 = trk1.vTPar()[0], &hi2 = trk2.vTPar()[0];
   double mom1 = fabs(1/hi1(5)), mom2 = fabs(1/hi2(5));
-  double E1 = sqrt(v13.Mag2()+M2_pi),  E2 = sqrt(v23.Mag2()+M2_pi);
-  TLorentzVector lv1 = TLorentzVector(v13,E1);  // >0 hadron @ vertex
-  TLorentzVector lv2 = TLorentzVector(v23,E2);  // <0 hadron @ vertex
-  TLorentzVector lv0 = lv1 + lv2;               // V0
+  //                ********** pi AND K MASS ASSIGNMENTS, pT, alpha **********
+  const V0Kine v0k(v13.X(),v13.Y(),v13.Z(),v23.X(),v23.Y(),v23.Z());
+  double E1, E2; // (Re-used infra, in E loss correction)
+  TLorentzVector lv1 = TLorentzVector(v13,v0k.Epi1);  // >0 hadron @ vertex
+  TLorentzVector lv2 = TLorentzVector(v23,v0k.Epi2);  // <0 hadron @ vertex
+  TLorentzVector lv0(v0k.P[0],v0k.P[1],v0k.P[2],v0k.E[V0Kine::pipi]); // V0
   TLorentzVector lvPR =  lvp + lvq - lv0;   // Recoil proton assuming pi+pi-
   double dE = ( lvPR.M2() - M_p*M_p ) /2/M_p;   // Inelasticity
-  double pT = lv1.Perp(lv0.Vect());
+  double pT = v0k.pT;
   if (pTCut) {                                                   // ***** pT CUT
     if (pT>pTCut*.001) exclPhiPat |= pTOK;
     exclPhiRequired |= pTOK;
   }
-  double PL1 = sqrt(v13.Mag2()-pT*pT), PL2 = sqrt(v23.Mag2()-pT*pT);
-  double alpha = (PL1-PL2)/(PL1+PL2);
+  double alpha = v0k.alpha;
 
-  //        ********** K MASS ASSIGNMENT **********
-  E1 = sqrt(v13.Mag2()+M2_K); E2 = sqrt(v23.Mag2()+M2_K);
-  TLorentzVector lvK1 = TLorentzVector(v13,E1); // >0 hadron @ vertex
-  TLorentzVector lvK2 = TLorentzVector(v23,E2); // <0 hadron @ vertex
-  TLorentzVector lvKK = lvK1 + lvK2;            // V0
+  TLorentzVector lvK1 = TLorentzVector(v13,v0k.EK1); // >0 hadron @ vertex
+  TLorentzVector lvK2 = TLorentzVector(v23,v0k.EK2); // <0 hadron @ vertex
+  TLorentzVector lvKK(v0k.P[0],v0k.P[1],v0k.P[2],v0k.E[V0Kine::KK]); // V0
   //            ***** BMS: EVALUATE SOME LOW LIMIT OF EMiss
   // - BMS is necessary to get a meaningful selection of exclusive.
   // - Yet we also want here to single out potentially exclusive events lacking
@@ -2922,22 +2981,19 @@ void fillExclusive(PaEvent &e, int ipV, int imuS,
   unsigned short idKpm = 0;  // ID below/above K threshold, 0x1: +, 0x2: -
   unsigned short idpipm = 0; // piID and !eID, 0x1: +, 0x2: -
   int iET; double mom; for (pm = 0, iET = iET1, mom = mom1; pm<2; pm++) { 
-    if (aRs[iET]>0 && piThr<mom && mom<PRICHCut) {
+    if (rPlanes[iET].aR>0 && piThr<mom && mom<PRICHCut) {
       RICHOK |= 0x1<<pm;
       unsigned short idpm =
 	thrMargin*piThr<mom ? 0x1 :// Above pi threshold w/ safety margin...
 	// ...in order to avoid the region where pions generate few photons
 	0;
       if (PIDs[iET]&0x10) {
-	double piLH = richLHs[0][iET], KLH = richLHs[1][iET];
-	double pLH  = richLHs[2][iET], eLH = richLHs[3][iET];
-	double hadronLH = pLH>piLH ? pLH : piLH;
-	double elseLH = eLH>hadronLH ? eLH : hadronLH;
+	int lh = LHIDs[iET];
 	if (thrMargin*piThr<mom && mom<KThr &&
-	    elseLH<subKThrLHpiVeto)                         idpm |= 0x2;
-	if (KThr<mom && KLH>LHBckCut && KLH>hadronLH*LHCut) idpm |= 0x4;
+	    (lh&LHsubKh))                                   idpm |= 0x2;
+	if (KThr<mom && (lh&LHKID))                         idpm |= 0x4;
 	if (!(idpm&0x6) &&
-	    eLH<piLHeVeto*piLH && piLH>pLH*LHCut)           idpipm |= 1<<pm;
+	    (lh&LHeLT) && (lh&LHpip))                       idpipm |= 1<<pm;
       }
       else if (mom<KThr) // Which results in piTHr<P<KThr, w/o margin, this time
 	// Absence of RICH block or LH =0: cf. comment in PID for Lambda
@@ -2950,11 +3006,11 @@ void fillExclusive(PaEvent &e, int ipV, int imuS,
     iET = iET2; mom = mom2;
   }
 
-  double m_KK = lvKK.M();
+  double m_KK = v0k.m[V0Kine::KK];
   // ********** RHO: EXCLUSIVITY, HISTO dE and m_pipi, FILL TTree **********
   unsigned short exclPhiOK = exclPhiPat&exclPhiRequired;
   if ((exclPhiOK|pmHs)==exclPhiRequired) {
-    bool isExcl = dE<dECuts[0]; double m_pipi = lv0.M();
+    bool isExcl = dE<dECuts[0]; double m_pipi = v0k.m[V0Kine::pipi];
     bool winMRange = fabs(m_KK-M_phi)>dM_phi && m_pipi<M_rho+dM_rho;
     bool rhoInvMass = // Here same sign pairs are included
       fabs(m_KK-M_phi)<dM_rho*2/3;
@@ -3029,16 +3085,16 @@ void fillExclusive(PaEvent &e, int ipV, int imuS,
 	for (pm = 0, iET = iET1, trk = &trk1, mom = mom1, lvK = &lvK1; pm<2;
 	     pm++) {
 	  if (idKpm&1<<(1-pm)) {
-	    const vector<Float_t> &aux = trk->vAux();
-	    if (aRs[iET]<-1) { // Ensure then "aRs" are meaningful
-	      printf("** U3:\a Evt %d,%d Track %d(<-phi): Inconsistency: aRs = %d\n",
-		     e.RunNum(),(int)e.UniqueEvNum(),iET,aRs[iET]);
+	    const RICHPlane &rp = richPlane(e,iET);
+	    if (rp.aR<-1) { // Ensure then RICH plane is meaningful
+	      printf("** U3:\a Evt %d,%d Track %d(<-phi): Inconsistency: aR = %d\n",
+		     e.RunNum(),(int)e.UniqueEvNum(),iET,rp.aR);
 	      abort();
 	    }
-	    float tgx = aux[2], tgy = aux[3];
+	    float tgx = rp.tgXR, tgy = rp.tgYR;
 	    double thRICH = acos(1/sqrt(1.+ tgx*tgx + tgy*tgy));
 	    hk_PThphi->Fill(mom,thRICH);
-	    int mp = 1-2*pm; hk_Xphi->Fill(aux[0],mp); hk_Yphi->Fill(aux[1],mp);
+	    int mp = 1-2*pm; hk_Xphi->Fill(rp.XR,mp); hk_Yphi->Fill(rp.YR,mp);
 	    //                                       ***** THETA CHERENKOV vs. P
 	    if (PIDs[iET]&0x10) {
 	      double thC = trk->RichInf(thCIndex);
@@ -3513,6 +3569,8 @@ void bookEphi_RICHPerf(double dM_phi, double phiMassCut)
 			   200,2*M_K-.02,M_phi+dM_phi,2,-.5,1.5);
   }
 
+  // Booked upon first fill, if enabled (cf. "HistoRegistry")
+  int famPS = hReg->Family("phiPS");
   for (int ipa = 0; ipa<nphB; ipa++) {
 
     // *************** KID EFF FOR P > THRES AS A F(PHASE SPACE) ***************
@@ -3546,50 +3604,50 @@ void bookEphi_RICHPerf(double dM_phi, double phiMassCut)
 #  ifdef U3_USE_CHCHI2
       // ********** USING CHI2 CUTS **********
       sprintf(hN,"hC_phioP%c%d",pm?'m':'p',ipa);
-      hC_phioP[pm][ipa]  = new TH2D(hN,string(KK+spm+sChi2KCut+sPABin).c_str(),
+      hC_phioP[pm][ipa]  = hReg->H2(famPS,hN,string(KK+spm+sChi2KCut+sPABin).c_str(),
 				    200,2*M_K-.02,M_phi+dM_phi,2,-.5,1.5);
       // Total: K ID + pi Veto
       sprintf(hN,"hC_phioPT%c%d",pm?'m':'p',ipa);
-      hC_phioPT[pm][ipa] = new TH2D(hN,string(KK+spm+sChi2Cut +sPABin).c_str(),
+      hC_phioPT[pm][ipa] = hReg->H2(famPS,hN,string(KK+spm+sChi2Cut +sPABin).c_str(),
 				    200,2*M_K-.02,M_phi+dM_phi,2,-.5,1.5);
       // pi enhanced rejection (pi Veto)
       sprintf(hN,"hC_phioPV%c%d",pm?'m':'p',ipa);
-      hC_phioPV[pm][ipa] = new TH2D(hN,string(KK+spm+sChi2VCut+sPABin).c_str(),
+      hC_phioPV[pm][ipa] = hReg->H2(famPS,hN,string(KK+spm+sChi2VCut+sPABin).c_str(),
 				    200,2*M_K-.02,M_phi+dM_phi,2,-.5,1.5);
 #  endif
 #  ifdef U3_PLOT_dTheta
       // ********** USING dTheta CUTS **********
       sprintf(hN,"hT_phioP%c%d",pm?'m':'p',ipa);
-      hT_phioP[pm][ipa]  = new TH2D(hN,string(KK+spm+sdTKCut+sPABin).c_str(),
+      hT_phioP[pm][ipa]  = hReg->H2(famPS,hN,string(KK+spm+sdTKCut+sPABin).c_str(),
 				    200,2*M_K-.02,M_phi+dM_phi,2,-.5,1.5);
       // Total: K ID + pi Veto
       sprintf(hN,"hT_phioPT%c%d",pm?'m':'p',ipa);
-      hT_phioPT[pm][ipa] = new TH2D(hN,string(KK+spm+sdTCut +sPABin).c_str(),
+      hT_phioPT[pm][ipa] = hReg->H2(famPS,hN,string(KK+spm+sdTCut +sPABin).c_str(),
 				    200,2*M_K-.02,M_phi+dM_phi,2,-.5,1.5);
       // pi Veto Only
       sprintf(hN,"hT_phioPV%c%d",pm?'m':'p',ipa);
-      hT_phioPV[pm][ipa] = new TH2D(hN,string(KK+spm+spiVCut+sPABin).c_str(),
+      hT_phioPV[pm][ipa] = hReg->H2(famPS,hN,string(KK+spm+spiVCut+sPABin).c_str(),
 				    200,2*M_K-.02,M_phi+dM_phi,2,-.5,1.5);
 #  endif
       // Radius Distribution
       sprintf(hN,"hR_phioP%c%d",pm?'m':'p',ipa);
-      hR_phioP[pm][ipa]  = new TH1D(hN,string(KK+spm+sPABin).c_str(),
+      hR_phioP[pm][ipa]  = hReg->H1(famPS,hN,string(KK+spm+sPABin).c_str(),
 				    80,0,80);
       // Momentum Distribution
       sprintf(hN,"hR_phioA%c%d",pm?'m':'p',ipa);
-      hR_phioA[pm][ipa]  = new TH1D(hN,string(KK+spm+sPABin).c_str(),
+      hR_phioA[pm][ipa]  = hReg->H1(famPS,hN,string(KK+spm+sPABin).c_str(),
 				    80,0,40);
       // ********** USING LH CUTS **********
       sprintf(hN,"hL_phioP%c%d",pm?'m':'p',ipa);
-      hL_phioP[pm][ipa]  = new TH2D(hN,string(KK+spm+sLHKCut+sPABin).c_str(),
+      hL_phioP[pm][ipa]  = hReg->H2(famPS,hN,string(KK+spm+sLHKCut+sPABin).c_str(),
 				    200,2*M_K-.02,M_phi+dM_phi,2,-.5,1.5);
       // Total: K ID + pi Veto
       sprintf(hN,"hL_phioPT%c%d",pm?'m':'p',ipa);
-      hL_phioPT[pm][ipa] = new TH2D(hN,string(KK+spm+sLHCut+sPABin).c_str(),
+      hL_phioPT[pm][ipa] = hReg->H2(famPS,hN,string(KK+spm+sLHCut+sPABin).c_str(),
 				    200,2*M_K-.02,M_phi+dM_phi,2,-.5,1.5);
       // pi enhanced rejection (pi Veto)
       sprintf(hN,"hL_phioPV%c%d",pm?'m':'p',ipa);
-      hL_phioPV[pm][ipa] = new TH2D(hN,string(KK+spm+sLHVCut+sPABin).c_str(),
+      hL_phioPV[pm][ipa] = hReg->H2(famPS,hN,string(KK+spm+sLHVCut+sPABin).c_str(),
 				    200,2*M_K-.02,M_phi+dM_phi,2,-.5,1.5);
     }
   }
@@ -3732,21 +3790,17 @@ void fillEphi_RICHPerf(PaEvent &e, int iET1, int iET2,
   int acc = 0, pRange = 0, pDomain = 0; // Acceptance and p Range (+/-) Flags...
   int pm, iET; const PaTrack *trk; for (pm = 0, iET = iET1, trk = &trk1; pm<2;
 					pm++) {
-    if (aRs[iET]==0) {
- printf("** U3/Ephi RICHPerf:\a Evt %d,%d Track %d RICH not yet checked\n\n",
-	e.RunNum(),(int)e.UniqueEvNum(),iET); assert(false);
-    }
-    if (aRs[iET]>0) acc |= 0x1<<pm;
-    const vector<Float_t> &aux = trk->vAux();
-    if (aRs[iET]<-1) { // Ensure then "aRs" are meaningful
-      printf("** U3:\a Evt %d,%d Track %d(<-Ephi): Inconsistency: aRs = %d\n",
-	     e.RunNum(),(int)e.UniqueEvNum(),iET,aRs[iET]);
+    const RICHPlane &rp = richPlane(e,iET);
+    if (rp.aR>0) acc |= 0x1<<pm;
+    if (rp.aR<-1) { // Ensure then RICH plane is meaningful
+      printf("** U3:\a Evt %d,%d Track %d(<-Ephi): Inconsistency: aR = %d\n",
+	     e.RunNum(),(int)e.UniqueEvNum(),iET,rp.aR);
       abort();
     }
-    double XR = aux[0], YR = aux[1], RR = sqrt(XR*XR+YR*YR);
+    double XR = rp.XR, YR = rp.YR, RR = sqrt(XR*XR+YR*YR);
     *XRs[pm] = XR; *YRs[pm] = YR; *RRs[pm] = RR;
 #  ifndef PS_USE_RADIUS
-    float tgx = aux[2], tgy = aux[3];
+    float tgx = rp.tgXR, tgy = rp.tgYR;
     *ARs[pm] = acos(1/sqrt(1.+ tgx*tgx + tgy*tgy));
 #  endif
     iET = iET2; trk = &trk2;
@@ -3949,13 +4003,13 @@ void fillEphi_RICHPerf(PaEvent &e, int iET1, int iET2,
       if (acc&pDomain&0x1) {// ********** >0 w/in RICH w/in pDOMAIN...**********
 	int ok1 = 0, pv1 = 0;
 	if (chiok1&0x1) ok1 = 1; if (chiok1&0x2) pv1 = 1;
-	hC_phioP[0][0] ->Fill(m_KK,(double)ok1);
-	hC_phioPV[0][0]->Fill(m_KK,(double)pv1);
-	hC_phioPT[0][0]->Fill(m_KK,(double)(ok1&pv1));
+	hReg->Fill(hC_phioP[0][0],m_KK,(double)ok1);
+	hReg->Fill(hC_phioPV[0][0],m_KK,(double)pv1);
+	hReg->Fill(hC_phioPT[0][0],m_KK,(double)(ok1&pv1));
 	//                                ***** w/,w/o VETO, AS A F(PHASE SPACE)
-	hC_phioP[0][iPA1] ->Fill(m_KK,(double)ok1);
-	hC_phioPV[0][iPA1]->Fill(m_KK,(double)pv1);
-	hC_phioPT[0][iPA1]->Fill(m_KK,(double)(ok1&pv1));
+	hReg->Fill(hC_phioP[0][iPA1],m_KK,(double)ok1);
+	hReg->Fill(hC_phioPV[0][iPA1],m_KK,(double)pv1);
+	hReg->Fill(hC_phioPT[0][iPA1],m_KK,(double)(ok1&pv1));
 	if (pRange&0x1) {                 // **********...w/in pRANGE **********
 	  hC_phiM[0]->Fill(m_KK,(double)(ok1&pv1));
 	  hC_phiPD[0][ipd1]->Fill(m_KK,(double)(ok1&pv1));   // ***** AS A F(PD)
@@ -3964,17 +4018,17 @@ void fillEphi_RICHPerf(PaEvent &e, int iET1, int iET2,
       }
 
       if (acc&pDomain&0x2) {// ********** <0 w/in RICH w/in pDOMAIN...**********
-	hR_phioP[1][0]->Fill(RR2); hR_phioP[1][iPA2]->Fill(RR2);
-	hR_phioA[1][0]->Fill(mom2-KThr); hR_phioA[1][iPA2]->Fill(mom2-KThr);
+	hReg->Fill(hR_phioP[1][0],RR2); hReg->Fill(hR_phioP[1][iPA2],RR2);
+	hReg->Fill(hR_phioA[1][0],mom2-KThr); hReg->Fill(hR_phioA[1][iPA2],mom2-KThr);
 	int ok2 = 0, pv2 = 0;
 	if (chiok2&0x1) ok2 = 1; if (chiok2&0x2) pv2 = 1;
-	hC_phioP[1][0] ->Fill(m_KK,(double)ok2);
-	hC_phioPV[1][0]->Fill(m_KK,(double)pv2);
-	hC_phioPT[1][0]->Fill(m_KK,(double)(ok2&pv2));
+	hReg->Fill(hC_phioP[1][0],m_KK,(double)ok2);
+	hReg->Fill(hC_phioPV[1][0],m_KK,(double)pv2);
+	hReg->Fill(hC_phioPT[1][0],m_KK,(double)(ok2&pv2));
 	//                                ***** w/,w/o VETO, AS A F(PHASE SPACE)
-	hC_phioP[1][iPA2] ->Fill(m_KK,(double)ok2);
-	hC_phioPV[1][iPA2]->Fill(m_KK,(double)pv2);
-	hC_phioPT[1][iPA2]->Fill(m_KK,(double)(ok2&pv2));
+	hReg->Fill(hC_phioP[1][iPA2],m_KK,(double)ok2);
+	hReg->Fill(hC_phioPV[1][iPA2],m_KK,(double)pv2);
+	hReg->Fill(hC_phioPT[1][iPA2],m_KK,(double)(ok2&pv2));
 	if (pRange&0x2) {                 // **********...w/in pRANGE **********
 	  hC_phiM[1]->Fill(m_KK,(double)(ok2&pv2));
 	  hC_phiPD[1][ipd2]->Fill(m_KK,(double)(ok2&pv2));   // ***** AS A F(PD)
@@ -3986,26 +4040,26 @@ void fillEphi_RICHPerf(PaEvent &e, int iET1, int iET2,
       // *************** dTheta Eff: OVERALL, f(PHASE SPACE, PD) ***************
 
       if (acc&pDomain&0x1) {// ********** >0 w/in RICH w/in pDOMAIN...**********
-	hT_phioP[0][0] ->Fill(m_KK,(double)(dthok1%2));
-	hT_phioPV[0][0]->Fill(m_KK,(double)(dthok1/2));
-	hT_phioPT[0][0]->Fill(m_KK,(double)(dthok1/3));
+	hReg->Fill(hT_phioP[0][0],m_KK,(double)(dthok1%2));
+	hReg->Fill(hT_phioPV[0][0],m_KK,(double)(dthok1/2));
+	hReg->Fill(hT_phioPT[0][0],m_KK,(double)(dthok1/3));
 	//                                ***** w/,w/o VETO, AS A F(PHASE SPACE)
-	hT_phioP[0][iPA1] ->Fill(m_KK,(double)(dthok1%2));
-	hT_phioPV[0][iPA1]->Fill(m_KK,(double)(dthok1/2));
-	hT_phioPT[0][iPA1]->Fill(m_KK,(double)(dthok1/3));
+	hReg->Fill(hT_phioP[0][iPA1],m_KK,(double)(dthok1%2));
+	hReg->Fill(hT_phioPV[0][iPA1],m_KK,(double)(dthok1/2));
+	hReg->Fill(hT_phioPT[0][iPA1],m_KK,(double)(dthok1/3));
 	if (pRange&0x1) {                 // **********...w/in pRANGE **********
 	  hT_phiM[0]->Fill(m_KK,(double)(dthok1/3));
 	  hT_phiPD[0][ipd1]->Fill(m_KK,(double)(dthok1/3));  // ***** AS A F(PD)
 	}
       }
       if (acc&pDomain&0x2) {// ********** <0 w/in RICH w/in pDOMAIN...**********
-	hT_phioP[1][0] ->Fill(m_KK,(double)(dthok2%2));
-	hT_phioPV[1][0]->Fill(m_KK,(double)(dthok2/2));
-	hT_phioPT[1][0]->Fill(m_KK,(double)(dthok2/3));
+	hReg->Fill(hT_phioP[1][0],m_KK,(double)(dthok2%2));
+	hReg->Fill(hT_phioPV[1][0],m_KK,(double)(dthok2/2));
+	hReg->Fill(hT_phioPT[1][0],m_KK,(double)(dthok2/3));
 	//                                ***** w/,w/o VETO, AS A F(PHASE SPACE)
-	hT_phioP[1][iPA2] ->Fill(m_KK,(double)(dthok2%2));
-	hT_phioPV[1][iPA2]->Fill(m_KK,(double)(dthok2/2));
-	hT_phioPT[1][iPA2]->Fill(m_KK,(double)(dthok2/3));
+	hReg->Fill(hT_phioP[1][iPA2],m_KK,(double)(dthok2%2));
+	hReg->Fill(hT_phioPV[1][iPA2],m_KK,(double)(dthok2/2));
+	hReg->Fill(hT_phioPT[1][iPA2],m_KK,(double)(dthok2/3));
 	if (pRange&0x2) {                 // **********...w/in pRANGE **********
 	  hT_phiM[1]->Fill(m_KK,(double)(dthok2/3));
 	  hT_phiPD[1][ipd2]->Fill(m_KK,(double)(dthok2/3));  // ***** AS A F(PD)
@@ -4015,8 +4069,8 @@ void fillEphi_RICHPerf(PaEvent &e, int iET1, int iET2,
       // ********** LIKELIHOODS **********
 
       if (acc&pDomain&0x1) {// ********** >0 w/in RICH w/in pDOMAIN...**********
-	hR_phioP[0][0]->Fill(RR1);       hR_phioP[0][iPA1]->Fill(RR1);
-	hR_phioA[0][0]->Fill(mom1-KThr); hR_phioA[0][iPA1]->Fill(mom1-KThr);
+	hReg->Fill(hR_phioP[0][0],RR1);       hReg->Fill(hR_phioP[0][iPA1],RR1);
+	hReg->Fill(hR_phioA[0][0],mom1-KThr); hReg->Fill(hR_phioA[0][iPA1],mom1-KThr);
 	//#define DEBUG_SELECTION
 #  ifdef DEBUG_SELECTION
 	static FILE *f = fopen("sel.log","w");
@@ -4025,13 +4079,13 @@ void fillEphi_RICHPerf(PaEvent &e, int iET1, int iET2,
 #  endif
 	int ok1 = 0, pv1 = 0;
 	if (lhok1&0x1) ok1 = 1; if (lhok1&0x2) pv1 = 1;
-	hL_phioP[0][0] ->Fill(m_KK,(double)ok1);
-	hL_phioPV[0][0]->Fill(m_KK,(double)pv1);
-	hL_phioPT[0][0]->Fill(m_KK,(double)(ok1&pv1));
+	hReg->Fill(hL_phioP[0][0],m_KK,(double)ok1);
+	hReg->Fill(hL_phioPV[0][0],m_KK,(double)pv1);
+	hReg->Fill(hL_phioPT[0][0],m_KK,(double)(ok1&pv1));
 	//                                ***** w/,w/o VETO, AS A F(PHASE SPACE)
-	hL_phioP[0][iPA1] ->Fill(m_KK,(double)ok1);
-	hL_phioPV[0][iPA1]->Fill(m_KK,(double)pv1);
-	hL_phioPT[0][iPA1]->Fill(m_KK,(double)(ok1&pv1));
+	hReg->Fill(hL_phioP[0][iPA1],m_KK,(double)ok1);
+	hReg->Fill(hL_phioPV[0][iPA1],m_KK,(double)pv1);
+	hReg->Fill(hL_phioPT[0][iPA1],m_KK,(double)(ok1&pv1));
 	if (pRange&0x1) {                 // **********...w/in pRANGE **********
 	  hL_phiM[0]->Fill(m_KK,(double)(ok1&pv1));
 	  hL_phiPD[0][ipd1]->Fill(m_KK,(double)(ok1&pv1));   // ***** AS A F(PD)
@@ -4051,13 +4105,13 @@ void fillEphi_RICHPerf(PaEvent &e, int iET1, int iET2,
       if (acc&pDomain&0x2) {// ********** <0 w/in RICH w/in pDOMAIN...**********
 	int ok2 = 0, pv2 = 0;
 	if (lhok2&0x1) ok2 = 1; if (lhok2&0x2) pv2 = 1;
-	hL_phioP[1][0] ->Fill(m_KK,(double)ok2);
-	hL_phioPV[1][0]->Fill(m_KK,(double)pv2);
-	hL_phioPT[1][0]->Fill(m_KK,(double)(ok2&pv2));
+	hReg->Fill(hL_phioP[1][0],m_KK,(double)ok2);
+	hReg->Fill(hL_phioPV[1][0],m_KK,(double)pv2);
+	hReg->Fill(hL_phioPT[1][0],m_KK,(double)(ok2&pv2));
 	//                                ***** w/,w/o VETO, AS A F(PHASE SPACE)
-	hL_phioP[1][iPA2] ->Fill(m_KK,(double)ok2);
-	hL_phioPV[1][iPA2]->Fill(m_KK,(double)pv2);
-	hL_phioPT[1][iPA2]->Fill(m_KK,(double)(ok2&pv2));
+	hReg->Fill(hL_phioP[1][iPA2],m_KK,(double)ok2);
+	hReg->Fill(hL_phioPV[1][iPA2],m_KK,(double)pv2);
+	hReg->Fill(hL_phioPT[1][iPA2],m_KK,(double)(ok2&pv2));
 	if (pRange&0x2) {                 // **********...w/in pRANGE **********
 	  hL_phiM[1]->Fill(m_KK,(double)(ok2&pv2));
 	  hL_phiPD[1][ipd2]->Fill(m_KK,(double)(ok2&pv2));   // ***** AS A F(PD)
@@ -4268,6 +4322,8 @@ void bookK0_RICHPerf(double dM_K0, double K0MassCut)
     hL_K0M[pm] = new TH2D(hName,string(pipi+spm+sLHCut+sPRange).c_str(),
 			  150,M_K0-dM_K0,M_K0+dM_K0,2,-.5,1.5);
   }
+  // Booked upon first fill, if enabled (cf. "HistoRegistry")
+  int famPS = hReg->Family("K0PS");
   for (int ipa = 0; ipa<nK0B; ipa++) {
 
     // *************** piID EFF FOR P>THRES AS A F(PHASE SPACE) ***************
@@ -4301,42 +4357,42 @@ void bookK0_RICHPerf(double dM_K0, double K0MassCut)
 #  ifdef U3_PLOT_CHi2
       // ********** USING CHI2 CUTS **********
       sprintf(hN,"hC_K0oP%c%d",pm?'m':'p',ipa);
-      hC_K0oP[pm][ipa] = new TH2D(hN,string(pipi+spm+sChi2piCut+sPABin).c_str(),
+      hC_K0oP[pm][ipa] = hReg->H2(famPS,hN,string(pipi+spm+sChi2piCut+sPABin).c_str(),
 				  150,M_K0-dM_K0,M_K0+dM_K0,2,-.5,1.5);
       // Total: pi ID + K Veto
       sprintf(hN,"hC_K0oPT%c%d",pm?'m':'p',ipa);
-      hC_K0oPT[pm][ipa]= new TH2D(hN,string(pipi+spm+sChi2Cut  +sPABin).c_str(),
+      hC_K0oPT[pm][ipa]= hReg->H2(famPS,hN,string(pipi+spm+sChi2Cut  +sPABin).c_str(),
 				  150,M_K0-dM_K0,M_K0+dM_K0,2,-.5,1.5);
       // Enhance K rejection (K Veto)
       sprintf(hN,"hC_K0oPV%c%d",pm?'m':'p',ipa);
-      hC_K0oPV[pm][ipa]= new TH2D(hN,string(pipi+spm+sChi2VCut +sPABin).c_str(),
+      hC_K0oPV[pm][ipa]= hReg->H2(famPS,hN,string(pipi+spm+sChi2VCut +sPABin).c_str(),
 				  150,M_K0-dM_K0,M_K0+dM_K0,2,-.5,1.5);
 #  endif
 #  ifdef U3_PLOT_dTheta
       // ********** USING dTheta CUTS **********
       sprintf(hN,"hT_K0oP%c%d",pm?'m':'p',ipa);
-      hT_K0oP[pm][ipa] = new TH2D(hN,string(pipi+spm+sdTpiCut+sPABin).c_str(),
+      hT_K0oP[pm][ipa] = hReg->H2(famPS,hN,string(pipi+spm+sdTpiCut+sPABin).c_str(),
 				  150,M_K0-dM_K0,M_K0+dM_K0,2,-.5,1.5);
       // Total: pi ID + K Veto
       sprintf(hN,"hT_K0oPT%c%d",pm?'m':'p',ipa);
-      hT_K0oPT[pm][ipa]= new TH2D(hN,string(pipi+spm+sdTCut  +sPABin).c_str(),
+      hT_K0oPT[pm][ipa]= hReg->H2(famPS,hN,string(pipi+spm+sdTCut  +sPABin).c_str(),
 				  150,M_K0-dM_K0,M_K0+dM_K0,2,-.5,1.5);
       // K Veto Only
       sprintf(hN,"hT_K0oPV%c%d",pm?'m':'p',ipa);
-      hT_K0oPV[pm][ipa]= new TH2D(hN,string(pipi+spm+sKVCut  +sPABin).c_str(),
+      hT_K0oPV[pm][ipa]= hReg->H2(famPS,hN,string(pipi+spm+sKVCut  +sPABin).c_str(),
 				  150,M_K0-dM_K0,M_K0+dM_K0,2,-.5,1.5);
 #  endif
       // ***** USING LH CUTS *****
       sprintf(hN,"hL_K0oP%c%d",pm?'m':'p',ipa);
-      hL_K0oP[pm][ipa] = new TH2D(hN,string(pipi+spm+sLHpiCut+sPABin).c_str(),
+      hL_K0oP[pm][ipa] = hReg->H2(famPS,hN,string(pipi+spm+sLHpiCut+sPABin).c_str(),
 				  150,M_K0-dM_K0,M_K0+dM_K0,2,-.5,1.5);
       // Total: pi ID + K Veto
       sprintf(hN,"hL_K0oPT%c%d",pm?'m':'p',ipa);
-      hL_K0oPT[pm][ipa]= new TH2D(hN,string(pipi+spm+sLHCut  +sPABin).c_str(),
+      hL_K0oPT[pm][ipa]= hReg->H2(famPS,hN,string(pipi+spm+sLHCut  +sPABin).c_str(),
 				  150,M_K0-dM_K0,M_K0+dM_K0,2,-.5,1.5);
       // K enhanced rejection (K veto)
       sprintf(hN,"hL_K0oPV%c%d",pm?'m':'p',ipa);
-      hL_K0oPV[pm][ipa]= new TH2D(hN,string(pipi+spm+sLHVCut +sPABin).c_str(),
+      hL_K0oPV[pm][ipa]= hReg->H2(famPS,hN,string(pipi+spm+sLHVCut +sPABin).c_str(),
 				  150,M_K0-dM_K0,M_K0+dM_K0,2,-.5,1.5);
     }
   }
@@ -4505,6 +4561,8 @@ void bookK0_RICHPur(double dM_K0)
     hM_K0S[pm] = new TH2D(hName,string(pipi+spm+sLHSCut+sPSub).c_str(),
 			  150,M_K0-dM_K0,M_K0+dM_K0,2,-.5,1.5);
   }
+  // Booked upon first fill, if enabled (cf. "HistoRegistry")
+  int famPS = hReg->Family("K0PurPS");
   for (int ipa = 0; ipa<nphB; ipa++) {
 
     // *************** KmisID EFF FOR P>THR AS A F(PHASE SPACE) ***************
@@ -4538,50 +4596,50 @@ void bookK0_RICHPur(double dM_K0)
 #  ifdef U3_PLOT_CHi2
       // ********** USING CHI2 CUTS **********
       sprintf(hN,"hD_K0oP%c%d",pm?'m':'p',ipa);
-      hD_K0oP[pm][ipa]  = new TH2D(hN,string(pipi+spm+sChi2KCut+sPABin).c_str(),
+      hD_K0oP[pm][ipa]  = hReg->H2(famPS,hN,string(pipi+spm+sChi2KCut+sPABin).c_str(),
 				   150,M_K0-dM_K0,M_K0+dM_K0,2,-.5,1.5);
       // Total: K ID + pi Veto
       sprintf(hN,"hD_K0oPT%c%d",pm?'m':'p',ipa);
-      hD_K0oPT[pm][ipa] = new TH2D(hN,string(pipi+spm+sChi2Cut +sPABin).c_str(),
+      hD_K0oPT[pm][ipa] = hReg->H2(famPS,hN,string(pipi+spm+sChi2Cut +sPABin).c_str(),
 				   150,M_K0-dM_K0,M_K0+dM_K0,2,-.5,1.5);
       // Enhance pi rejection (pi Veto)
       sprintf(hN,"hD_K0oPV%c%d",pm?'m':'p',ipa);
-      hD_K0oPV[pm][ipa] = new TH2D(hN,string(pipi+spm+sChi2VCut+sPABin).c_str(),
+      hD_K0oPV[pm][ipa] = hReg->H2(famPS,hN,string(pipi+spm+sChi2VCut+sPABin).c_str(),
 				   150,M_K0-dM_K0,M_K0+dM_K0,2,-.5,1.5);
 #  endif
 #  ifdef U3_PLOT_dTheta
       // ********** USING dTheta CUTS **********
       sprintf(hN,"hU_K0oP%c%d",pm?'m':'p',ipa);
-      hU_K0oP[pm][ipa]  = new TH2D(hN,string(pipi+spm+sdTKCut+sPABin).c_str(),
+      hU_K0oP[pm][ipa]  = hReg->H2(famPS,hN,string(pipi+spm+sdTKCut+sPABin).c_str(),
 				   150,M_K0-dM_K0,M_K0+dM_K0,2,-.5,1.5);
       // Total: K ID + pi Veto
       sprintf(hN,"hU_K0oPT%c%d",pm?'m':'p',ipa);
-      hU_K0oPT[pm][ipa] = new TH2D(hN,string(pipi+spm+sdTCut +sPABin).c_str(),
+      hU_K0oPT[pm][ipa] = hReg->H2(famPS,hN,string(pipi+spm+sdTCut +sPABin).c_str(),
 				   150,M_K0-dM_K0,M_K0+dM_K0,2,-.5,1.5);
       // pi Veto Only
       sprintf(hN,"hU_K0oPV%c%d",pm?'m':'p',ipa);
-      hU_K0oPV[pm][ipa] = new TH2D(hN,string(pipi+spm+spiVCut+sPABin).c_str(),
+      hU_K0oPV[pm][ipa] = hReg->H2(famPS,hN,string(pipi+spm+spiVCut+sPABin).c_str(),
 				   150,M_K0-dM_K0,M_K0+dM_K0,2,-.5,1.5);
 #  endif
       // Radius Distribution
       sprintf(hN,"hR_K0oP%c%d",pm?'m':'p',ipa);
-      hR_K0oP[pm][ipa]= new TH1D(hN,string(pipi+spm+sPABin).c_str(),
+      hR_K0oP[pm][ipa]= hReg->H1(famPS,hN,string(pipi+spm+sPABin).c_str(),
 				 80,0,80);
       // Momentum Distribution
       sprintf(hN,"hR_K0oA%c%d",pm?'m':'p',ipa);
-      hR_K0oA[pm][ipa]= new TH1D(hN,string(pipi+spm+sPABin).c_str(),
+      hR_K0oA[pm][ipa]= hReg->H1(famPS,hN,string(pipi+spm+sPABin).c_str(),
 				 80,0,40);
       // ********** USING LH CUTS **********
       sprintf(hN,"hM_K0oP%c%d",pm?'m':'p',ipa);
-      hM_K0oP[pm][ipa]  = new TH2D(hN,string(pipi+spm+sLHKCut+sPABin).c_str(),
+      hM_K0oP[pm][ipa]  = hReg->H2(famPS,hN,string(pipi+spm+sLHKCut+sPABin).c_str(),
 				   150,M_K0-dM_K0,M_K0+dM_K0,2,-.5,1.5);
       // Total: K ID + pi Veto
       sprintf(hN,"hM_K0oPT%c%d",pm?'m':'p',ipa);
-      hM_K0oPT[pm][ipa] = new TH2D(hN,string(pipi+spm+sLHCut +sPABin).c_str(),
+      hM_K0oPT[pm][ipa] = hReg->H2(famPS,hN,string(pipi+spm+sLHCut +sPABin).c_str(),
 				   150,M_K0-dM_K0,M_K0+dM_K0,2,-.5,1.5);
       // Enhanced pi rejection (pi Veto)
       sprintf(hN,"hM_K0oPV%c%d",pm?'m':'p',ipa);
-      hM_K0oPV[pm][ipa] = new TH2D(hN,string(pipi+spm+sLHVCut+sPABin).c_str(),
+      hM_K0oPV[pm][ipa] = hReg->H2(famPS,hN,string(pipi+spm+sLHVCut+sPABin).c_str(),
 				   150,M_K0-dM_K0,M_K0+dM_K0,2,-.5,1.5);
     }
   }
@@ -4650,16 +4708,12 @@ void fillK0_RICHPerf(PaEvent &e, int iET1, int iET2,
   int acc = 0, pRange = 0, pDomain = 0; // Acceptance and p Range (+/-) Flags...
   int pm, iET; const PaTrack *trk; for (pm = 0, iET = iET1, trk = &trk1; pm<2;
 					pm++) {
-    if (aRs[iET]==0) {
- printf("** U3/K0 RICHPerf:\a Evt %d,%d Track %d RICH not yet checked\n\n",
-	e.RunNum(),(int)e.UniqueEvNum(),iET); assert(false);
-    }
-    if (aRs[iET]>0) acc |= 0x1<<pm;
-    const vector<Float_t> &aux = trk->vAux();
-    double XR = aux[0], YR = aux[1], RR = sqrt(XR*XR+YR*YR);
+    const RICHPlane &rp = richPlane(e,iET);
+    if (rp.aR>0) acc |= 0x1<<pm;
+    double XR = rp.XR, YR = rp.YR, RR = sqrt(XR*XR+YR*YR);
     *XRs[pm] = XR; *YRs[pm] = YR; *RRs[pm] = RR;
 #  ifndef PS_USE_RADIUS
-    float tgx = aux[2], tgy = aux[3];
+    float tgx = rp.tgXR, tgy = rp.tgYR;
     *ARs[pm] = acos(1/sqrt(1.+ tgx*tgx + tgy*tgy));
 #  endif
     iET = iET2; trk = &trk2;
@@ -4904,13 +4958,13 @@ void fillK0_RICHPerf(PaEvent &e, int iET1, int iET2,
       if (acc&pDomain&0x1) {// ********** >0 w/in RICH w/in pDOMAIN...**********
 	int ok1 = 0, pv1 = 0;
 	if (chiok1&0x1) ok1 = 1; if (chiok1&0x2) pv1 = 1;
-	hC_K0oP[0][0] ->Fill(m_pipi,(double)ok1);
-	hC_K0oPV[0][0]->Fill(m_pipi,(double)pv1);
-	hC_K0oPT[0][0]->Fill(m_pipi,(double)(ok1&pv1));
+	hReg->Fill(hC_K0oP[0][0],m_pipi,(double)ok1);
+	hReg->Fill(hC_K0oPV[0][0],m_pipi,(double)pv1);
+	hReg->Fill(hC_K0oPT[0][0],m_pipi,(double)(ok1&pv1));
 	//                                ***** w/,w/o VETO, AS A F(PHASE SPACE)
-	hC_K0oP[0][iPA1] ->Fill(m_pipi,(double)ok1);
-	hC_K0oPV[0][iPA1]->Fill(m_pipi,(double)pv1);
-	hC_K0oPT[0][iPA1]->Fill(m_pipi,(double)(ok1&pv1));
+	hReg->Fill(hC_K0oP[0][iPA1],m_pipi,(double)ok1);
+	hReg->Fill(hC_K0oPV[0][iPA1],m_pipi,(double)pv1);
+	hReg->Fill(hC_K0oPT[0][iPA1],m_pipi,(double)(ok1&pv1));
 	if (pRange&0x1) {                 // **********...w/in pRANGE **********
 	  hC_K0M[0]->Fill(m_pipi,(double)(ok1&pv1));
 	  hC_K0PD[0][ipd1]->Fill(m_pipi,(double)(ok1&pv1));  // ***** AS A F(PD)
@@ -4918,17 +4972,17 @@ void fillK0_RICHPerf(PaEvent &e, int iET1, int iET2,
 	if (KThr<mom1 &&              // ***** ...AND w/in K RANGE... *****
 	    lhok2==0x3 &&             // ***** ...AND pi-ID to get a pi+ beam
 	    cleanV0) {   // ***** ... AND cleanV0: 'cause p>KThr gets it dirtier
-	  hR_K0oP[0][0]->Fill(RR1); hR_K0oP[0][jPA1]->Fill(RR1); 
-	  hR_K0oA[0][0]->Fill(mom1-KThr); hR_K0oA[0][jPA1]->Fill(mom1-KThr); 
+	  hReg->Fill(hR_K0oP[0][0],RR1); hReg->Fill(hR_K0oP[0][jPA1],RR1); 
+	  hReg->Fill(hR_K0oA[0][0],mom1-KThr); hReg->Fill(hR_K0oA[0][jPA1],mom1-KThr); 
 	  int ok1 = 0, pv1 = 0;       // ***** ...K misID Eff *****
 	  if (chiKok1&0x1) ok1 = 1; if (chiKok1&0x2) pv1 = 1;
-	  hD_K0oP[0][0] ->Fill(m_pipi,(double)ok1);
-	  hD_K0oPV[0][0]->Fill(m_pipi,(double)pv1);
-	  hD_K0oPT[0][0]->Fill(m_pipi,(double)(ok1&pv1));
+	  hReg->Fill(hD_K0oP[0][0],m_pipi,(double)ok1);
+	  hReg->Fill(hD_K0oPV[0][0],m_pipi,(double)pv1);
+	  hReg->Fill(hD_K0oPT[0][0],m_pipi,(double)(ok1&pv1));
 	  //                              ***** w/,w/o VETO, AS A F(PHASE SPACE)
-	  hD_K0oP[0][jPA1] ->Fill(m_pipi,(double)ok1);
-	  hD_K0oPV[0][jPA1]->Fill(m_pipi,(double)pv1);
-	  hD_K0oPT[0][jPA1]->Fill(m_pipi,(double)(ok1&pv1));
+	  hReg->Fill(hD_K0oP[0][jPA1],m_pipi,(double)ok1);
+	  hReg->Fill(hD_K0oPV[0][jPA1],m_pipi,(double)pv1);
+	  hReg->Fill(hD_K0oPT[0][jPA1],m_pipi,(double)(ok1&pv1));
 	  if (pRange&0x1) {               // **********...w/in pRANGE **********
 	    hD_K0M[0]->Fill(m_pipi,(double)(ok1&pv1));
 	    hD_K0PD[0][ipd1]->Fill(m_pipi,(double)(ok1&pv1));// ***** AS A F(PD)
@@ -4942,13 +4996,13 @@ void fillK0_RICHPerf(PaEvent &e, int iET1, int iET2,
       if (acc&pDomain&0x2) {// ********** <0 w/in RICH w/in pDOMAIN...**********
 	int ok2 = 0, pv2 = 0;
 	if (chiok2&0x1) ok2 = 1; if (chiok2&0x2) pv2 = 1;
-	hC_K0oP[1][0] ->Fill(m_pipi,(double)ok2);
-	hC_K0oPV[1][0]->Fill(m_pipi,(double)pv2);
-	hC_K0oPT[1][0]->Fill(m_pipi,(double)(ok2&pv2));
+	hReg->Fill(hC_K0oP[1][0],m_pipi,(double)ok2);
+	hReg->Fill(hC_K0oPV[1][0],m_pipi,(double)pv2);
+	hReg->Fill(hC_K0oPT[1][0],m_pipi,(double)(ok2&pv2));
 	//                                ***** w/,w/o VETO, AS A F(PHASE SPACE)
-	hC_K0oP[1][iPA2] ->Fill(m_pipi,(double)ok2);
-	hC_K0oPV[1][iPA2]->Fill(m_pipi,(double)pv2);
-	hC_K0oPT[1][iPA2]->Fill(m_pipi,(double)(ok2&pv2));
+	hReg->Fill(hC_K0oP[1][iPA2],m_pipi,(double)ok2);
+	hReg->Fill(hC_K0oPV[1][iPA2],m_pipi,(double)pv2);
+	hReg->Fill(hC_K0oPT[1][iPA2],m_pipi,(double)(ok2&pv2));
 	if (pRange&0x2) {                 // **********...w/in pRANGE **********
 	  hC_K0M[1]->Fill(m_pipi,(double)(ok2&pv2));
 	  hC_K0PD[1][ipd2]->Fill(m_pipi,(double)(ok2&pv2));  // ***** AS A F(PD)
@@ -4956,17 +5010,17 @@ void fillK0_RICHPerf(PaEvent &e, int iET1, int iET2,
 	if (KThr<mom2 &&              // ***** ...AND w/in K RANGE... *****
 	    lhok1==0x3 &&             // ***** ...AND pi+ID to get a pi- beam
 	    cleanV0) {   // ***** ... AND cleanV0: 'cause p>KThr gets it dirtier
-	  hR_K0oP[1][0]->Fill(RR2); hR_K0oP[1][jPA2]->Fill(RR2); 
-	  hR_K0oA[1][0]->Fill(mom2-KThr); hR_K0oA[1][jPA2]->Fill(mom2-KThr); 
+	  hReg->Fill(hR_K0oP[1][0],RR2); hReg->Fill(hR_K0oP[1][jPA2],RR2); 
+	  hReg->Fill(hR_K0oA[1][0],mom2-KThr); hReg->Fill(hR_K0oA[1][jPA2],mom2-KThr); 
 	  int ok2 = 0, pv2 = 0;       // ***** ...K misID Eff *****
 	  if (chiKok2&0x1) ok2 = 1; if (chiKok2&0x2) pv2 = 1;
-	  hD_K0oP[1][0] ->Fill(m_pipi,(double)ok2);
-	  hD_K0oPV[1][0]->Fill(m_pipi,(double)pv2);
-	  hD_K0oPT[1][0]->Fill(m_pipi,(double)(ok2&pv2));
+	  hReg->Fill(hD_K0oP[1][0],m_pipi,(double)ok2);
+	  hReg->Fill(hD_K0oPV[1][0],m_pipi,(double)pv2);
+	  hReg->Fill(hD_K0oPT[1][0],m_pipi,(double)(ok2&pv2));
 	  //                              ***** w/,w/o VETO, AS A F(PHASE SPACE)
-	  hD_K0oP[1][jPA2] ->Fill(m_pipi,(double)ok2);
-	  hD_K0oPV[1][jPA2]->Fill(m_pipi,(double)pv2);
-	  hD_K0oPT[1][jPA2]->Fill(m_pipi,(double)(ok2&pv2));
+	  hReg->Fill(hD_K0oP[1][jPA2],m_pipi,(double)ok2);
+	  hReg->Fill(hD_K0oPV[1][jPA2],m_pipi,(double)pv2);
+	  hReg->Fill(hD_K0oPT[1][jPA2],m_pipi,(double)(ok2&pv2));
 	  if (pRange&0x2) {               // **********...w/in pRANGE **********
 	    hD_K0M[1]->Fill(m_pipi,(double)(ok2&pv2));
 	    hD_K0PD[1][ipd2]->Fill(m_pipi,(double)(ok2&pv2));// ***** AS A F(PD)
@@ -4982,13 +5036,13 @@ void fillK0_RICHPerf(PaEvent &e, int iET1, int iET2,
       // ********** dTheta Perf: OVERALL, f(PHASE SPACE), f(PD) **********
 
       if (acc&pDomain&0x1) {// ********** >0 w/in RICH w/in pDOMAIN...**********
-	hT_K0oP[0][0] ->Fill(m_pipi,(double)(dthok1%2));
-	hT_K0oPV[0][0]->Fill(m_pipi,(double)(dthok1/2));
-	hT_K0oPT[0][0]->Fill(m_pipi,(double)(dthok1/3));
+	hReg->Fill(hT_K0oP[0][0],m_pipi,(double)(dthok1%2));
+	hReg->Fill(hT_K0oPV[0][0],m_pipi,(double)(dthok1/2));
+	hReg->Fill(hT_K0oPT[0][0],m_pipi,(double)(dthok1/3));
 	//                                ***** w/,w/o VETO, AS A F(PHASE SPACE)
-	hT_K0oP[0][iPA1] ->Fill(m_pipi,(double)(dthok1%2));
-	hT_K0oPV[0][iPA1]->Fill(m_pipi,(double)(dthok1/2));
-	hT_K0oPT[0][iPA1]->Fill(m_pipi,(double)(dthok1/3));
+	hReg->Fill(hT_K0oP[0][iPA1],m_pipi,(double)(dthok1%2));
+	hReg->Fill(hT_K0oPV[0][iPA1],m_pipi,(double)(dthok1/2));
+	hReg->Fill(hT_K0oPT[0][iPA1],m_pipi,(double)(dthok1/3));
 	if (pRange&0x1) {                 // **********...w/in pRANGE **********
 	  hT_K0M[0]->Fill(m_pipi,(double)(dthok1/3));
 	  hT_K0PD[0][ipd1]->Fill(m_pipi,(double)(dthok1/3)); // ***** AS A F(PD)
@@ -4997,25 +5051,25 @@ void fillK0_RICHPerf(PaEvent &e, int iET1, int iET2,
 	    lhok2==0x3 &&             // ***** ...AND pi-ID to get a pi+ beam
 	    cleanV0) {   // ***** ... AND cleanV0: 'cause p>KThr gets it dirtier
 	  //                             ***** ...K misID Eff *****
-	  hU_K0oP[0][0] ->Fill(m_pipi,(double)(dthKok1%2));
-	  hU_K0oPV[0][0]->Fill(m_pipi,(double)(dthKok1/2));
-	  hU_K0oPT[0][0]->Fill(m_pipi,(double)(dthKok1/3));
+	  hReg->Fill(hU_K0oP[0][0],m_pipi,(double)(dthKok1%2));
+	  hReg->Fill(hU_K0oPV[0][0],m_pipi,(double)(dthKok1/2));
+	  hReg->Fill(hU_K0oPT[0][0],m_pipi,(double)(dthKok1/3));
 	  //                              ***** w/,w/o VETO, AS A F(PHASE SPACE)
-	  hU_K0oP[0][jPA1] ->Fill(m_pipi,(double)(dthKok1%2));
-	  hU_K0oPV[0][jPA1]->Fill(m_pipi,(double)(dthKok1/2));
-	  hU_K0oPT[0][jPA1]->Fill(m_pipi,(double)(dthKok1/3));
+	  hReg->Fill(hU_K0oP[0][jPA1],m_pipi,(double)(dthKok1%2));
+	  hReg->Fill(hU_K0oPV[0][jPA1],m_pipi,(double)(dthKok1/2));
+	  hReg->Fill(hU_K0oPT[0][jPA1],m_pipi,(double)(dthKok1/3));
 	  if (pRange&0x1)                 // **********...w/in pRANGE **********
 	    hU_K0PD[0][ipd1]->Fill(m_pipi,(double)(dthKok1/3));// ***** AS A F(PD)
 	}
       }
       if (acc&pDomain&0x2) {// ********** <0 w/in RICH w/in pDOMAIN...**********
-	hT_K0oP[1][0] ->Fill(m_pipi,(double)(dthok2%2));
-	hT_K0oPV[1][0]->Fill(m_pipi,(double)(dthok2/2));
-	hT_K0oPT[1][0]->Fill(m_pipi,(double)(dthok2/3));
+	hReg->Fill(hT_K0oP[1][0],m_pipi,(double)(dthok2%2));
+	hReg->Fill(hT_K0oPV[1][0],m_pipi,(double)(dthok2/2));
+	hReg->Fill(hT_K0oPT[1][0],m_pipi,(double)(dthok2/3));
 	//                                ***** w/,w/o VETO, AS A F(PHASE SPACE)
-	hT_K0oP[1][iPA2] ->Fill(m_pipi,(double)(dthok2%2));
-	hT_K0oPV[1][iPA2]->Fill(m_pipi,(double)(dthok2/2));
-	hT_K0oPT[1][iPA2]->Fill(m_pipi,(double)(dthok2/3));
+	hReg->Fill(hT_K0oP[1][iPA2],m_pipi,(double)(dthok2%2));
+	hReg->Fill(hT_K0oPV[1][iPA2],m_pipi,(double)(dthok2/2));
+	hReg->Fill(hT_K0oPT[1][iPA2],m_pipi,(double)(dthok2/3));
 	if (pRange&0x2) {                 // **********...w/in pRANGE **********
 	  hT_K0M[1]->Fill(m_pipi,(double)(dthok2/3));
 	  hT_K0PD[1][ipd2]->Fill(m_pipi,(double)(dthok2/3)); // ***** AS A F(PD)
@@ -5024,13 +5078,13 @@ void fillK0_RICHPerf(PaEvent &e, int iET1, int iET2,
 	    lhok1==0x3 &&             // ***** ...AND pi+ID to get a pi- beam
 	    cleanV0) {   // ***** ... AND cleanV0: 'cause p>KThr gets it dirtier
 	  //                             ***** ...K misID Eff *****
-	  hU_K0oP[1][0] ->Fill(m_pipi,(double)(dthKok2%2));
-	  hU_K0oPV[1][0]->Fill(m_pipi,(double)(dthKok2/2));
-	  hU_K0oPT[1][0]->Fill(m_pipi,(double)(dthKok2/3));
+	  hReg->Fill(hU_K0oP[1][0],m_pipi,(double)(dthKok2%2));
+	  hReg->Fill(hU_K0oPV[1][0],m_pipi,(double)(dthKok2/2));
+	  hReg->Fill(hU_K0oPT[1][0],m_pipi,(double)(dthKok2/3));
 	  //                              ***** w/,w/o VETO, AS A F(PHASE SPACE)
-	  hU_K0oP[1][jPA2] ->Fill(m_pipi,(double)(dthKok2%2));
-	  hU_K0oPV[1][jPA2]->Fill(m_pipi,(double)(dthKok2/2));
-	  hU_K0oPT[1][jPA2]->Fill(m_pipi,(double)(dthKok2/3));
+	  hReg->Fill(hU_K0oP[1][jPA2],m_pipi,(double)(dthKok2%2));
+	  hReg->Fill(hU_K0oPV[1][jPA2],m_pipi,(double)(dthKok2/2));
+	  hReg->Fill(hU_K0oPT[1][jPA2],m_pipi,(double)(dthKok2/3));
 	  if (pRange&0x2)                 // **********...w/in pRANGE **********
 	    hU_K0PD[1][ipd2]->Fill(m_pipi,(double)(dthKok2/3));// ***** AS A F(PD)
 	}
@@ -5062,13 +5116,13 @@ void fillK0_RICHPerf(PaEvent &e, int iET1, int iET2,
       if (acc&pDomain&0x1) {// ********** >0 w/in RICH w/in pDOMAIN...**********
 	int ok1 = 0, pv1 = 0;
 	if (lhok1&0x1) ok1 = 1; if (lhok1&0x2) pv1 = 1;
-	hL_K0oP[0][0] ->Fill(m_pipi,(double)ok1);
-	hL_K0oPV[0][0]->Fill(m_pipi,(double)pv1);
-	hL_K0oPT[0][0]->Fill(m_pipi,(double)(ok1&pv1));
+	hReg->Fill(hL_K0oP[0][0],m_pipi,(double)ok1);
+	hReg->Fill(hL_K0oPV[0][0],m_pipi,(double)pv1);
+	hReg->Fill(hL_K0oPT[0][0],m_pipi,(double)(ok1&pv1));
 	//                                ***** w/,w/o VETO, AS A F(PHASE SPACE)
-	hL_K0oP[0][iPA1] ->Fill(m_pipi,(double)ok1);
-	hL_K0oPV[0][iPA1]->Fill(m_pipi,(double)pv1);
-	hL_K0oPT[0][iPA1]->Fill(m_pipi,(double)(ok1&pv1));
+	hReg->Fill(hL_K0oP[0][iPA1],m_pipi,(double)ok1);
+	hReg->Fill(hL_K0oPV[0][iPA1],m_pipi,(double)pv1);
+	hReg->Fill(hL_K0oPT[0][iPA1],m_pipi,(double)(ok1&pv1));
 	if (pRange&0x1) {                 // **********...w/in pRANGE **********
 	  hL_K0M[0]->Fill(m_pipi,(double)(ok1&pv1));        // pi+ Likelihood ID
 	  hL_K0PD[0][ipd1]->Fill(m_pipi,(double)(ok1&pv1));  // ***** AS A F(PD)
@@ -5079,13 +5133,13 @@ void fillK0_RICHPerf(PaEvent &e, int iET1, int iET2,
 	  //                             ***** ...K misID Eff *****
 	  int ok1 = 0, pv1 = 0;       // ***** ...K misID Eff *****
 	  if (lhKok1&0x1) ok1 = 1; if (lhKok1&0x2) pv1 = 1;
-	  hM_K0oP[0][0] ->Fill(m_pipi,(double)ok1);
-	  hM_K0oPV[0][0]->Fill(m_pipi,(double)pv1);
-	  hM_K0oPT[0][0]->Fill(m_pipi,(double)(ok1&pv1));
+	  hReg->Fill(hM_K0oP[0][0],m_pipi,(double)ok1);
+	  hReg->Fill(hM_K0oPV[0][0],m_pipi,(double)pv1);
+	  hReg->Fill(hM_K0oPT[0][0],m_pipi,(double)(ok1&pv1));
 	  //                              ***** w/,w/o VETO, AS A F(PHASE SPACE)
-	  hM_K0oP[0][jPA1] ->Fill(m_pipi,(double)ok1);
-	  hM_K0oPV[0][jPA1]->Fill(m_pipi,(double)pv1);
-	  hM_K0oPT[0][jPA1]->Fill(m_pipi,(double)(ok1&pv1));
+	  hReg->Fill(hM_K0oP[0][jPA1],m_pipi,(double)ok1);
+	  hReg->Fill(hM_K0oPV[0][jPA1],m_pipi,(double)pv1);
+	  hReg->Fill(hM_K0oPT[0][jPA1],m_pipi,(double)(ok1&pv1));
 	  if (pRange&0x1) {               // **********...w/in pRANGE **********
 	    hM_K0M[0]->Fill(m_pipi,(double)(ok1&pv1));
 	    hM_K0PD[0][ipd1]->Fill(m_pipi,(double)(ok1&pv1));// ***** AS A F(PD)
@@ -5101,13 +5155,13 @@ void fillK0_RICHPerf(PaEvent &e, int iET1, int iET2,
       if (acc&pDomain&0x2) {// ********** <0 w/in RICH w/in pDOMAIN...**********
 	int ok2 = 0, pv2 = 0;
 	if (lhok2&0x1) ok2 = 1; if (lhok2&0x2) pv2 = 1;
-	hL_K0oP[1][0] ->Fill(m_pipi,(double)ok2);
-	hL_K0oPV[1][0]->Fill(m_pipi,(double)pv2);
-	hL_K0oPT[1][0]->Fill(m_pipi,(double)(ok2&pv2));
+	hReg->Fill(hL_K0oP[1][0],m_pipi,(double)ok2);
+	hReg->Fill(hL_K0oPV[1][0],m_pipi,(double)pv2);
+	hReg->Fill(hL_K0oPT[1][0],m_pipi,(double)(ok2&pv2));
 	//                                ***** w/,w/o VETO, AS A F(PHASE SPACE)
-	hL_K0oP[1][iPA2] ->Fill(m_pipi,(double)ok2);
-	hL_K0oPV[1][iPA2]->Fill(m_pipi,(double)pv2);
-	hL_K0oPT[1][iPA2]->Fill(m_pipi,(double)(ok2&pv2));
+	hReg->Fill(hL_K0oP[1][iPA2],m_pipi,(double)ok2);
+	hReg->Fill(hL_K0oPV[1][iPA2],m_pipi,(double)pv2);
+	hReg->Fill(hL_K0oPT[1][iPA2],m_pipi,(double)(ok2&pv2));
 	if (pRange&0x2) {                 // **********...w/in pRANGE **********
 	  hL_K0M[1]->Fill(m_pipi,(double)(ok2&pv2));
 	  hL_K0PD[1][ipd2]->Fill(m_pipi,(double)(ok2&pv2));  // ***** AS A F(PD)
@@ -5118,13 +5172,13 @@ void fillK0_RICHPerf(PaEvent &e, int iET1, int iET2,
 	  //                             ***** ...K misID Eff *****
 	  int ok2 = 0, pv2 = 0;       // ***** ...K misID Eff *****
 	  if (lhKok2&0x1) ok2 = 1; if (lhKok2&0x2) pv2 = 1;
-	  hM_K0oP[1][0] ->Fill(m_pipi,(double)ok2);
-	  hM_K0oPV[1][0]->Fill(m_pipi,(double)pv2);
-	  hM_K0oPT[1][0]->Fill(m_pipi,(double)(ok2&pv2));
+	  hReg->Fill(hM_K0oP[1][0],m_pipi,(double)ok2);
+	  hReg->Fill(hM_K0oPV[1][0],m_pipi,(double)pv2);
+	  hReg->Fill(hM_K0oPT[1][0],m_pipi,(double)(ok2&pv2));
 	  //                              ***** w/,w/o VETO, AS A F(PHASE SPACE)
-	  hM_K0oP[1][jPA2] ->Fill(m_pipi,(double)ok2);
-	  hM_K0oPV[1][jPA2]->Fill(m_pipi,(double)pv2);
-	  hM_K0oPT[1][jPA2]->Fill(m_pipi,(double)(ok2&pv2));
+	  hReg->Fill(hM_K0oP[1][jPA2],m_pipi,(double)ok2);
+	  hReg->Fill(hM_K0oPV[1][jPA2],m_pipi,(double)pv2);
+	  hReg->Fill(hM_K0oPT[1][jPA2],m_pipi,(double)(ok2&pv2));
 	  if (pRange&0x2) {               // **********...w/in pRANGE **********
 	    hM_K0M[1]->Fill(m_pipi,(double)(ok2&pv2));
 	    hM_K0PD[1][ipd2]->Fill(m_pipi,(double)(ok2&pv2));// ***** AS A F(PD)
@@ -5373,18 +5427,14 @@ void fillLambda_RICHPerf(PaEvent &e, int iET1, int iET2, int iETp,
   else                                             iLaL = 1;
 #  endif
   int acc = 0; // Acceptance Flag...
-  if (aRs[iETp]==0) {
- printf("** U3/Lambda RICHPerf:\a Evt %d,%d Track %d RICH not yet checked\n\n",
-	e.RunNum(),(int)e.UniqueEvNum(),iETp); assert(false);
-  }
-  if (aRs[iETp]>0) acc |= 0x1;
-  const vector<Float_t> &aux = trkp.vAux();
-  if (aRs[iETp]<-1) { // Ensure then "aRs" are meaningful
-    printf("** U3:\a Evt %d,%d Track %d(<-Lambda): Inconsistency: aRs = %d\n",
-	   e.RunNum(),(int)e.UniqueEvNum(),iETp,aRs[iETp]);
+  const RICHPlane &rp = richPlane(e,iETp);
+  if (rp.aR>0) acc |= 0x1;
+  if (rp.aR<-1) { // Ensure then RICH plane is meaningful
+    printf("** U3:\a Evt %d,%d Track %d(<-Lambda): Inconsistency: aR = %d\n",
+	   e.RunNum(),(int)e.UniqueEvNum(),iETp,rp.aR);
     abort();
   }
-  double XR = aux[0], YR = aux[1], RR = sqrt(XR*XR+YR*YR);
+  double XR = rp.XR, YR = rp.YR, RR = sqrt(XR*XR+YR*YR);
   // Start hlx
   const PaTPar &hp = trkp.vTPar()[0];
   // More precision: which part of acceptance is hit...
@@ -5760,141 +5810,27 @@ void fillK0X(PaEvent &e, int ipV, int imuS,
 	     double KSMassCut, double dM_phi, double phiMassCut)
 {
   double nu = lvq.E();
-  const PaVertex &pV = e.vVertex(ipV); int nTrksPV = pV.NOutParticles();
-  int ip3; double spT; for (ip3 = 0, spT = 0; ip3<nTrksPV; ip3++) {
-    //    *************** DETERMINE SUM OF pT ***************
-    int iEP3 = pV.iOutParticle(ip3);
-    if (iEP3==imuS) continue;                               // ***** EXCLUDE mu'
-    const PaParticle &pa3 = e.vParticle(iEP3);
-    int iET3 = pa3.iTrack(); PaTrack &trk3 = e.vTrack()[iET3];
-    int zones3 = tZones[iET3];
-    //         ***** 3RD PARTICLE: REJECTIONS *****
-    if (zones3==0x1) continue;                     // ***** EXCLUDE FRINGE FIELD
-    if (trk3.Chi2tot()/trk3.Ndf()>chi2Cut) continue;    // ***** CUT ON CHI2/NDF
-    const PaTPar &hv3 = pa3.ParInVtx(ipV); TVector3 v33 = hv3.Mom3();
-    spT += fabs(v33.Perp(lvq.Vect()));
-  }
-  for (ip3 = 0; ip3<nTrksPV; ip3++) { 
+  getPVTracks(e,ipV,imuS,lvq);       // ***** TABLE of pV TRACKS (and SUM of pT)
+  double spT = pVspT;
+  int nPVTrks = (int)pVTracks.size(), iNeg = nPVTrks-pVTracksNeg;
+  for (int it3 = 0; it3<nPVTrks; it3++) { 
 
     // *************************************************************
     // *************** SEARCH FOR K0 + pi,K,p,phi... ***************
     // *************************************************************
 
-    int iEP3 = pV.iOutParticle(ip3);
-    const PaParticle &pa3 = e.vParticle(iEP3);
-
-    // ********** LOOP on PARTICLES in PRIMARY VERTEX **********
+    // ********** LOOP on ACCEPTED PARTICLES in PRIMARY VERTEX **********
 
-    if (iEP3==imuS) continue;                               // ***** EXCLUDE mu'
-    int iET3 = pa3.iTrack();
+    const PVTrack &t3 = pVTracks[it3]; int iET3 = t3.iET;
     if (iET3==iET1 || iET3==iET2) continue;          // ***** EXCLUDE pi from K0
 
-    PaTrack &trk3 = e.vTrack()[iET3]; int zones3 = tZones[iET3];
+    int piok3 = t3.piok, Kok3 = t3.Kok, pok3 = t3.pok;
+    int aboveK = t3.aboveK;
 
-    //      ********** 3RD PARTICLE: REJECTIONS **********
-    if (zones3==0x1) continue;                     // ***** EXCLUDE FRINGE FIELD
-#ifdef DISCARD_MUONS
-    if (trk3.XX0()>15) continue;                          // ***** EXCLUDE MUONS
-#endif
-    if (trk3.Chi2tot()/trk3.Ndf()>chi2Cut) continue;    // ***** CUT ON CHI2/NDF
-    // Prior to, possibly re-scale momentum, determine acceptance by RICH and
-    // exit angle for SM1 and incidence/exit angle for SM2.
-    // (Cf. also comment supra, in V0 block, concenring Marcin's rescaling.)
-    if (aRs[iET3]==0) /* Not done? */transport(e,trk3,aRs[iET3],zones3);
-    if (aRs[iET3]<-1) continue; // Skip track starting downstream of RICH
-    const PaTPar &hv3 = pa3.ParInVtx(ipV); TVector3 v33 = hv3.Mom3();
-    // For P @ RICH, best would be a smoothing point in zone 0x2. Next best...
-    const PaTPar &hi3 = trk3.vTPar()[0]; double mom3;
-    mom3 = fabs(1/hi3(5));
-
-    int Kok3 = 0, pok3 = 0;        // ***** RICH PID **********
-    int abovepi = 0, aboveK = 0, abovep = 0;
-    if (piThr*thrMargin<mom3) {
-      abovepi |= 0x1;
-      if (KThr*thrMargin<mom3) {
-	aboveK |= 0x1;
-	if (pThr*thrMargin<mom3) abovep |= 0x1;
-      }
-    }
-    int piok3 = abovepi ? 1 : 2;
-    if (PIDs[iET3]&0x10) {
-      //                           ***** KID: above Thr = 1, below = 2
-      double piLH = richLHs[0][iET3], KLH = richLHs[1][iET3];
-      double pLH  = richLHs[2][iET3], eLH = richLHs[3][iET3];
-#ifdef piS_e_REJECTION
-      if (eLH>piLHeVeto*piLH)                               piok3 = 0;
-#endif
-      if (piLH<KLH || piLH<pLH || (abovepi && piLH<LHBckCut)) {
-	/* */                                               piok3 = 0;
-	if (aboveK) {
-	  if (KLH>LHCut*piLH && KLH>LHCut*pLH && KLH>LHBckCut)
-	    /* */                                            Kok3 = 1;
-	}
-	else if (abovepi) {
-#ifdef REJECT_SubKThr_e
-	  if (piLH<subKThrLHpiVeto && eLH<subKThrLHeVeto)    Kok3 = 2;
-	  if (piLH<subpThrLHpiVeto && eLH<subpThrLHVeto)     pok3 = 2;
-#else
-	  if (piLH<subKThrLHpiVeto)                          Kok3 = 2;
-	  if (piLH<subpThrLHpiVeto)                          pok3 = 2;
-#endif
-	}
-	//else No telling K from pi
-
-	// pID: above pThr = 1 = No piID nor KID subThreshold ID
-	// Warning: infra not updated after definition of eID changed
-	if (abovep) {
-	  if (pLH>LHCut*piLH && pLH>LHCut*KLH && pLH>LHBckCut)
-	    /* */                                            pok3 = 1;
-	}
-	else if (aboveK) {
-#ifdef REJECT_SubKThr_e
-	  if (piLH<subKThrLHpiVeto && KLH<subKThrLHpiVeto &&
-	      eLH<subKThrLHeVeto)                            pok3 = 2;
-#else
-	  if (piLH<subKThrLHpiVeto && KLH<subKThrLHpiVeto)   pok3 = 2;
-#endif
-	}
-	//else no telling p from K
-      }
-    }
-#if defined K_BELOW_THR && K_BELOW_THR > 1
-    bool checkAcceptance = piok3 || Kok3 || pok3 || !(PIDs[iET3]&0x10);
-#else
-    bool checkAcceptance = piok3 || Kok3 || pok3;
-#endif
-    if (checkAcceptance && aRs[iET3]==0) {
-  printf("\n\n** U3:\a Run %d Evt %d Track %d RICH not yet checked!\n\n",
-	 e.RunNum(),(int)e.UniqueEvNum(),iET3); assert(false);
-    }
-#if defined K_BELOW_THR && K_BELOW_THR > 1
-    if (!(PIDs[iET3]&0x10) && aRs[iET3]>0 && abovepi) {
-      /* */                                                 piok3 = 0;
-      if      (!aboveK)                                      Kok3 = 2;
-      else if (!abovep)                                      pok3 = 2;
-    }
-#endif
-    if (piok3 || Kok3 || pok3) {    // ***** ID CONDITIONED by...*****
-#ifdef U3_K0X_RICH_RADIUS_CUT
-      if (aRs[iET3]<2) {                // ...RADIUS/ANGLE @ RICH 
-	Kok3 = 0; pok3 = 0; piok3 = 0;
-      }
-#else
-      if (aRs[iET3]<0) {                // ...RICH ACCEPTANCE *****
-	Kok3 = 0; pok3 = 0; piok3 = 0;
-      }
-#endif
-    }
-    if ((piok3&&Kok3) || (pok3&&piok3)) {
-  printf("\n** U3:\a Evt %d,%d Track %d(<-K0+X) RICH not yet checked\n\n",
-	 e.RunNum(),(int)e.UniqueEvNum(),iET3); assert(false);
-    }
-
-    TLorentzVector *lvK0pi3 = 0, *lvpi3 = 0;
+    TLorentzVector *lvK0pi3 = 0; const TLorentzVector *lvpi3 = 0;
     if (piok3) {
       //  ***** piID: search for D+/- -> K0pi+/- or K*(->K0pi)pi *****
-      double Epi3 = sqrt(v33.Mag2()+M2_pi);
-      lvpi3 = new TLorentzVector(v33,Epi3);
+      lvpi3 = &t3.lvpi;
       lvK0pi3 = new TLorentzVector(*lvpi3); *lvK0pi3 += lvK0;
       double m_K0pi = lvK0pi3->M(); hm_K0pi->Fill(m_K0pi);
       TLorentzVector lvK02 = lvK0;	       // Boost K0 to K0pi frame
@@ -5907,10 +5843,9 @@ void fillK0X(PaEvent &e, int ipV, int imuS,
 	delete lvK0pi3; lvK0pi3 = 0;
       }
     }
-    else if (pok3 && pa3.Q()>0) {
+    else if (pok3 && t3.Q>0) {
       //        ********** p+ID: search for Lc and 5q **********
-      double Ep3 = sqrt(v33.Mag2()+M2_p);
-      TLorentzVector lvp3(v33,Ep3);
+      const TLorentzVector &lvp3 = t3.lvp;
       TLorentzVector lvK0p = lvK0 + lvp3; double m_K0p = lvK0p.M();
       hm_K0p[pok3-1]->Fill(m_K0p);
       TLorentzVector lvK02 = lvK0;
@@ -5926,8 +5861,7 @@ void fillK0X(PaEvent &e, int ipV, int imuS,
     }
     //      ********** Search for phi -> KK **********
     // Here we have in view to look for phi w/ possibly only one KID
-    double EK3 = sqrt(v33.Mag2()+M2_K);
-    TLorentzVector lvK3(v33,EK3);
+    const TLorentzVector &lvK3 = t3.lvK;
     if (Kok3) {
       //     ********** KID: search for Ds+/- -> K0K+/- **********
       TLorentzVector lvK0K(lvK3); lvK0K += lvK0;
@@ -5942,107 +5876,25 @@ void fillK0X(PaEvent &e, int ipV, int imuS,
       }
     }
 
-    if (pa3.Q()<0 ||        // ***** KEEP SEARCHING ONLY if 3 > 0 OR...
+    if (t3.Q<0 ||           // ***** KEEP SEARCHING ONLY if 3 > 0 OR...
 	(!Kok3 && !piok3)) {// ...CANDIDATES D0 -> K0 phi OR -> K0* pi
-      if (lvK0pi3) delete lvK0pi3; if (lvpi3) delete lvpi3;
+      if (lvK0pi3) delete lvK0pi3;
       continue;
     }
 
     vector<UsParticle> KSpis, K0phis;
-    for (int ip4 = 0; ip4<nTrksPV; ip4++) {
-      int iEP4 = pV.iOutParticle(ip4);
-      const PaParticle &pa4 = e.vParticle(iEP4);
-      if (pa4.Q()>0) continue;             // Particle 4 is the <0
-
-      // ***** LOOP on <0 PARTICLES in PRIMARY VERTEX *****
-
-      if (iEP4==imuS) continue;                   // ***** EXCLUDE mu'
-      int iET4 = pa4.iTrack();
+    for (int it4 = iNeg; it4<nPVTrks; it4++) {
+      // ***** LOOP on <0 ACCEPTED PARTICLES in PRIMARY VERTEX *****
+      // (They are stored at the end of the table.)
+      const PVTrack &t4 = pVTracks[it4]; int iET4 = t4.iET;
       if (iET4==iET2) continue;           // ***** EXCLUDE pi- from K0
 
-      PaTrack &trk4 = e.vTrack()[iET4];
-      int zones4 = tZones[iET4];
-
-      // ***** 4th Particle: REJECTIONS *****
-      if (zones4==0x1) continue;                   // ***** EXCLUDE FRINGE FIELD
-#ifdef DISCARD_MUONS
-      if (trk4.XX0()>15) continue;                        // ***** EXCLUDE MUONS
-#endif
-      if (trk4.Chi2tot()/trk4.Ndf()>chi2Cut) continue;  // ***** CUT ON CHI2/NDF
-
-      // Prior to, possibly re-scale momentum, determine acceptance by RICH and
-      // exit angle for SM1 and incidence/exit angle for SM2.
-      // (Cf. also comment supra, in V0 block, concenring Marcin's rescaling.)
-      if (aRs[iET4]==0) /* !done? */transport(e,trk4,aRs[iET4],zones4);
-      if (aRs[iET4]<-1) continue; // Skip track starting downstream of RICH
-      const PaTPar &hv4 = pa4.ParInVtx(ipV); TVector3 v43 = hv4.Mom3();
-      // For P @ RICH, best would be a smoothing point in zone 0x2. Next best...
-      const PaTPar &hi4 = trk4.vTPar()[0]; double mom4;
-      mom4 = fabs(1/hi4(5));
-
-      if (piThr*thrMargin<mom4) {           // ***** RICH KID *****
-	abovepi |= 0x2;
-	if (KThr*thrMargin<mom4) aboveK |= 0x2;
-	else                     aboveK &= 0x1;
-      }
-      else abovepi &= 0x1;
-      int piok4 = (abovepi&0x2) ? 1 : 2, Kok4 = 0;
-      if (PIDs[iET4]&0x10) {
-	double piLH = richLHs[0][iET4], KLH = richLHs[1][iET4];
-	double pLH  = richLHs[2][iET4], eLH = richLHs[3][iET4];
-#ifdef piS_e_REJECTION
-	if (eLH>piLHeVeto*piLH)                             piok4 = 0;
-#endif
-	if (piLH<KLH || piLH<pLH || ((abovepi&0x2) && piLH<LHBckCut)) {
-	  /* */                                             piok4 = 0;
-	  if (aboveK&0x2) {          // KID: above Thr = 1, below = 2
-	    if (KLH>LHCut*piLH && KLH>LHCut*pLH && KLH>LHBckCut)
-	      /* */                                          Kok4 = 1;
-	  }
-	  else if (abovepi&0x2) {
-#ifdef REJECT_SubKThr_e
-	    if (piLH<subKThrLHpiVeto && eLH<subKThrLHeVeto)  Kok4 = 2;
-#else
-	    if (piLH<subKThrLHpiVeto)                        Kok4 = 2;
-#endif
-	  }
-	}
-      }
-#if defined K_BELOW_THR && K_BELOW_THR > 1
-      checkAcceptance =  piok4 || Kok4 || !(PIDs[iET4]&0x10);
-#else
-      checkAcceptance =  piok4 || Kok4;
-#endif
-      if (checkAcceptance && aRs[iET4]==0) {
-  printf("\n** U3:\a Evt %d,%d Track %d(<-K0+XX') RICH not yet checked\n\n",
-	 e.RunNum(),(int)e.UniqueEvNum(),iET4); assert(false);
-      }
-#if defined K_BELOW_THR && K_BELOW_THR > 1
-      if (!(PIDs[iET4]&0x10) && aRs[iET4]>0 && (abovepi&0x2)) {
-	/* */                                               piok4 = 0;
-	if      (!(aboveK&0x2))                              Kok4 = 2;
-      }
-#endif
-      if (piok4 || Kok4) {        // ***** ID CONDITIONED by... *****
-#ifdef U3_K0X_RICH_RADIUS_CUT
-	if (aRs[iET4]<2) {        // ...RADIUS/ANGLE @ RICH
-	  piok4 = 0 ; Kok4 = 0;
-	}
-#else
-	if (aRs[iET4]<0) {        // ...RICH ACCEPTANCE *****
-	  piok4 = 0; Kok4 = 0;
-	}
-#endif
-      }
-      if (piok4&&Kok4) {
-   printf("\n** U3:\a Run %d Evt %d 4-Track %d: PID inconsistency\n\n",
-	 e.RunNum(),(int)e.UniqueEvNum(),iET4); assert(false);
-      }
+      aboveK = (aboveK&0x1)|t4.aboveK<<1;
+      int piok4 = t4.piok, Kok4 = t4.Kok;
 
       if (piok3 && piok4) {
 	// ********** piID: search for D0 -> K*(->K0pi)pi **********
-	double Epi4 = sqrt(v43.Mag2()+M2_pi);
-	TLorentzVector lvpi4(v43,Epi4);
+	const TLorentzVector &lvpi4 = t4.lvpi;
 	TLorentzVector lvK0pi4(lvpi4); lvK0pi4 += lvK0;
 	double m_K0pi = lvK0pi4.M();
 	int pm = -1; if (fabs(m_K0pi-M_KS)<KSMassCut) {
@@ -6068,8 +5920,7 @@ void fillK0X(PaEvent &e, int ipV, int imuS,
       int okphi = 0; if (Kok3) okphi |= 0x1; if (Kok4) okphi |= 0x2;
       if (okphi) {
 	// ********** KID: search for D0-> K0phi(->KK) **********
-	double EK4 = sqrt(v43.Mag2()+M2_K);
-	TLorentzVector lvK4(v43,EK4);
+	const TLorentzVector &lvK4 = t4.lvK;
 	TLorentzVector lvKK(lvK3); lvKK += lvK4;
 	double pT34 = lvK4.Perp(lvK3.Vect());
 	if (pT34<Iphi_pTCUT*.001) continue;
@@ -6123,47 +5974,48 @@ void fillK0X(PaEvent &e, int ipV, int imuS,
       double ED0 = sqrt(lvKX.Vect().Mag2()+M_D0*M_D0);
       TLorentzVector lvD0(lvKX.Vect(),ED0);
 
-      for (int ip5 = 0; ip5<nTrksPV; ip5++) {
+      // EARLY PRUNING: Outside the D0 mass window, only the D*-D0 window
+      // matters. Since p_D0.p_pi <= |p_D0||p_pi|, m_D0pi<M_DS+D0piUp requires
+      //   M_D0^2 p^2 - 2*C*P_D0 p + E_D0^2 M_pi^2 - C^2 < 0, w/ p = |p_pi|
+      //   and C = ((M_DS+D0piUp)^2-M_D0^2-M_pi^2)/2,
+      // i.e. p w/in the roots, which, the table being sorted on P w/in each
+      // charge, are searched for by bisection.
+      bool inD0 = fabs(m_KX-M_D0)<.03;
+      int it5Rngs[4] = {0,iNeg,iNeg,nPVTrks};
+      if (!inD0) {
+	double P = lvD0.P(), mUp = M_DS+D0piUp;
+	double C = (mUp*mUp-M_D0*M_D0-M2_pi)/2;
+	double disc = C*C*P*P-M_D0*M_D0*(ED0*ED0*M2_pi-C*C);
+	if (disc<0) continue;
+	PVTrack tMn, tMx;           // Bounds, w/ some margin for rounding
+	tMn.P = (C*P-sqrt(disc))/M_D0/M_D0*(1-1e-6)-1e-6;
+	tMx.P = (C*P+sqrt(disc))/M_D0/M_D0*(1+1e-6)+1e-6;
+	vector<PVTrack>::iterator begin = pVTracks.begin();
+	for (int pm = 0; pm<2; pm++) {
+	  vector<PVTrack>::iterator iB = begin+it5Rngs[2*pm];
+	  vector<PVTrack>::iterator iE = begin+it5Rngs[2*pm+1];
+	  it5Rngs[2*pm]   = lower_bound(iB,iE,tMn,lessPVTrackP)-begin;
+	  it5Rngs[2*pm+1] = upper_bound(iB,iE,tMx,lessPVTrackP)-begin;
+	}
+      }
+
+      int n5p = it5Rngs[1]-it5Rngs[0], n5 = n5p+it5Rngs[3]-it5Rngs[2];
+      for (int i5 = 0; i5<n5; i5++) {
+	int it5 = i5<n5p ? it5Rngs[0]+i5 : it5Rngs[2]+i5-n5p;
 	//   ********** SEARCH FOR D*->D0(->K0phi | K*pi)pi **********
-	int iEP5 = pV.iOutParticle(ip5);
-	const PaParticle &pa5 = e.vParticle(iEP5);
-	if (iEP5==imuS) continue;                 // ***** EXCLUDE mu'
-	int iET5 = pa5.iTrack();
+	const PVTrack &t5 = pVTracks[it5]; int iET5 = t5.iET;
 	if (iET5==iET1 || iET5==iET2 ||       // Exclude pi+/- from K0
 	    iET5==iET3 || iET5==iET4)         // ...and from phi/K*pi
 	  continue;
-
-	PaTrack &trk5 = e.vTrack()[iET5];//double zL5 = trk5.ZLast();
-	int zones5 = tZones[iET5];
-
-	// *************** REJECTIONS ***************
-	if (zones5==0x1) continue;             // Exclude fringe field
-#ifdef DISCARD_MUONS
-	if (trk5.XX0()>15) continue;                  // Exclude muons
-#endif
-	if (trk5.Chi2tot()/trk5.Ndf()>chi2Cut)
-	  continue;                           // Cut on chi2/ndf
 #ifdef piS_e_REJECTION
-	if (PIDs[iET5]&0x10) {
-	  double eLH = richLHs[3][iET5], piLH = richLHs[2][iET5];
-	  if (eLH>piLHeVeto*piLH) continue;
-	}
+	if (t5.eVeto) continue;
 #endif
 
-	// Prior to, possibly re-scale momentum, determine acceptance by RICH
-	// and exit angle for SM1 and incidence/exit angle for SM2.
-	// (Cf. also comment supra, in V0 block, concenring Marcin's rescaling.)
-	if (aRs[iET5]==0)/* !done? */transport(e,trk5,aRs[iET5],zones5);
-	if (aRs[iET5]<-1) continue; // Skip track starting downstream of RICH
-	const PaTPar &hv5 = pa5.ParInVtx(ipV); TVector3 v53 = hv5.Mom3();
-	double Epi5 = sqrt(v53.Mag2()+M2_pi);
-	TLorentzVector lv53(v53,Epi5);
-
-	TLorentzVector lvD0pi = lvD0 + lv53;
+	TLorentzVector lvD0pi = lvD0 + t5.lvpi;
 	double m_D0pi = lvD0pi.M();
-	if (fabs(m_KX-M_D0)<.03) {
+	if (inD0) {
 	  if (type==1 || type==2) {
-	    int pm = type-1, pmwr = pm + (pa5.Q()!=2*pm-1 ? 2 : 0); 
+	    int pm = type-1, pmwr = pm + (t5.Q!=2*pm-1 ? 2 : 0); 
 	    hm_KSpipi[pmwr]->Fill(m_D0pi);
 	    if (kinOK&0x1) hm_KSpipiC[pmwr]->Fill(m_D0pi);
 	  }
@@ -6174,7 +6026,7 @@ void fillK0X(PaEvent &e, int ipV, int imuS,
 	}
 	if (D0piLow<m_D0pi-M_DS && m_D0pi-M_DS<D0piUp) {
 	  if (type==1 || type==2) {
-	    int pm = type-1, pmwr = pm + (pa5.Q()!=2*pm-1 ? 2 : 0);
+	    int pm = type-1, pmwr = pm + (t5.Q!=2*pm-1 ? 2 : 0);
 	    hS_KSpi[pmwr]->Fill(m_KX);
 	    if (kinOK&0x1) hS_KSpiC[pmwr]->Fill(m_KX);
 	    if (spT>1.6) {
@@ -6189,10 +6041,136 @@ void fillK0X(PaEvent &e, int ipV, int imuS,
 	}
       }  // End loop on pa5
     }  // End loop on K*pi/K0phi's
-    if (lvK0pi3) delete lvK0pi3; if (lvpi3) delete lvpi3;
+    if (lvK0pi3) delete lvK0pi3;
   }  // End loop on pa3
 }
 // **********************************************************************
+// ***************************** getPVTracks ****************************
+// **********************************************************************
+void getPVTracks(PaEvent &e, int ipV, int imuS, const TLorentzVector &lvq)
+{
+  // Fill the table of accepted tracks of best pV (cf. "PVTrack" supra), w/
+  // positive tracks first and negative ones at the end, each sorted on |P|,
+  // and the sum of pT
+  // (which, as opposed to the table, does not discard muons nor tracks
+  // starting downstream of RICH).
+  // Done only once per event: subsequent calls return immediately.
+  if (pVTracksOK) return; pVTracksOK = true;
+  pVTracks.clear(); pVTracksNeg = 0; pVspT = 0;
+  static vector<PVTrack> negTracks; negTracks.clear();
+  const PaVertex &pV = e.vVertex(ipV); int nTrksPV = pV.NOutParticles();
+  for (int ip = 0; ip<nTrksPV; ip++) {
+    int iEP = pV.iOutParticle(ip);
+    if (iEP==imuS) continue;                                // ***** EXCLUDE mu'
+    const PaParticle &pa = e.vParticle(iEP);
+    int iET = pa.iTrack(); PaTrack &trk = e.vTrack()[iET];
+    if (tZones[iET]==0x1) continue;                // ***** EXCLUDE FRINGE FIELD
+    if (trk.Chi2tot()/trk.Ndf()>chi2Cut) continue;      // ***** CUT ON CHI2/NDF
+    const PaTPar &hv = pa.ParInVtx(ipV); TVector3 v3 = hv.Mom3();
+    pVspT += fabs(v3.Perp(lvq.Vect()));                    // ***** SUM OF pT
+#ifdef DISCARD_MUONS
+    if (trk.XX0()>15) continue;                           // ***** EXCLUDE MUONS
+#endif
+    // Prior to, possibly re-scale momentum, determine acceptance by RICH and
+    // exit angle for SM1 and incidence/exit angle for SM2.
+    // (Cf. also comment supra, in V0 block, concenring Marcin's rescaling.)
+    int aR = richPlane(e,iET).aR;
+    if (aR<-1) continue;               // Skip track starting downstream of RICH
+
+    PVTrack t; t.iET = iET; t.Q = pa.Q(); t.P = v3.Mag();
+    t.lvpi = TLorentzVector(v3,sqrt(v3.Mag2()+M2_pi));
+    t.lvK  = TLorentzVector(v3,sqrt(v3.Mag2()+M2_K));
+    t.lvp  = TLorentzVector(v3,sqrt(v3.Mag2()+M2_p));
+    // For P @ RICH, best would be a smoothing point in zone 0x2. Next best...
+    const PaTPar &hi = trk.vTPar()[0]; double mom = fabs(1/hi(5));
+
+    int piok, Kok = 0, pok = 0;                   // ***** RICH PID **********
+    int abovepi = 0, aboveK = 0, abovep = 0;
+    if (piThr*thrMargin<mom) {
+      abovepi = 1;
+      if (KThr*thrMargin<mom) {
+	aboveK = 1;
+	if (pThr*thrMargin<mom) abovep = 1;
+      }
+    }
+    piok = abovepi ? 1 : 2;
+    if (PIDs[iET]&0x10) {
+      //                           ***** KID: above Thr = 1, below = 2
+      int lh = LHIDs[iET];
+#ifdef piS_e_REJECTION
+      if (lh&LHeGT)                                         piok = 0;
+#endif
+      if (!(lh&LHpiMx) || (abovepi && !(lh&LHpiBck))) {
+	/* */                                               piok = 0;
+	if (aboveK) {
+	  if (lh&LHKID)                                      Kok = 1;
+	}
+	else if (abovepi) {
+#ifdef REJECT_SubKThr_e
+	  if ((lh&LHsubKpi) && (lh&LHsubKe))                 Kok = 2;
+	  if ((lh&LHsubppi) && (lh&LHsubpe))                 pok = 2;
+#else
+	  if (lh&LHsubKpi)                                   Kok = 2;
+	  if (lh&LHsubppi)                                   pok = 2;
+#endif
+	}
+	//else No telling K from pi
+
+	// pID: above pThr = 1 = No piID nor KID subThreshold ID
+	// Warning: infra not updated after definition of eID changed
+	if (abovep) {
+	  if (lh&LHpID)                                      pok = 1;
+	}
+	else if (aboveK) {
+#ifdef REJECT_SubKThr_e
+	  if ((lh&LHsubKpi) && (lh&LHsubKK) &&
+	      (lh&LHsubKe))                                  pok = 2;
+#else
+	  if ((lh&LHsubKpi) && (lh&LHsubKK))                 pok = 2;
+#endif
+	}
+	//else no telling p from K
+      }
+    }
+#if defined K_BELOW_THR && K_BELOW_THR > 1
+    if (!(PIDs[iET]&0x10) && aR>0 && abovepi) {
+      /* */                                                 piok = 0;
+      if      (!aboveK)                                      Kok = 2;
+      else if (!abovep)                                      pok = 2;
+    }
+#endif
+    if (piok || Kok || pok) {       // ***** ID CONDITIONED by...*****
+#ifdef U3_K0X_RICH_RADIUS_CUT
+      if (aR<2) {                              // ...RADIUS/ANGLE @ RICH 
+	Kok = 0; pok = 0; piok = 0;
+      }
+#else
+      if (aR<0) {                              // ...RICH ACCEPTANCE *****
+	Kok = 0; pok = 0; piok = 0;
+      }
+#endif
+    }
+    if ((piok&&Kok) || (pok&&piok)) {
+   printf("\n** U3:\a Run %d Evt %d Track %d(<-K0+X): PID inconsistency\n\n",
+	 e.RunNum(),(int)e.UniqueEvNum(),iET); assert(false);
+    }
+    t.aboveK = aboveK;
+    t.piok = piok; t.Kok = Kok; t.pok = pok;
+#ifdef piS_e_REJECTION
+    t.eVeto = false; if (PIDs[iET]&0x10) {
+      double eLH = richLHs[3][iET], piLH = richLHs[2][iET];
+      t.eVeto = eLH>piLHeVeto*piLH;
+    }
+#endif
+    if (t.Q<0) negTracks.push_back(t);
+    else       pVTracks.push_back(t);
+  }
+  sort(pVTracks.begin(),pVTracks.end(),lessPVTrackP);
+  sort(negTracks.begin(),negTracks.end(),lessPVTrackP);
+  pVTracksNeg = (int)negTracks.size();
+  pVTracks.insert(pVTracks.end(),negTracks.begin(),negTracks.end());
+}
+// **********************************************************************
 // *************************    fillLambdaX    **************************
 // **********************************************************************
 void fillLambdaX(PaEvent &e, int ipV, int imuS,
@@ -6225,17 +6203,14 @@ void fillLambdaX(PaEvent &e, int ipV, int imuS,
     // Prior to, possibly re-scale momentum, determine acceptance by RICH and
     // exit angle for SM1 and incidence/exit angle for SM2.
     // (Cf. also comment supra, in V0 block, concenring Marcin's rescaling.)
-    if (aRs[iET3]==0) /* Not done? */transport(e,trk3,aRs[iET3],zones3);
-    if (aRs[iET3]<-1) continue; // Skip track starting downstream of RICH
+    richPlane(e,iET3); // Transport to RICH, if not yet done
+    if (rPlanes[iET3].aR<-1) continue; // Skip track starting downstream of RICH
     const PaTPar &hv3 = pa3.ParInVtx(ipV); TVector3 v33 = hv3.Mom3();
     // For P @ RICH, best would be a smoothing point in zone 0x2. Next best...
     const PaTPar &hi3 = trk3.vTPar()[0]; double mom3;
     mom3 = fabs(1/hi3(5));
 #  ifdef piS_e_REJECTION
-    if (PIDs[iET3]&0x10) {
-      double piLH = richLHs[0][iET3], eLH = richLHs[3][iET3];
-      if (eLH>piLHeVeto*piLH) continue;
-    }
+    if (LHIDs[iET3]&LHeGT) continue;
 #  endif
 
     double Epi3 = sqrt(v33.Mag2()+M2_pi);
@@ -6245,10 +6220,7 @@ void fillLambdaX(PaEvent &e, int ipV, int imuS,
     double m_Lpi = lvLpi.M(); hm_Lpi[iLaL+2*pm]->Fill(m_Lpi);
 
     if (!(PIDs[iET3]&0x10)) continue;                     // ***** Sigma w/ piID
-    double piLH = richLHs[0][iET3], KLH = richLHs[1][iET3];
-    double pLH  = richLHs[2][iET3];
-    if (rich->piThr<mom3 && mom3<PRICHCut &&
-	piLH>LHCut*KLH && piLH>LHCut*pLH && piLH>LHBckCut) {
+    if (rich->piThr<mom3 && mom3<PRICHCut && (LHIDs[iET3]&LHpiID)) {
       hm_LpiID[iLaL+2*pm]->Fill(m_Lpi);
     }
   }  // End search fo Sigma* -> L + pi
@@ -6318,27 +6290,61 @@ void fillLCascades(PaEvent &e, int ipV, TMatrixD &CovP, int imuS,
   if (ppiID&0x30) PID += 1;
   if (ppiID&0x6)  PID += 2;
 
-  int nTrks = e.vTrack().size(); for (int iET3 = 0; iET3<nTrks; iET3++) {
+  //          ********** CANDIDATE 3RD PARTICLES **********
+  // Lpi-/aLpi+, passing the standard rejections (cf. "getLCTracks"), and,
+  // if "CDAPrefilter", w/in reach of the Lambda line (cf. supra).
+  getLCTracks(e,imuS,Zp);
+  int q3 = iLaL ? 1 : 0;
+  static vector<int> iET3s; iET3s.clear();
+  const vector<LCTrack> &far3s = lcTracksFar[q3], &lc3s = lcTracks[q3];
+  for (int i3 = 0; i3<(int)far3s.size(); i3++) iET3s.push_back(far3s[i3].iET);
+  double Zlo = Zp+3*dZp, Zhi = Zs-3*dZs;
+  bool prefilter = CDAPrefilter>0 && Zlo<Zhi;
+  if (prefilter && !lc3s.empty()) {
+    // Window in X @ Z = lcTracksZ: |dX(Zc)|<dCut => |dX(lcTracksZ)|<dCut+
+    // |dtx|*|Zc-lcTracksZ|, w/ dtx bounded by the extremal slopes in index
+    // and dCut by the largest covariance.
+    double sCut = CDAPrefilter*d3hSigCut, covL = hL(1,1)+hL(2,2);
+    double dCut = sCut*sqrt(lcTracksCovMx[q3]+covL), txL = hL(3), tyL = hL(4);
+    double XLr = Xs+txL*(lcTracksZ-Zs), YLr = Ys+tyL*(lcTracksZ-Zs);
+    double dZMx = fabs(Zlo-lcTracksZ); if (fabs(Zhi-lcTracksZ)>dZMx)
+      dZMx = fabs(Zhi-lcTracksZ);
+    double dtxMx = fabs(lcTracksTxMx[q3]-txL);
+    if (fabs(lcTracksTxMn[q3]-txL)>dtxMx) dtxMx = fabs(lcTracksTxMn[q3]-txL);
+    LCTrack tMn, tMx; tMn.X = XLr-dCut-dtxMx*dZMx; tMx.X = XLr+dCut+dtxMx*dZMx;
+    vector<LCTrack>::const_iterator it3 =
+      lower_bound(lc3s.begin(),lc3s.end(),tMn,lessLCTrackX);
+    vector<LCTrack>::const_iterator itE =
+      upper_bound(it3,lc3s.end(),tMx,lessLCTrackX);
+    for ( ; it3!=itE; it3++) {
+      // Straight-line distance, minimised over [Zlo,Zhi]
+      double dX = it3->X-XLr, dY = it3->Y-YLr;
+      double dtx = it3->tx-txL, dty = it3->ty-tyL, dt2 = dtx*dtx+dty*dty;
+      double Z = lcTracksZ; if (dt2>0) Z -= (dX*dtx+dY*dty)/dt2;
+      if (Z<Zlo) Z = Zlo; if (Z>Zhi) Z = Zhi;
+      dX += dtx*(Z-lcTracksZ); dY += dty*(Z-lcTracksZ);
+      if (dX*dX+dY*dY<sCut*sCut*(it3->cov+covL)) iET3s.push_back(it3->iET);
+    }
+  }
+#  ifndef U3_CASCADE_CDA_PREFILTER_CHECK
+  else
+#  else
+  static vector<int> pre3s; pre3s.assign(iET3s.begin(),iET3s.end());
+  sort(pre3s.begin(),pre3s.end());   // Retained by prefilter: check infra
+  iET3s.clear();
+  for (int i3 = 0; i3<(int)far3s.size(); i3++) iET3s.push_back(far3s[i3].iET);
+#  endif
+    for (int i3 = 0; i3<(int)lc3s.size(); i3++) iET3s.push_back(lc3s[i3].iET);
 
-    // ********** LOOP on PARTICLES in PRIMARY VERTEX **********
+  for (int i3 = 0; i3<(int)iET3s.size(); i3++) {
 
+    // ********** LOOP on CANDIDATE 3RD PARTICLES **********
+
+    int iET3 = iET3s[i3];
     if (iET3==iET1 || iET3==iET2) continue;    // ***** EXCLUDE p,pi FROM Lambda
 		
-    PaTrack &trk3 = e.vTrack()[iET3]; int zones3 = tZones[iET3];
+    PaTrack &trk3 = e.vTrack()[iET3];
     PaTPar hi3 = trk3.vTPar()[0];    
-    if (!hi3.HasMom()) continue;                       // ***** REQUIRE MOMENTUM
-    int iEP3 = trk3.iParticle(); if (iEP3<0) continue;
-    if (iEP3==imuS) continue;                               // ***** EXCLUDE mu'
-    const PaParticle &pa3 = e.vParticle(iEP3);
-    if (pa3.IsBeam()) continue;                            // ***** EXCLUDE BEAM
-    if ((!iLaL && pa3.Q()>0) || (iLaL && pa3.Q()<0))         // ***** Lpi-/aLpi+
-      continue;
-    //                      ***** 3RD PARTICLE: REJECTIONS *****
-    if (zones3==0x1) continue;                     // ***** EXCLUDE FRINGE FIELD
-#  ifdef DISCARD_MUONS
-    if (trk3.XX0()>15) continue;                          // ***** EXCLUDE MUONS
-#  endif
-    if (trk3.Chi2tot()/trk3.Ndf()>chi2Cut) continue;    // ***** CUT ON CHI2/NDF
 
     //                ********** REQUIRE CASCADE **********
     // - Cut on distance @ CDA
@@ -6361,7 +6367,7 @@ void fillLCascades(PaEvent &e, int ipV, TMatrixD &CovP, int imuS,
     // Double-precision covariance is used in the extrapolations performed in
     // "FindCDA". Somehow we need explict call to "f2d" to init it correctly.
     h.f2d();
-    if (!h.FindCDA(hi3,Z0,Zp+3*dZp,Zs-3*dZs,true,false,dZCDA)) continue;
+    if (!h.FindCDA(hi3,Z0,Zlo,Zhi,true,false,dZCDA)) continue;
     // Cascade origin: we have two different estimates => Average? although
     // could be that the one from Lambda, w/ its two tracks and vertex fit is
     // more accurate...
@@ -6382,12 +6388,17 @@ void fillLCascades(PaEvent &e, int ipV, TMatrixD &CovP, int imuS,
     }
     else {
       dd3h = sqrt(dd3h)/d3h;
-      if      (d3h/dd3h>16) s_d3h = -1;
+      if      (d3h/dd3h>d3hSigCut) s_d3h = -1;
       else if (d3h/dd3h>8)  s_d3h = 0;
       else                  s_d3h = 1;
     }
     if (s_d3h<0) // To speed up processing:          *****  Loose cut on D @ CDA
       continue;
+#  ifdef U3_CASCADE_CDA_PREFILTER_CHECK
+    if (prefilter && !binary_search(pre3s.begin(),pre3s.end(),iET3))
+      printf("** U3: Evt %d#%d Vtx,Particle %d,%d: Lost by CDA prefilter: D = %.3f+/-%.3f\n",
+	     Run,EvNum,isV,iET3,d3h,dd3h);
+#  endif
 #  ifdef U3_DEBUG_CDA
     if (debug)
       printf(" -> %.2f,%.2f,%.2f / %.2f,%.2f,%.2f => %.2f+/-%.2f\n",
@@ -6404,41 +6415,35 @@ void fillLCascades(PaEvent &e, int ipV, TMatrixD &CovP, int imuS,
     // Determine acceptance by RICH and exit angle for SM1 and incidence/exit
     // angle for SM2.
     // (Cf. also comment supra, in V0 block, concerning Marcin's rescaling.)
-    if (aRs[iET3]==0) /* Not done? */transport(e,trk3,aRs[iET3],zones3);
-    if (aRs[iET3]<-1) continue; // Skip track starting downstream of RICH
+    richPlane(e,iET3); // Transport to RICH, if not yet done
+    if (rPlanes[iET3].aR<-1) continue; // Skip track starting downstream of RICH
     TVector3 v33 = hi3.Mom3(); // 3rd particle 3-vector @ point of CDA
     // ***** PARTICLE ID
     int Ppi3ID = PID; if (Ppi3ID>=1) {
       if (PIDs[iET3]&0x10) {         // ***** SEARCH for Xi *****
 	double mom3 = hi3.Mom();     // ***** SEARCH for Omega *****
-	double piLH = richLHs[0][iET3], eLH = richLHs[3][iET3];
-	if (thrMargin*piThr<mom3) { if (eLH<piLHeVeto*piLH) Ppi3ID += 3; }
-	else if (eLH<subpiThrLHeVeto) Ppi3ID += 3;
+	int lh = LHIDs[iET3];
+	if (thrMargin*piThr<mom3) { if (lh&LHeLT) Ppi3ID += 3; }
+	else if (lh&LHsubpie) Ppi3ID += 3;
       }
     }
     int PK3ID = PID; if (PK3ID>=1) {
       double mom3 = hi3.Mom();      // ***** SEARCH for Omega *****
       if (rich->piThr*subKThrPmin<mom3 && mom3<PRICHCut) {
 	int KID = 0; if (PIDs[iET3]&0x10) {
-	  double piLH = richLHs[0][iET3], KLH = richLHs[1][iET3];
-	  double pLH =  richLHs[2][iET3], eLH = richLHs[3][iET3];
+	  int lh = LHIDs[iET3];
 	  if (rich->KThr*thrMargin<mom3) {
-	    if (KLH>LHCut*piLH && KLH>LHCut*pLH && KLH>LHBckCut)
-	      KID = 0x1;
+	    if (lh&LHKID) KID = 0x1;
 	  }
 	  else {
-	    if (piLH<subKThrLHpiVeto) KID = 0x2;
+	    if (lh&LHsubKpi) KID = 0x2;
 #  ifdef REJECT_SubKThr_e
-	    if (eLH>subKThrLHeVeto) KID = 0;
+	    if (!(lh&LHsubKe)) KID = 0;
 #  endif
 	  }
 	}
 	else if (mom3<rich->KThr) {
-	  if (aRs[iET3]==0) {
-	    printf("\n** U3:\a Evt %d,%d Track %d(<-Omega) RICH not yet checked\n\n",
-		   e.RunNum(),(int)e.UniqueEvNum(),iET2); assert(false);
-	  }
-	  if (aRs[iET3]) KID = 0x2;
+	  if (richPlane(e,iET3).aR) KID = 0x2;
 	}
 	if (KID) PK3ID += 3;
       }
@@ -6545,34 +6550,81 @@ void fillLCascades(PaEvent &e, int ipV, TMatrixD &CovP, int imuS,
   if (lvL) delete lvL;
 }
 // **********************************************************************
+// ***************************** getLCTracks ****************************
+// **********************************************************************
+void getLCTracks(PaEvent &e, int imuS, double Zref)
+{
+  // Fill the index of candidate 3rd particles for the cascade search (cf.
+  // "LCTrack" supra), w/ tangents to first helix taken @ Z = "Zref".
+  // Done only once per event: subsequent calls return immediately.
+  if (lcTracksOK) return; lcTracksOK = true;
+  lcTracksZ = Zref;
+  for (int q = 0; q<2; q++) {
+    lcTracks[q].clear(); lcTracksFar[q].clear();
+    lcTracksTxMn[q] = 0; lcTracksTxMx[q] = 0; lcTracksCovMx[q] = 0;
+  }
+  int nTrks = e.vTrack().size(); for (int iET = 0; iET<nTrks; iET++) {
+    const PaTrack &trk = e.vTrack()[iET];
+    const PaTPar &hi = trk.vTPar()[0];
+    if (!hi.HasMom()) continue;                        // ***** REQUIRE MOMENTUM
+    int iEP = trk.iParticle(); if (iEP<0) continue;
+    if (iEP==imuS) continue;                                // ***** EXCLUDE mu'
+    const PaParticle &pa = e.vParticle(iEP);
+    if (pa.IsBeam()) continue;                             // ***** EXCLUDE BEAM
+    if (tZones[iET]==0x1) continue;                // ***** EXCLUDE FRINGE FIELD
+#  ifdef DISCARD_MUONS
+    if (trk.XX0()>15) continue;                           // ***** EXCLUDE MUONS
+#  endif
+    if (trk.Chi2tot()/trk.Ndf()>chi2Cut) continue;      // ***** CUT ON CHI2/NDF
+    LCTrack t; t.iET = iET; t.tx = hi(3); t.ty = hi(4);
+    t.cov = hi(1,1)+hi(2,2);
+    t.X = hi(1)+t.tx*(Zref-hi(0)); t.Y = hi(2)+t.ty*(Zref-hi(0));
+    for (int q = 0; q<2; q++) {            // ***** Lpi-: q = 0, aLpi+: q = 1
+      if ((!q && pa.Q()>0) || (q && pa.Q()<0)) continue;
+      if (hi(0)>ZSM1) { lcTracksFar[q].push_back(t); continue; }
+      if (lcTracks[q].empty() || t.tx<lcTracksTxMn[q]) lcTracksTxMn[q] = t.tx;
+      if (lcTracks[q].empty() || t.tx>lcTracksTxMx[q]) lcTracksTxMx[q] = t.tx;
+      if (t.cov>lcTracksCovMx[q]) lcTracksCovMx[q] = t.cov;
+      lcTracks[q].push_back(t);
+    }
+  }
+  for (int q = 0; q<2; q++)
+    sort(lcTracks[q].begin(),lcTracks[q].end(),lessLCTrackX);
+}
+// **********************************************************************
+// ****************************** richPlane *******************************
 // ****************************** transport *******************************
 // **********************************************************************
-void transport(PaEvent &e,
-	       PaTrack &trk,    // 
-	       int &aR,         // RICH acceptance flag
-	       int zones)
+const RICHPlane &richPlane(PaEvent &e, int iET)
+{
+  // Access to the state @ RICH of track #iET, transporting the track there
+  // if not yet done for the current event.
+  RICHPlane &rp = rPlanes[iET];
+  if (rp.aR==0) transport(e.vTrack()[iET],tZones[iET],rp);
+  return rp;
+}
+void transport(const PaTrack &trk,
+	       int zones,
+	       RICHPlane &rp)   // Output
 {
   // Transport argument track to
   // - RICH => Determine acceptance by RICH (if starting downstream of it).
-  //  -> Fill argument "aR":
-  //     =0: On input, meaning not yet evaluated
-  //     =1: W/in RICH acceptance
-  //     =2: Tighter cuts
-  //     =-1: W/out acceptance
-  //     =-2: Downstream of RICH
-  //  -> Fill PaTrack's "vAux" [0,1] w/ (X,Y)
-  //  -> Fill PaTrack's "vAux" [2,3] w/ (tgx,tgy)
+  //  -> Fill "rp.aR" (cf. "RICHPlane.h"), always !=0 on output.
+  //  -> Fill "rp.(X|Y)R" w/ (X,Y), "rp.tg(X|Y)R" w/ (tgx,tgy)
+  //  -> Fill "rp.ihBest" w/ the index of the helix extrapolated.
   // - Downstream of SM2
   // => Determine exit (resp. incidence) angles for SM1 (resp. SM2), equated to
   // above @ RICH) and horizontal exit angle for SM2 (if involved).
-  //  -> Track's "vAux": FIVE components if a 0x4-track, THREE otherwise.
-  vector<float> &aux = trk.vAux(); aux.clear();
+  //  -> Fill "rp.tgXSM2" if a 0x4-track.
+  // (Note: Not to be called directly, but through "richPlane", which caches
+  // the result.)
   static PaTPar Hout; // Generic helix used in extrapolations
-  vector<PaTPar> &hs = trk.vTPar();
+  const vector<PaTPar> &hs = trk.vTPar();
+  rp.XR = rp.YR = rp.tgXR = rp.tgYR = rp.tgXSM2 = 0; rp.ihBest = -1;
   if (hs[0](0)<ZRICH) { // Since starting downstream of RICH => not processed by RICH software...
     int ih, ihBest; double best; for (ih = 0, ihBest = 0, best = 10000;
 				    ih<(int)hs.size(); ih++) {
-      PaTPar &hR = hs[ih]; double Z0 = hR(0); if (Z0>ZSM2) continue;
+      const PaTPar &hR = hs[ih]; double Z0 = hR(0); if (Z0>ZSM2) continue;
       double dist = fabs(Z0-ZRICH); if (dist<best) {
 	ihBest = ih; best = dist;
       }
@@ -6580,24 +6632,20 @@ void transport(PaEvent &e,
     const PaTPar &hR = hs[ihBest]; hR.Extrapolate(ZRICH,Hout,false);
     float XR = Hout(1), YR = Hout(2), RR = sqrt(XR*XR+YR*YR);
     if (rRICH<RR && fabs(XR)<XRICH && fabs(YR)<YRICH)
-      // Fill all of "aRs", even if not useful, for it is computed only once,
-      // cf. "aRs[iET]==0" conditioning the call to "transport".
-      aR = RR>rRICHCut? 2 : 1;
+      rp.aR = RR>rRICHCut? 2 : 1;
     else
-      aR = -1;
-    aux.push_back(XR); aux.push_back(YR);
-    aux.push_back(Hout(3)); aux.push_back(Hout(4));
-  }
-  else {
-    aR = -2;
-    aux.push_back(0); aux.push_back(0); aux.push_back(0); aux.push_back(0);
+      rp.aR = -1;
+    rp.ihBest = ihBest;
+    rp.XR = XR; rp.YR = YR; rp.tgXR = Hout(3); rp.tgYR = Hout(4);
   }
+  else
+    rp.aR = -2;
   
   if (!(zones&0x4)) return;
 
   int ih, ihBest; double best; for (ih = 0, ihBest = -1, best = 10000;
 				    ih<(int)hs.size(); ih++) {
-    PaTPar &hS = hs[ih]; double Z0 = hS(0); if (Z0<ZSM2) continue;
+    const PaTPar &hS = hs[ih]; double Z0 = hS(0); if (Z0<ZSM2) continue;
     double dist = fabs(Z0-ZSM2+300); if (dist<best) {
       ihBest = ih; best = dist;
     }
@@ -6605,10 +6653,10 @@ void transport(PaEvent &e,
   if (ihBest<0) {
     // For &0x4-zone tracks, may happen if only the first helix is available...
     hs[0].Extrapolate(ZSM2+300/* i.e. 1m beyond SM2 exit */,Hout,false);
-    aux.push_back(Hout(3));
+    rp.tgXSM2 = Hout(3);
   }
   else
-    aux.push_back(hs[ihBest](3));
+    rp.tgXSM2 = hs[ihBest](3);
 }
 #ifdef U3_FILL_Lambda
 // **********************************************************************
@@ -7009,6 +7057,7 @@ void fillLGM0709(double m_ppi, const PaTrack &trk1, const PaTrack &trk2,
 // *************************  fillK0HighLevel  **************************
 // **********************************************************************
 void fillK0HighLevel(const PaTrack &trk1, const PaTrack &trk2,
+		     const RICHPlane &rp1, const RICHPlane &rp2,
 		     double m_pipi, const TLorentzVector &lvpipi,
 		     double Theta, double Thetx, double Thety, double ThetX,
 		     double alpha, double beta)
@@ -7020,12 +7069,12 @@ void fillK0HighLevel(const PaTrack &trk1, const PaTrack &trk2,
 		       Theta,Thetx,Thety,ThetX,alpha,beta);
   else if (zL1<ZSM2 || zL2<ZSM2<0) {                            // ***** LASxSAS
     if (zL1>ZSM2) {
-      double alpha1 = trk1.vAux()[2], bin = floor(alpha1/.020)+2;
+      double alpha1 = rp1.tgXR, bin = floor(alpha1/.020)+2;
       if (bin<0) bin = 0; if (bin>3) bin = 3;
       hm_K0cslx->Fill(m_pipi,bin);
     }
     else {
-      double alpha2 = trk2.vAux()[2], bin = floor(alpha2/.020)+1;
+      double alpha2 = rp2.tgXR, bin = floor(alpha2/.020)+1;
       if (bin<0) bin = 0; if (bin>3) bin = 3;
       hm_K0clsx->Fill(m_pipi,bin);
     }
@@ -7054,7 +7103,7 @@ void fillK0HighLevel(const PaTrack &trk1, const PaTrack &trk2,
 // *************************   getK0Incidence  **************************
 // *************************  fillK0Incidence  **************************
 // **********************************************************************
-void getK0Incidence(const PaTrack &trk1, const PaTrack &trk2,
+void getK0Incidence(const RICHPlane &rp1, const RICHPlane &rp2,
 		    int zones1, int zones2,
 		    const TVector3 &v13, const TVector3 &v23,
 		    const PaTPar &hi1, const PaTPar &hi2,
@@ -7065,14 +7114,14 @@ void getK0Incidence(const PaTrack &trk1, const PaTrack &trk2,
   double cTh = v13*v23/v13.Mag()/v23.Mag();
   if (cTh>1.) cTh = 1.;
   Theta = acos(cTh);
-  double alpha1 = (zones1&0x4) ? trk1.vAux()[2] : hi1(3);
-  double alpha2 = (zones2&0x4) ? trk2.vAux()[2] : hi2(3);
+  double alpha1 = (zones1&0x4) ? rp1.tgXR : hi1(3);
+  double alpha2 = (zones2&0x4) ? rp2.tgXR : hi2(3);
   Thetx = alpha2-alpha1, alpha = (alpha2+alpha1)/2;
-  alpha1 = (zones1&0x4) ? trk1.vAux()[3] : hi1(4);
-  alpha2 = (zones2&0x4) ? trk2.vAux()[3] : hi2(4);
+  alpha1 = (zones1&0x4) ? rp1.tgYR : hi1(4);
+  alpha2 = (zones2&0x4) ? rp2.tgYR : hi2(4);
   Thety = alpha2-alpha1;
-  alpha1 = (zones1&0x4) ? trk1.vAux()[4] : trk1.vAux()[2];
-  alpha2 = (zones2&0x4) ? trk2.vAux()[4] : trk2.vAux()[2];
+  alpha1 = (zones1&0x4) ? rp1.tgXSM2 : rp1.tgXR;
+  alpha2 = (zones2&0x4) ? rp2.tgXSM2 : rp2.tgXR;
   ThetX = (alpha2-alpha1)/2, beta = (alpha2+alpha1)/2;
 }
 void fillK0IncidenceLAS(double m_pipi, const TLorentzVector &lvpipi,
@@ -7122,7 +7171,7 @@ void fillK0IncidenceSAS(double m_pipi, const TLorentzVector &lvpipi,
   /*
     if (fabs(m_pipi-M_K0)<.03)
     printf("\nEvt %d %02d,%02d 0x%x,0x%x %5.1f,%5.1f %.4f   %6.3f,%6.3f  %6.3f => %.0f    %.4f %.4f\n",
-    EvNum,iET1,iET2,zones1,zones2,1/hv1(5),1/hv2(5),m_pipi-M_K0,alpha1,alpha2,Thetx,floor(Thetx/.025)+3,fSM2*(1-dSM2dx*trk1.vAux()[2]),fSM2*(1+dSM2dx*trk2.vAux()[2]));
+    EvNum,iET1,iET2,zones1,zones2,1/hv1(5),1/hv2(5),m_pipi-M_K0,alpha1,alpha2,Thetx,floor(Thetx/.025)+3,fSM2*(1-dSM2dx*rp1.tgXR),fSM2*(1+dSM2dx*rp2.tgXR));
   */
   double pK0 = lvpipi.P(); bin = floor(pK0/12)-2; if (bin>5) bin = 6;
   hm_K0cssP->Fill(m_pipi,bin);
@@ -7135,6 +7184,7 @@ void fillK0IncidenceSAS(double m_pipi, const TLorentzVector &lvpipi,
 #ifdef U3_OUTPUT_TREE
 // **********************************************************************
 // ************************* copyCSEventHeader **************************
+// ************************* getRICHLikes      **************************
 // ************************* copyCSHadronData  **************************
 // ************************* copyCSResonanceData ************************
 // ************************* getHadronIndex    **************************
@@ -7163,47 +7213,62 @@ void copyCSEventHeader(PaEvent &e,
   fCSEvt->nOuts = pV.NOutParticles();
   getRICHMultiplicity(e,pV,fCSEvt->nTrksRIt,fCSEvt->nTrksRIb);
 }
+void getRICHLikes(const PaTrack &trk, Float_t *LH)
+{
+  // pi,K,p,e,mu,back LHs (cf. "CSHadronData::LH"), fetched in one go, from
+  // the RichInf slots "PaPid::GetLike" reads one at a time (cf. the layout in
+  // "GetPIDs.cc"): one test of the RICH block instead of one per LH.
+  // It can happen that the LHs come close to 0: this behaviour is prone to
+  // make the analysis depend upon context. => Let's set =0 all such cases (as
+  // is done in "GetPIDS.cc").
+  static const int iInfs[6] = { 1, 2, 3, 15, 16, 0 };
+  int nInfs = trk.NRichInf();
+  for (int i = 0; i<6; ++i) {
+    float lh = iInfs[i]<nInfs ? trk.RichInf(iInfs[i]) : 0;
+    LH[i] = fabs(lh)<1e-6 ? 0 : lh;
+  }
+  //#define U3_DEBUG_RICHLikes
+#ifdef U3_DEBUG_RICHLikes
+  for (int i = 0; i<6; ++i) {
+    float lh = fPid->GetLike(i,trk); if (fabs(lh)<1e-6) lh = 0;
+    if (lh!=LH[i]) {
+      printf("** U3::getRICHLikes: Evt %d#%d LH[%d] = %g != GetLike = %g\n",
+	     Run,EvNum,i,LH[i],lh);
+      abort();
+    }
+  }
+#endif
+}
 void copyCSHadronData(PaEvent &e, const PaParticle *pa, int iV)
 {
   int iET = pa->iTrack(); PaTrack &trk = e.vTrack()[iET];
-  const vector<Float_t> &aux = trk.vAux();
-  if (aRs[iET]<-1) { // Ensure then "aRs" are meaningful
-    printf("** U3:\a Evt %d,%d Track %d(<-Hadron): Inconsistency: aRs = %d\n",
-	   e.RunNum(),(int)e.UniqueEvNum(),iET,aRs[iET]);
+  const RICHPlane &rp = richPlane(e,iET);
+  if (rp.aR<-1) { // Ensure then RICH plane is meaningful
+    printf("** U3:\a Evt %d,%d Track %d(<-Hadron): Inconsistency: aR = %d\n",
+	   e.RunNum(),(int)e.UniqueEvNum(),iET,rp.aR);
     abort();
   }
-  CSHadronData h;
+  fHadrons.emplace_back(); CSHadronData &h = fHadrons.back();
   // 3-momentum @ pV
   const PaTPar &hv = pa->ParInVtx(iV); const TVector3 v3 = hv.Mom3();
   h.Px = v3.X(); h.Py = v3.Y(); h.Pz = v3.Z();
-  // P is taken as close to RICH as possible, yet upstream of SM2
+  // P is taken as close to RICH as possible, yet upstream of SM2, i.e. on
+  // the helix used by "transport".
   const vector<PaTPar> &hs = trk.vTPar();
-  int i, iBest; double best; for (i = 0, iBest = 0, best = 10000;
-				  i<(int)hs.size(); i++) {
-    const PaTPar &hR = hs[i]; double Z0 = hR(0); if (Z0>ZSM2) continue;
-    double dist = fabs(Z0-ZRICH); if (dist<best) { iBest = i; best = dist; }
-  }
-  const PaTPar &hR = hs[iBest]; // At worst, "iBest" is =0, i.e. 1rst measured point
+  const PaTPar &hR = hs[rp.ihBest]; // At worst, "ihBest" is =0, i.e. 1rst measured point
   h.qP = 1/hR(5); h.phiR = atan2(hR(4),hR(3));
   h.XX0 = trk.XX0();
   h.ZFirst = hs[0](0);
   h.ZLast = trk.ZLast(); // Get ZLast from PaTrack dedicated method, even if it's not the fastest way, given that not that many tracks are concerned. 
   h.chi2 = trk.Chi2tot()/trk.Ndf();
-  for (int i = 0; i<6; ++i) {
-    float LH = fPid->GetLike(i,trk);
-    if (fabs(LH)<1e-6)// It can happen that the LHs come close to 0...
-      // ... this behaviour is prone to make the analysis depend upo context.
-      // => Let's set =0 all such cases (as is done in "../GetPIDS.cc")
-      LH = 0;
-    h.LH[i] = LH;
-  }
+  getRICHLikes(trk,h.LH);
   if (trk.NRichInf()>0) {
     for (int i = 0; i<3; ++i) h.dLHdI[i] = trk.RichInf(i+4);
     if (trk.RichInf(0)) {
       h.hasR = true; h.thC = trk.RichInf(7);
     }
   }
-  h.XR = aux[0]; h.YR = aux[1]; h.tgXR = aux[2]; h.tgYR = aux[3];
+  h.XR = rp.XR; h.YR = rp.YR; h.tgXR = rp.tgXR; h.tgYR = rp.tgYR;
 
   // ***** Get electromagnetic calorimeter signals
   int iC; for (iC = 0, h.ECAL = 0; iC<pa->NCalorim(); iC++) {
@@ -7214,31 +7279,25 @@ void copyCSHadronData(PaEvent &e, const PaParticle *pa, int iV)
   if (e.IsMC()) {
     int iMCT = trk.iMCtrack(); if (iMCT>=0) h.MCpid = e.vMCtrack(iMCT).Pid();
   }
-  fHadrons.push_back(h);
 }
 void copyCSResonanceData(const PaVertex &v,
 			 double m, double D, double dD, double cth,
 			 double pT, double alpha)
 {
-  CSResonanceData r;
+  fResonances.emplace_back(); CSResonanceData &r = fResonances.back();
   r.Xs = v.Pos(0); r.Ys = v.Pos(1); r.Zs = v.Pos(2);
   r.chi2 = v.Chi2()/v.Ndf();
   r.m = m; r.D = D; r.dD = dD; r. cth = cth; r.pT = pT; r.alpha = alpha;
-  fResonances.push_back(r);
 }
 int getHadronIndex(const PaParticle *pa) {
   int paInd = pa->MyIndex();
-  map<int,int>::iterator it = fPa2fH.find(paInd);
-  int fHInd = it!=fPa2fH.end() ? it->second : -1;
-  if (fHInd<0) {
-    fHInd = fHadrons.size();
-    if (fPa2fH.size()!=fHadrons.size()) {
-      printf("** U3::getHadronIndex: Evt %d#%d fHadrons(%d) != fPa2fH(%d)\n",
-	     Run,EvNum,(int)fHadrons.size(),(int)fPa2fH.size());
-      abort();
-    }
-    fPa2fH[paInd] = fHInd;
+  if (paInd<0 || (int)fPa2fH.size()<=paInd) {
+    printf("** U3::getHadronIndex: Evt %d#%d particle %d not in [0,%d[\n",
+	   Run,EvNum,paInd,(int)fPa2fH.size());
+    abort();
   }
+  int &fHInd = fPa2fH[paInd];
+  if (fHInd<0) fHInd = fHadrons.size();
   //#define U3_DEBUG_fPa2fH
 #ifdef U3_DEBUG_fPa2fH
   if (fHInd!=(int)fHadrons.size()) {
@@ -7448,16 +7507,13 @@ int nChargedKsInPV(PaEvent &e, const PaVertex &pV)
     // Prior to, possibly re-scale momentum, determine exit angle for SM1
     // and incidence/exit angle for SM2. May need to extrapolate, if so
     // take advantage to set also acceptance by RICH.
-    if (!aRs[iET]) /* If not yet done */ transport(e,trk,aRs[iET],tZones[iET]);
-    if (aRs[iET]<0) continue;
+    richPlane(e,iET); // Transport to RICH, if not yet done
+    if (rPlanes[iET].aR<0) continue;
     const PaTPar &hi = trk.vTPar()[0]; TVector3 v3 = hi.Mom3();
     double mom = v3.Mag(); if (mom<thrMargin*piThr || PRICHCut<mom) continue;
-    double piLH = richLHs[0][iET], KLH = richLHs[1][iET];
-    double pLH  = richLHs[2][iET], eLH = richLHs[3][iET];
-    double hadronLH = pLH>piLH ? pLH : piLH;
-    double elseLH = eLH>hadronLH ? eLH : hadronLH;
-    if ((mom<KThr && elseLH<subKThrLHpiVeto) ||           // SubKThr else veto
-	(KThr<mom && KLH>LHBckCut && KLH>hadronLH*LHCut)) // Actual ID
+    int lh = LHIDs[iET];
+    if ((mom<KThr && (lh&LHsubKh)) ||           // SubKThr else veto
+	(KThr<mom && (lh&LHKID)))               // Actual ID
       nKs++;
   }
   return nKs;
@@ -7500,8 +7556,8 @@ void fillIphi(PaEvent &e, int ipV, int imuS, double dM_phi,
     if (trk1.Chi2tot()/trk1.Ndf()>chi2Cut) continue;    // ***** CUT ON CHI2/NDF
     // Determine acceptance by RICH and exit angle for SM1 and incidence/exit
     // angle for SM2.
-    if (aRs[iET1]==0) /* Not done? */transport(e,trk1,aRs[iET1],zones1);
-    if (aRs[iET1]<-1) continue; // Skip track starting downstream of RICH
+    richPlane(e,iET1); // Transport to RICH, if not yet done
+    if (rPlanes[iET1].aR<-1) continue; // Skip track starting downstream of RICH
     const PaTPar &hv1 = pa1.ParInVtx(ipV); TVector3 v13 = hv1.Mom3();
     // For P @ RICH, best would be a smoothing point in zone 0x2. Next best...
     const PaTPar &hi1 = trk1.vTPar()[0]; double mom1;
@@ -7526,8 +7582,8 @@ void fillIphi(PaEvent &e, int ipV, int imuS, double dM_phi,
 
       // Determine acceptance by RICH and exit angle for SM1 and incidence/exit
       // angle for SM2.
-      if (aRs[iET2]==0) /* !done? */transport(e,trk2,aRs[iET2],zones2);
-      if (aRs[iET2]<-1) continue; // Skip track starting downstream of RICH
+      richPlane(e,iET2); // Transport to RICH, if not yet done
+      if (rPlanes[iET2].aR<-1) continue; // Skip track starting downstream of RICH
       const PaTPar &hv2 = pa2.ParInVtx(ipV); TVector3 v23 = hv2.Mom3();
       // For P @ RICH, best would be a smoothing point in zone 0x2. Next best...
       const PaTPar &hi2 = trk2.vTPar()[0]; double mom2;
@@ -7549,18 +7605,15 @@ void fillIphi(PaEvent &e, int ipV, int imuS, double dM_phi,
       unsigned short RICHOK = 0;
       int iET, pm; double mom; for (pm = 0, iET = iET1, mom = mom1; pm<2;
 				    pm++) { 
-	if (aRs[iET]>0 && thrMargin*piThr<mom && mom<PRICHCut) {
+	if (rPlanes[iET].aR>0 && thrMargin*piThr<mom && mom<PRICHCut) {
 	  RICHOK |= 0x1<<pm; unsigned short idpm = 0;
 	  if (PIDs[iET]&0x10) {
-	    double piLH = richLHs[0][iET], KLH = richLHs[1][iET];
-	    double pLH  = richLHs[2][iET], eLH = richLHs[3][iET];
-	    double hadronLH = pLH>piLH ? pLH : piLH;
-	    double elseLH = eLH>hadronLH ? eLH : hadronLH;
+	    int lh = LHIDs[iET];
 	    if (mom<thrMargin*KThr && // "thrMargin" used here and not infra...
 		// ...so as to maximize efficiency and leave the problem of
 		// purity to TTree projection time.
-		elseLH<subKThrLHpiVeto) idpm |= 0x2;
-	    if (KThr<mom && KLH>LHBckCut && KLH>hadronLH*LHCut) idpm |= 0x4;
+		(lh&LHsubKh)) idpm |= 0x2;
+	    if (KThr<mom && (lh&LHKID)) idpm |= 0x4;
 	  }
 	  else if (mom<thrMargin*KThr)
 	    // Absence of RICH block or LH =0: cf. comment in PID for Lambda
@@ -7633,9 +7686,9 @@ void getRICHMultiplicity(PaEvent &e, const PaVertex &pV,
       if (XR*XR+YR*YR<r2RICH || fabs(XR)>XRICH || fabs(YR)>YRICH) continue;
     }
     else {
-      if (aRs[iET]==0) /* If not yet done */ transport(e,trk,aRs[iET],zones);
-      if (aRs[iET]<0) continue;
-      Yp = trk.vAux()[3];
+      const RICHPlane &rp = richPlane(e,iET); // Transport, if not yet done
+      if (rp.aR<0) continue;
+      Yp = rp.tgYR;
     }
     if (Yp>0) nTrksRIt++;
     else      nTrksRIb++;
@@ -50,18 +50,20 @@ static TH2D *hL_phiPD[2][4], *hL_phiH[2][4];// ***** f(pseudoPD), f(Time in Day)
 static TH2D *hL_phiS[2];                               // ***** Effs sub p Range
 const int nphiBins = 4;                             // ***** As a f(Phase Space)
 const int nphB = nphiBins*npB+1; // 1 ``sum'' bin  + nphBins * npB momentum bins
-static TH2D *hL_phioP[2][nphB], *hL_phioPT[2][nphB], *hL_phioPV[2][nphB];
-static TH1D *hR_phioP[2][nphB], *hR_phioA[2][nphB];
+// (Handles into "HistoRegistry", family "phiPS": booked upon 1st fill. So are
+// the chi2 and dTheta analogues below, as well as those of "K0PS", "K0PurPS".)
+static int hL_phioP[2][nphB], hL_phioPT[2][nphB], hL_phioPV[2][nphB];
+static int hR_phioP[2][nphB], hR_phioA[2][nphB];
 #  ifdef U3_PLOT_CHI2        // ********** RICH CHI2 PID **********
 static TH2D *hC_phiM[2];                              // ***** Effs w/in p Range
 static TH2D *hC_phiPD[2][4], *hC_phiH[2][4];// ***** f(pseudoPD), f(Time in Day)
 static TH2D *hC_phiS[2];                               // ***** Effs sub p Range
-static TH2D *hC_phioP[2][nphB], *hC_phioPT[2][nphB], *hC_phioPV[2][nphB];
+static int hC_phioP[2][nphB], hC_phioPT[2][nphB], hC_phioPV[2][nphB];
 #  endif
 #  ifdef U3_PLOT_dTheta      // ********** RICH dTheta PID **********
 static TH2D *hT_phiM[2];                              // ***** Effs w/in p Range
 static TH2D *hT_phiPD[2][4];                                // ***** f(pseudoPD)
-static TH2D *hT_phioP[2][nphB], *hT_phioPT[2][nphB], *hT_phioPV[2][nphB];
+static int hT_phioP[2][nphB], hT_phioPT[2][nphB], hT_phioPV[2][nphB];
 #  endif
 //       ****************************** K0 ******************************
 static TH1D *hR_dpiPD[2][16];                               // ***** Resolutions
@@ -79,23 +81,24 @@ static TH2D *hL_K0PD[2][4], *hM_K0PD[2][4];         // ***** (mis)ID f(pseudoPD)
 static TH2D *hM_K0H[2][4];                               // misID f(Time in Day)
 const int nK0Bins = 6;                              // ***** As a f(Phase Space)
 const int nK0B = nK0Bins*npB+1;  // 1 ``sum'' bin  + nphBins * npB momentum bins
-static TH2D *hL_K0oP[2][nK0B], *hL_K0oPV[2][nK0B], *hL_K0oPT[2][nK0B];
+// (Handles into "HistoRegistry", families "K0PS" and "K0PurPS".)
+static int hL_K0oP[2][nK0B], hL_K0oPV[2][nK0B], hL_K0oPT[2][nK0B];
 // Same sequence of eff vs. PS, but for K misID this time, different binning
-static TH2D *hM_K0oP[2][nphB], *hM_K0oPV[2][nphB], *hM_K0oPT[2][nphB];
-static TH1D *hR_K0oP[2][nphB], *hR_K0oA[2][nphB];
+static int hM_K0oP[2][nphB], hM_K0oPV[2][nphB], hM_K0oPT[2][nphB];
+static int hR_K0oP[2][nphB], hR_K0oA[2][nphB];
 #  ifdef U3_PLOT_CHI2
 static TH2D *hC_K0M[2], *hD_K0M[2];             // ***** Effs/misID w/in p Range
 static TH2D *hD_K0S[2];                               // ***** misID sub p Range
 static TH2D *hC_K0PD[2][4], *hD_K0PD[2][4];         // ***** (mis)ID f(pseudoPD)
 static TH2D *hD_K0H[2][4];                               // misID f(Time in Day)
-static TH2D *hC_K0oP[2][nK0B], *hC_K0oPV[2][nK0B], *hC_K0oPT[2][nK0B];
+static int hC_K0oP[2][nK0B], hC_K0oPV[2][nK0B], hC_K0oPT[2][nK0B];
 // Same sequence of eff vs. PS, but for K misID this time, different binning
-static TH2D *hD_K0oP[2][nphB], *hD_K0oPV[2][nphB], *hD_K0oPT[2][nphB];
+static int hD_K0oP[2][nphB], hD_K0oPV[2][nphB], hD_K0oPT[2][nphB];
 #  endif
 #  ifdef U3_PLOT_dTheta
 static TH2D *hT_K0PD[2][4], *hU_K0PD[2][4], *hT_K0M[2], *hU_K0M[2];
-static TH2D *hT_K0oP[2][nK0B], *hT_K0oPV[2][nK0B], *hT_K0oPT[2][nK0B];
-static TH2D *hU_K0oP[2][nphB], *hU_K0oPV[2][nphB], *hU_K0oPT[2][nphB];
+static int hT_K0oP[2][nK0B], hT_K0oPV[2][nK0B], hT_K0oPT[2][nK0B];
+static int hU_K0oP[2][nphB], hU_K0oPV[2][nphB], hU_K0oPT[2][nphB];
 #  endif
 // ********** Lambda **********
 static TH1D *hR_dpPD[4];                                    // ***** Resolutions
@@ -0,0 +1,76 @@
+// $Id: V0Kine.h,v 1.1 $
+
+// Two-body (V0) kinematics, under all the mass hypotheses of interest,
+// computed in one go from the 3-momenta of the two decay particles, the 1st
+// one being >0 and the 2nd <0. No heap object, no TLorentzVector.
+// - Masses under pi+pi-, p pi-, pi+ pbar, K+K- and e+e- hypotheses.
+// - pT and Armenteros alpha, w.r.t. the V0 momentum.
+// - Collinearity: cosine of the angle between the V0 momentum and some line.
+// Shared by "userevents/UserEvent103" and "CSEvent/fit_table": the two copies
+// are to be kept identical (as is the case for "CSEventData.h").
+
+#ifndef V0Kine_h
+#define V0Kine_h 1
+
+#include <cmath>
+
+struct V0Kine {
+  enum { pipi, ppi, pip, KK, ee, nHyps };  // Mass hypotheses
+
+  double P[3], P2;                   // V0 momentum, squared
+  double Epi1, Ep1, EK1, Ee1;        // Energies of >0 particle...
+  double Epi2, Ep2, EK2, Ee2;        // ...and of <0 particle
+  double E[nHyps];                   // V0 energy, per hypothesis
+  double m[nHyps];                   // V0 mass, per hypothesis
+  double pT, alpha;                  // Armenteros
+
+  V0Kine() {}
+  V0Kine(double px1, double py1, double pz1,
+	 double px2, double py2, double pz2) {
+    set(px1,py1,pz1,px2,py2,pz2);
+  }
+
+  void set(double px1, double py1, double pz1,
+	   double px2, double py2, double pz2) {
+    // Same values as in "Masses.h" (which "fit_table" does not include).
+    static const double M2pi = 0.13957018*0.13957018;
+    static const double M2p  = 0.9382723 *0.9382723;
+    static const double M2K  = 0.493677  *0.493677;
+    static const double M2e  = .000510998902*.000510998902;
+    P[0] = px1+px2; P[1] = py1+py2; P[2] = pz1+pz2;
+    P2 = P[0]*P[0]+P[1]*P[1]+P[2]*P[2];
+    double p21 = px1*px1+py1*py1+pz1*pz1, p22 = px2*px2+py2*py2+pz2*pz2;
+    Epi1 = sqrt(p21+M2pi); Ep1 = sqrt(p21+M2p);
+    EK1  = sqrt(p21+M2K);  Ee1 = sqrt(p21+M2e);
+    Epi2 = sqrt(p22+M2pi); Ep2 = sqrt(p22+M2p);
+    EK2  = sqrt(p22+M2K);  Ee2 = sqrt(p22+M2e);
+    E[pipi] = Epi1+Epi2; E[ppi] = Ep1+Epi2; E[pip] = Epi1+Ep2;
+    E[KK] = EK1+EK2; E[ee] = Ee1+Ee2;
+    for (int h = 0; h<nHyps; h++) {
+      double m2 = E[h]*E[h]-P2;  // Same sign convention as TLorentzVector::M
+      m[h] = m2<0 ? -sqrt(-m2) : sqrt(m2);
+    }
+    // pT and longitudinal momenta: as was done w/ "TVector3::Perp" so far.
+    double p1P = px1*P[0]+py1*P[1]+pz1*P[2], pT2 = p21;
+    if (P2>0) pT2 -= p1P*p1P/P2;
+    if (pT2<0) pT2 = 0;
+    pT = sqrt(pT2);
+    double PL1 = sqrt(p21-pT2), PL2 = p22>pT2 ? sqrt(p22-pT2) : 0;
+    alpha = PL1+PL2>0 ? (PL1-PL2)/(PL1+PL2) : 0;
+  }
+
+  // Convert mass "mh", obtained under hypothesis "h", into hypothesis "k".
+  // (Makes for mass reflections that stick to a given, e.g. stored, "mh".)
+  double reflect(double mh, int h, int k) const {
+    double m2 = mh*mh-E[h]*E[h]+E[k]*E[k];
+    return m2<0 ? -sqrt(-m2) : sqrt(m2);
+  }
+
+  // Cosine of the angle between V0 momentum and line (dx,dy,dz).
+  double cth(double dx, double dy, double dz) const {
+    double d2 = dx*dx+dy*dy+dz*dz; if (d2<=0 || P2<=0) return 0;
+    return (dx*P[0]+dy*P[1]+dz*P[2])/sqrt(d2*P2);
+  }
+};
+
+#endif